@@ -20,8 +20,11 @@
 // THE SOFTWARE.
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
@@ -129,7 +132,61 @@ auto Binder::BindIndex(duckdb_libpgquery::PGIndexStmt *stmt) -> std::unique_ptr<
     }
   }
 
-  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols));
+  // The grammar has no INCLUDE clause, included columns are given as `WITH (include = 'col1, col2')` instead.
+  std::vector<std::unique_ptr<BoundColumnRef>> include_cols;
+  bool adaptive_hash_index = true;
+  std::optional<double> merge_threshold;
+  bool compaction = false;
+  if (stmt->options != nullptr) {
+    for (auto cell = stmt->options->head; cell != nullptr; cell = cell->next) {
+      auto option = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(cell->data.ptr_value);
+      if (strcmp(option->defname, "include") != 0 && strcmp(option->defname, "adaptive_hash") != 0 &&
+          strcmp(option->defname, "merge_threshold") != 0 && strcmp(option->defname, "compaction") != 0) {
+        throw NotImplementedException(fmt::format("index option {} is not supported", option->defname));
+      }
+      if (option->arg == nullptr || option->arg->type != duckdb_libpgquery::T_PGString) {
+        throw bustub::Exception(fmt::format("index option {} should be given as a string", option->defname));
+      }
+      auto arg = std::string(reinterpret_cast<duckdb_libpgquery::PGValue *>(option->arg)->val.str);
+      if (strcmp(option->defname, "adaptive_hash") == 0 || strcmp(option->defname, "compaction") == 0) {
+        if (arg != "on" && arg != "off") {
+          throw bustub::Exception(fmt::format("{} should be 'on' or 'off'", option->defname));
+        }
+        if (strcmp(option->defname, "compaction") == 0) {
+          compaction = arg == "on";
+        } else {
+          adaptive_hash_index = arg == "on";
+        }
+        continue;
+      }
+      if (strcmp(option->defname, "merge_threshold") == 0) {
+        size_t parsed = 0;
+        try {
+          merge_threshold = std::stod(arg, &parsed);
+        } catch (const std::logic_error &e) {
+          parsed = 0;
+        }
+        if (parsed == 0 || parsed != arg.size()) {
+          throw bustub::Exception("merge_threshold should be a number");
+        }
+        continue;
+      }
+      for (auto name : StringUtil::Split(arg, ',')) {
+        name.erase(std::remove(name.begin(), name.end(), ' '), name.end());
+        auto column_ref = ResolveColumn(*table, std::vector{name});
+        include_cols.emplace_back(std::make_unique<BoundColumnRef>(dynamic_cast<const BoundColumnRef &>(*column_ref)));
+      }
+    }
+  }
+
+  // the parser fills in its own default access method when there is no USING clause
+  std::string index_type;
+  if (stmt->accessMethod != nullptr && std::string(stmt->accessMethod) != DEFAULT_INDEX_TYPE) {
+    index_type = stmt->accessMethod;
+  }
+
+  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols), std::move(index_type),
+                                          std::move(include_cols), adaptive_hash_index, merge_threshold, compaction);
 }
 
 }  // namespace bustub
@@ -722,6 +722,10 @@ auto Binder::BindAExpr(duckdb_libpgquery::PGAExpr *root) -> std::unique_ptr<Boun
   BUSTUB_ASSERT(root, "nullptr");
   auto name = std::string((reinterpret_cast<duckdb_libpgquery::PGValue *>(root->name->head->data.ptr_value))->val.str);
 
+  if (root->kind == duckdb_libpgquery::PG_AEXPR_BETWEEN || root->kind == duckdb_libpgquery::PG_AEXPR_NOT_BETWEEN) {
+    return BindBetween(root);
+  }
+
   if (root->kind != duckdb_libpgquery::PG_AEXPR_OP) {
     throw bustub::Exception("unsupported op in AExpr");
   }
@@ -745,6 +749,21 @@ auto Binder::BindAExpr(duckdb_libpgquery::PGAExpr *root) -> std::unique_ptr<Boun
   throw bustub::Exception("unsupported AExpr: left == null while right != null");
 }
 
+auto Binder::BindBetween(duckdb_libpgquery::PGAExpr *root) -> std::unique_ptr<BoundExpression> {
+  BUSTUB_ASSERT(root, "nullptr");
+  auto bounds = BindExpressionList(reinterpret_cast<duckdb_libpgquery::PGList *>(root->rexpr));
+  if (bounds.size() != 2) {
+    throw bustub::Exception("BETWEEN should have 2 bounds");
+  }
+
+  // `x BETWEEN lo AND hi` is `x >= lo AND x <= hi`, and `x NOT BETWEEN lo AND hi` is `x < lo OR x > hi`, so that the
+  // bounds are evaluated as two plain comparisons
+  bool negated = root->kind == duckdb_libpgquery::PG_AEXPR_NOT_BETWEEN;
+  auto lower = std::make_unique<BoundBinaryOp>(negated ? "<" : ">=", BindExpression(root->lexpr), std::move(bounds[0]));
+  auto upper = std::make_unique<BoundBinaryOp>(negated ? ">" : "<=", BindExpression(root->lexpr), std::move(bounds[1]));
+  return std::make_unique<BoundBinaryOp>(negated ? "or" : "and", std::move(lower), std::move(upper));
+}
+
 auto Binder::BindBoolExpr(duckdb_libpgquery::PGBoolExpr *root) -> std::unique_ptr<BoundExpression> {
   BUSTUB_ASSERT(root, "nullptr");
   switch (root->boolop) {
@@ -32,7 +32,17 @@ BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager
   }
 }
 
-BufferPoolManager::~BufferPoolManager() { delete[] pages_; }
+BufferPoolManager::~BufferPoolManager() {
+  {
+    std::scoped_lock lock(latch_);
+    shutdown_ = true;
+  }
+  prefetch_cv_.notify_all();
+  for (auto &thread : prefetch_threads_) {
+    thread.join();
+  }
+  delete[] pages_;
+}
 
 auto BufferPoolManager::NewPage(page_id_t *page_id) -> Page * {
   std::unique_lock<std::mutex> lock(latch_);
@@ -43,6 +53,7 @@ auto BufferPoolManager::NewPage(page_id_t *page_id) -> Page * {
     *page_id = AllocatePage();
     page_table_[*page_id] = fi;
     pages_[fi].page_id_ = *page_id;
+    pages_[fi].version_.store(++page_loads_ << 32);
     replacer_->RecordAccess(fi);
     replacer_->SetEvictable(fi, false);
     pages_[fi].pin_count_ = 1;
@@ -60,6 +71,7 @@ auto BufferPoolManager::NewPage(page_id_t *page_id) -> Page * {
   *page_id = AllocatePage();
   page_table_[*page_id] = fi;
   pages_[fi].page_id_ = *page_id;
+  pages_[fi].version_.store(++page_loads_ << 32);
   memset(pages_[fi].data_, '1', BUSTUB_PAGE_SIZE);
   replacer_->RecordAccess(fi);
   replacer_->SetEvictable(fi, false);
@@ -69,6 +81,16 @@ auto BufferPoolManager::NewPage(page_id_t *page_id) -> Page * {
 
 auto BufferPoolManager::FetchPage(page_id_t page_id, [[maybe_unused]] AccessType access_type) -> Page * {
   std::unique_lock<std::mutex> lock(latch_);
+  auto prefetch = prefetching_.find(page_id);
+  if (prefetch != prefetching_.end()) {
+    if (prefetch->second) {
+      // being read, and in a frame when the read is done unless there was none for it
+      prefetched_cv_.wait(lock, [&] { return prefetching_.count(page_id) == 0; });
+    } else {
+      // only queued, reading it here is quicker than waiting behind the pages queued before it
+      prefetching_.erase(prefetch);
+    }
+  }
   frame_id_t fi;
   if (page_table_.find(page_id) != page_table_.end()) {
     fi = page_table_[page_id];
@@ -83,6 +105,7 @@ auto BufferPoolManager::FetchPage(page_id_t page_id, [[maybe_unused]] AccessType
     free_list_.pop_front();
     page_table_[page_id] = fi;
     pages_[fi].page_id_ = page_id;
+    pages_[fi].version_.store(++page_loads_ << 32);
     disk_manager_->ReadPage(page_id, pages_[fi].data_);
     replacer_->RecordAccess(fi);
     replacer_->SetEvictable(fi, false);
@@ -100,6 +123,7 @@ auto BufferPoolManager::FetchPage(page_id_t page_id, [[maybe_unused]] AccessType
   }
   page_table_.erase(pages_[fi].page_id_);
   pages_[fi].page_id_ = page_id;
+  pages_[fi].version_.store(++page_loads_ << 32);
   pages_[fi].pin_count_ = 1;
   page_table_[page_id] = fi;
   memset(pages_[fi].data_, '2', BUSTUB_PAGE_SIZE);
@@ -148,6 +172,10 @@ void BufferPoolManager::FlushAllPages() {
 
 auto BufferPoolManager::DeletePage(page_id_t page_id) -> bool {
   std::unique_lock<std::mutex> lock(latch_);
+  if (prefetching_.erase(page_id) > 0) {
+    // a read in flight is dropped when it is done
+    prefetched_cv_.notify_all();
+  }
   if (page_table_.find(page_id) == page_table_.end()) {
     return true;
   }
@@ -170,6 +198,80 @@ auto BufferPoolManager::DeletePage(page_id_t page_id) -> bool {
   return true;
 }
 
+void BufferPoolManager::PrefetchPages(const std::vector<page_id_t> &page_ids) {
+  std::scoped_lock lock(latch_);
+  bool queued = false;
+  for (auto page_id : page_ids) {
+    if (prefetching_.size() >= pool_size_ / 4) {
+      break;
+    }
+    if (page_table_.count(page_id) > 0 || !prefetching_.emplace(page_id, false).second) {
+      continue;
+    }
+    prefetch_queue_.push_back(page_id);
+    queued = true;
+  }
+  if (!queued) {
+    return;
+  }
+  if (prefetch_threads_.empty()) {
+    for (size_t i = 0; i < BUFFER_POOL_PREFETCH_THREADS; i++) {
+      prefetch_threads_.emplace_back(&BufferPoolManager::PrefetchLoop, this);
+    }
+  }
+  prefetch_cv_.notify_all();
+}
+
+void BufferPoolManager::PrefetchLoop() {
+  auto data = std::make_unique<char[]>(BUSTUB_PAGE_SIZE);
+  std::unique_lock<std::mutex> lock(latch_);
+  while (true) {
+    prefetch_cv_.wait(lock, [&] { return shutdown_ || !prefetch_queue_.empty(); });
+    if (shutdown_) {
+      return;
+    }
+    page_id_t page_id = prefetch_queue_.front();
+    prefetch_queue_.pop_front();
+    auto prefetch = prefetching_.find(page_id);
+    if (prefetch == prefetching_.end()) {
+      continue;
+    }
+    prefetch->second = true;
+    // the read is what overlaps with the fetches of other pages, so it is done without the latch
+    lock.unlock();
+    disk_manager_->ReadPage(page_id, data.get());
+    lock.lock();
+    if (prefetching_.erase(page_id) == 0) {
+      // deleted while it was read
+      continue;
+    }
+    frame_id_t fi;
+    bool has_frame = false;
+    if (!free_list_.empty()) {
+      fi = free_list_.front();
+      free_list_.pop_front();
+      has_frame = true;
+    } else if (replacer_->Evict(&fi)) {
+      if (pages_[fi].IsDirty()) {
+        disk_manager_->WritePage(pages_[fi].page_id_, pages_[fi].data_);
+        pages_[fi].is_dirty_ = false;
+      }
+      page_table_.erase(pages_[fi].page_id_);
+      has_frame = true;
+    }
+    if (has_frame) {
+      page_table_[page_id] = fi;
+      pages_[fi].page_id_ = page_id;
+      pages_[fi].version_.store(++page_loads_ << 32);
+      pages_[fi].pin_count_ = 0;
+      memcpy(pages_[fi].data_, data.get(), BUSTUB_PAGE_SIZE);
+      replacer_->RecordAccess(fi);
+      replacer_->SetEvictable(fi, true);
+    }
+    prefetched_cv_.notify_all();
+  }
+}
+
 auto BufferPoolManager::AllocatePage() -> page_id_t { return next_page_id_++; }
 
 auto BufferPoolManager::FetchPageBasic(page_id_t page_id) -> BasicPageGuard { return {this, FetchPage(page_id)}; }
@@ -190,6 +292,10 @@ auto BufferPoolManager::FetchPageWrite(page_id_t page_id) -> WritePageGuard {
   return {this, fetch_page};
 }
 
+auto BufferPoolManager::FetchPageOptimistic(page_id_t page_id) -> OptimisticPageGuard {
+  return {this, FetchPage(page_id)};
+}
+
 auto BufferPoolManager::NewPageGuarded(page_id_t *page_id) -> BasicPageGuard { return {this, NewPage(page_id)}; }
 
 }  // namespace bustub
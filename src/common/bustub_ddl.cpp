@@ -36,10 +36,40 @@
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
 #include "storage/disk/disk_manager_memory.h"
+#include "storage/index/key_encoder.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
+namespace {
+
+template <size_t KeySize>
+auto CreateIndexOfKeySize(Catalog *catalog, Transaction *txn, const IndexStatement &stmt, const Schema &key_schema,
+                          const std::vector<uint32_t> &col_ids, IndexType index_type,
+                          const std::vector<uint32_t> &include_col_ids) -> IndexInfo * {
+  auto *info = catalog->CreateIndex<GenericKey<KeySize>, RID, GenericComparator<KeySize>>(
+      txn, stmt.index_name_, stmt.table_->table_, stmt.table_->schema_, key_schema, col_ids, KeySize,
+      HashFunction<GenericKey<KeySize>>{}, index_type, include_col_ids);
+  // only the B+ tree has an adaptive hash index, a merge threshold and compaction
+  if (auto *tree = info == nullptr ? nullptr
+                                   : dynamic_cast<BPlusTreeIndex<GenericKey<KeySize>, RID, GenericComparator<KeySize>> *>(
+                                         info->index_.get());
+      tree != nullptr) {
+    if (!stmt.adaptive_hash_index_) {
+      tree->SetAdaptiveHashIndexEnabled(false);
+    }
+    if (stmt.merge_threshold_.has_value()) {
+      tree->SetMergeThreshold(*stmt.merge_threshold_);
+    }
+    if (stmt.compaction_) {
+      tree->StartBackgroundCompaction();
+    }
+  }
+  return info;
+}
+
+}  // namespace
+
 void BustubInstance::HandleCreateStatement(Transaction *txn, const CreateStatement &stmt, ResultWriter &writer) {
   std::unique_lock<std::shared_mutex> l(catalog_lock_);
   auto info = catalog_->CreateTable(txn, stmt.table_, Schema(stmt.columns_));
@@ -56,25 +86,56 @@ void BustubInstance::HandleIndexStatement(Transaction *txn, const IndexStatement
   for (const auto &col : stmt.cols_) {
     auto idx = stmt.table_->schema_.GetColIdx(col->col_name_.back());
     col_ids.push_back(idx);
-    if (stmt.table_->schema_.GetColumn(idx).GetType() != TypeId::INTEGER) {
-      throw NotImplementedException("only support creating index on integer column");
-    }
   }
   auto key_schema = Schema::CopySchema(&stmt.table_->schema_, col_ids);
+  std::vector<uint32_t> include_col_ids;
+  std::vector<uint32_t> entry_col_ids = col_ids;
+  for (const auto &col : stmt.include_cols_) {
+    auto idx = stmt.table_->schema_.GetColIdx(col->col_name_.back());
+    include_col_ids.push_back(idx);
+    entry_col_ids.push_back(idx);
+  }
 
-  // TODO(spring2023): If you want to support composite index key for leaderboard optimization, remove this assertion
-  // and create index with different key type that can hold multiple keys based on number of index columns.
-  //
-  // You can also create clustered index that directly stores value inside the index by modifying the value type.
+  // Keys are stored binary-comparable, pick the narrowest key type that can hold any entry of the schema.
+  auto key_size = KeyEncoder::EncodedSize(Schema::CopySchema(&stmt.table_->schema_, entry_col_ids));
+  if (col_ids.empty() || key_size > 64) {
+    throw NotImplementedException("only support creating index with keys of at most 64 bytes");
+  }
 
-  if (col_ids.empty() || col_ids.size() > 2) {
-    throw NotImplementedException("only support creating index with exactly one or two columns");
+  IndexType index_type;
+  if (stmt.index_type_.empty() || stmt.index_type_ == "btree") {
+    index_type = IndexType::BPlusTreeIndex;
+  } else if (stmt.index_type_ == "blink") {
+    index_type = IndexType::BLinkTreeIndex;
+  } else if (stmt.index_type_ == "hash") {
+    index_type = IndexType::HashTableIndex;
+  } else if (stmt.index_type_ == "radix") {
+    index_type = IndexType::ArtIndex;
+  } else {
+    throw NotImplementedException(fmt::format("index type {} is not supported", stmt.index_type_));
+  }
+  if (index_type != IndexType::BPlusTreeIndex && !include_col_ids.empty()) {
+    throw NotImplementedException("only B+ tree indexes can include columns");
+  }
+  if (index_type != IndexType::BPlusTreeIndex && (stmt.merge_threshold_.has_value() || stmt.compaction_)) {
+    throw NotImplementedException("only B+ tree indexes have a merge threshold and compaction");
+  }
+  if (stmt.merge_threshold_.has_value() &&
+      !(*stmt.merge_threshold_ >= 0 && *stmt.merge_threshold_ <= EAGER_MERGE_THRESHOLD)) {
+    throw bustub::Exception(fmt::format("merge_threshold should be between 0 and {}", EAGER_MERGE_THRESHOLD));
   }
 
   std::unique_lock<std::shared_mutex> l(catalog_lock_);
-  auto info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
-      txn, stmt.index_name_, stmt.table_->table_, stmt.table_->schema_, key_schema, col_ids, TWO_INTEGER_SIZE,
-      IntegerHashFunctionType{});
+  IndexInfo *info;
+  if (key_size <= 8) {
+    info = CreateIndexOfKeySize<8>(catalog_, txn, stmt, key_schema, col_ids, index_type, include_col_ids);
+  } else if (key_size <= 16) {
+    info = CreateIndexOfKeySize<16>(catalog_, txn, stmt, key_schema, col_ids, index_type, include_col_ids);
+  } else if (key_size <= 32) {
+    info = CreateIndexOfKeySize<32>(catalog_, txn, stmt, key_schema, col_ids, index_type, include_col_ids);
+  } else {
+    info = CreateIndexOfKeySize<64>(catalog_, txn, stmt, key_schema, col_ids, index_type, include_col_ids);
+  }
   l.unlock();
 
   if (info == nullptr) {
@@ -39,7 +39,17 @@
 namespace bustub {
 
 auto BustubInstance::MakeExecutorContext(Transaction *txn, bool is_modify) -> std::unique_ptr<ExecutorContext> {
-  return std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_, is_modify);
+  auto exec_ctx =
+      std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_, is_modify);
+  auto budget = GetSessionVariable("hash_join_memory_budget");
+  if (!budget.empty()) {
+    exec_ctx->SetHashJoinMemoryBudget(std::stoull(budget));
+  }
+  auto cache_size = GetSessionVariable("hash_join_cache_size");
+  if (!cache_size.empty()) {
+    exec_ctx->SetHashJoinCacheSize(std::stoull(cache_size));
+  }
+  return exec_ctx;
 }
 
 BustubInstance::BustubInstance(const std::string &db_file_name) {
@@ -287,6 +297,12 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
     }
     std::vector<Tuple> result_set{};
     is_successful &= execution_engine_->Execute(optimized_plan, &result_set, txn, exec_ctx.get());
+    // report the rows that the runtime filters of hash joins dropped, see `show runtime_filter_rows_eliminated`
+    session_variables_["runtime_filter_rows_eliminated"] = std::to_string(exec_ctx->GetRuntimeFilterRowsEliminated());
+    // and what the hash joins spilled to temporary files, see `show hash_join_spilled_partitions`
+    session_variables_["hash_join_spilled_bytes"] = std::to_string(exec_ctx->GetHashJoinSpilledBytes());
+    session_variables_["hash_join_spilled_partitions"] = std::to_string(exec_ctx->GetHashJoinSpilledPartitions());
+    session_variables_["hash_join_repartitions"] = std::to_string(exec_ctx->GetHashJoinRepartitions());
 
     // Return the result set as a vector of string.
     auto schema = planner.plan_->OutputSchema();
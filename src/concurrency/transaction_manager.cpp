@@ -39,6 +39,21 @@ void TransactionManager::Abort(Transaction *txn) {
     tuple_meta.is_deleted_ = !tuple_meta.is_deleted_;
     table_write_record.table_heap_->UpdateTupleMeta(tuple_meta, table_write_record.rid_);
   }
+  // index entries are reverted too, since index-only scans trust the index to hold exactly the visible tuples
+  auto index_write_set = txn->GetIndexWriteSet();
+  while (!index_write_set->empty()) {
+    IndexWriteRecord &index_write_record = index_write_set->back();
+    auto *table_info = index_write_record.catalog_->GetTable(index_write_record.table_oid_);
+    auto *index_info = index_write_record.catalog_->GetIndex(index_write_record.index_oid_);
+    auto key = index_write_record.tuple_.KeyFromTuple(table_info->schema_, *index_info->index_->GetEntrySchema(),
+                                                      index_info->index_->GetEntryAttrs());
+    if (index_write_record.wtype_ == WType::INSERT) {
+      index_info->index_->DeleteEntry(key, index_write_record.rid_, txn);
+    } else if (index_write_record.wtype_ == WType::DELETE) {
+      index_info->index_->InsertEntry(key, index_write_record.rid_, txn);
+    }
+    index_write_set->pop_back();
+  }
   ReleaseLocks(txn);
   txn->SetState(TransactionState::ABORTED);
 }
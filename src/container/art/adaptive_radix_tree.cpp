@@ -0,0 +1,582 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// adaptive_radix_tree.cpp
+//
+// Identification: src/container/art/adaptive_radix_tree.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "container/art/adaptive_radix_tree.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/rid.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * Match the prefix of a node against the key, as far as the node stores it.
+ * @param[in,out] depth the position of the prefix in the key, moved past it
+ * @return false if the key cannot be below the node
+ */
+auto PrefixMatches(const ArtNode *node, std::string_view key, size_t *depth) -> bool {
+  uint32_t prefix_len = node->prefix_len_;
+  if (key.size() < *depth + prefix_len) {
+    return false;
+  }
+  uint32_t stored = std::min(prefix_len, ART_MAX_PREFIX_LEN);
+  for (uint32_t i = 0; i < stored; i++) {
+    if (node->prefix_[i] != static_cast<uint8_t>(key[*depth + i])) {
+      return false;
+    }
+  }
+  // the bytes past the stored ones are checked against the key in the leaf
+  *depth += prefix_len;
+  return true;
+}
+
+/** Put a leaf under a new node, as its value if its key ends at `depth`. */
+void AddToNewNode(ArtNode *node, std::string_view key, size_t depth, ArtNode *leaf) {
+  if (key.size() == depth) {
+    node->value_ = leaf;
+  } else {
+    node->InsertChild(static_cast<uint8_t>(key[depth]), leaf);
+  }
+}
+
+}  // namespace
+
+template <typename ValueType>
+ART_TYPE::AdaptiveRadixTree() : root_(ArtNode::New(ArtNodeType::NODE256)) {}
+
+template <typename ValueType>
+ART_TYPE::~AdaptiveRadixTree() {
+  FreeSubtree(root_);
+  for (const auto &[epoch, child] : retired_) {
+    FreeChild(child);
+  }
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+template <typename ValueType>
+auto ART_TYPE::Get(std::string_view key) const -> std::optional<ValueType> {
+  OperationGuard guard(this);
+  std::optional<ValueType> result;
+  while (!TryGet(key, &result)) {
+  }
+  return result;
+}
+
+template <typename ValueType>
+auto ART_TYPE::TryGet(std::string_view key, std::optional<ValueType> *result) const -> bool {
+  const ArtNode *node = root_;
+  uint64_t version;
+  if (!node->ReadLock(&version)) {
+    return false;
+  }
+  size_t depth = 0;
+  while (true) {
+    if (!PrefixMatches(node, key, &depth)) {
+      return node->Validate(version);
+    }
+    ArtNode *child = depth == key.size() ? node->value_ : node->FindChild(static_cast<uint8_t>(key[depth]));
+    if (!node->Validate(version)) {
+      return false;
+    }
+    if (child == nullptr) {
+      return true;
+    }
+    if (ArtNode::IsLeaf(child)) {
+      // leaves never change, and a retired one stays readable until this operation ends
+      const Leaf *leaf = AsLeaf(child);
+      if (leaf->key_ == key) {
+        *result = leaf->value_;
+      }
+      return true;
+    }
+    uint64_t child_version;
+    if (!child->ReadLock(&child_version) || !node->Validate(version)) {
+      return false;
+    }
+    node = child;
+    version = child_version;
+    depth++;
+  }
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+template <typename ValueType>
+auto ART_TYPE::Insert(std::string_view key, ValueType value) -> bool {
+  return InsertLeaf(key, new Leaf{std::string(key), std::move(value)}, false);
+}
+
+template <typename ValueType>
+void ART_TYPE::Put(std::string_view key, ValueType value) {
+  InsertLeaf(key, new Leaf{std::string(key), std::move(value)}, true);
+}
+
+template <typename ValueType>
+auto ART_TYPE::InsertLeaf(std::string_view key, Leaf *leaf, bool overwrite) -> bool {
+  OperationGuard guard(this);
+  bool inserted;
+  while (!TryInsert(key, leaf, overwrite, &inserted)) {
+  }
+  if (!inserted) {
+    delete leaf;
+  }
+  return inserted;
+}
+
+template <typename ValueType>
+auto ART_TYPE::TryInsert(std::string_view key, Leaf *leaf, bool overwrite, bool *inserted) -> bool {
+  ArtNode *new_child = ArtNode::TagLeaf(leaf);
+  ArtNode *parent = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_byte = 0;
+  ArtNode *node = root_;
+  uint64_t version;
+  if (!node->ReadLock(&version)) {
+    return false;
+  }
+  size_t depth = 0;
+  while (true) {
+    uint32_t prefix_len = node->prefix_len_;
+    if (prefix_len > 0) {
+      std::string prefix;
+      if (!ReadFullPrefix(node, version, depth, &prefix)) {
+        return false;
+      }
+      uint32_t matched = 0;
+      while (matched < prefix_len && depth + matched < key.size() && prefix[matched] == key[depth + matched]) {
+        matched++;
+      }
+      if (matched < prefix_len) {
+        // the key leaves the path within the prefix, a new node takes over the part that matched
+        if (!parent->Upgrade(parent_version)) {
+          return false;
+        }
+        if (!node->Upgrade(version)) {
+          parent->WriteUnlock();
+          return false;
+        }
+        ArtNode *split = ArtNode::New(ArtNodeType::NODE4);
+        split->SetPrefix(prefix.data(), matched);
+        AddToNewNode(split, key, depth + matched, new_child);
+        split->InsertChild(static_cast<uint8_t>(prefix[matched]), node);
+        node->SetPrefix(prefix.data() + matched + 1, prefix_len - matched - 1);
+        parent->ReplaceChild(parent_byte, split);
+        node->WriteUnlock();
+        parent->WriteUnlock();
+        size_++;
+        *inserted = true;
+        return true;
+      }
+      depth += prefix_len;
+    }
+
+    if (depth == key.size()) {
+      if (!node->Upgrade(version)) {
+        return false;
+      }
+      ArtNode *old_value = node->value_;
+      if (old_value != nullptr && !overwrite) {
+        node->WriteUnlock();
+        *inserted = false;
+        return true;
+      }
+      node->value_ = new_child;
+      node->WriteUnlock();
+      if (old_value != nullptr) {
+        Retire(old_value);
+      } else {
+        size_++;
+      }
+      *inserted = true;
+      return true;
+    }
+
+    auto byte = static_cast<uint8_t>(key[depth]);
+    ArtNode *child = node->FindChild(byte);
+    if (!node->Validate(version)) {
+      return false;
+    }
+
+    if (child == nullptr) {
+      if (node->IsFull()) {
+        // the root never fills up, so a full node has a parent to hang its larger copy from
+        if (!parent->Upgrade(parent_version)) {
+          return false;
+        }
+        if (!node->Upgrade(version)) {
+          parent->WriteUnlock();
+          return false;
+        }
+        ArtNode *bigger = node->Grow();
+        bigger->InsertChild(byte, new_child);
+        parent->ReplaceChild(parent_byte, bigger);
+        node->WriteUnlockObsolete();
+        parent->WriteUnlock();
+        Retire(node);
+      } else {
+        if (!node->Upgrade(version)) {
+          return false;
+        }
+        node->InsertChild(byte, new_child);
+        node->WriteUnlock();
+      }
+      size_++;
+      *inserted = true;
+      return true;
+    }
+
+    if (ArtNode::IsLeaf(child)) {
+      if (!node->Upgrade(version)) {
+        return false;
+      }
+      Leaf *existing = AsLeaf(child);
+      if (existing->key_ == key) {
+        if (overwrite) {
+          node->ReplaceChild(byte, new_child);
+        }
+        node->WriteUnlock();
+        if (overwrite) {
+          Retire(child);
+        }
+        *inserted = overwrite;
+        return true;
+      }
+      // both keys go on past the byte, a new node holds them apart after the bytes they share
+      size_t new_depth = depth + 1;
+      size_t common = 0;
+      while (new_depth + common < key.size() && new_depth + common < existing->key_.size() &&
+             key[new_depth + common] == existing->key_[new_depth + common]) {
+        common++;
+      }
+      ArtNode *split = ArtNode::New(ArtNodeType::NODE4);
+      split->SetPrefix(key.data() + new_depth, common);
+      AddToNewNode(split, key, new_depth + common, new_child);
+      AddToNewNode(split, existing->key_, new_depth + common, child);
+      node->ReplaceChild(byte, split);
+      node->WriteUnlock();
+      size_++;
+      *inserted = true;
+      return true;
+    }
+
+    uint64_t child_version;
+    if (!child->ReadLock(&child_version) || !node->Validate(version)) {
+      return false;
+    }
+    parent = node;
+    parent_version = version;
+    parent_byte = byte;
+    node = child;
+    version = child_version;
+    depth++;
+  }
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+template <typename ValueType>
+auto ART_TYPE::Remove(std::string_view key) -> bool {
+  OperationGuard guard(this);
+  bool removed;
+  while (!TryRemove(key, &removed)) {
+  }
+  return removed;
+}
+
+/*
+ * Every node but the root holds at least two keys, as a child or as its
+ * value. A node left with one is replaced by what remains: a leaf directly,
+ * an inner node with the prefix of the node and the byte in front of its own.
+ */
+template <typename ValueType>
+auto ART_TYPE::TryRemove(std::string_view key, bool *removed) -> bool {
+  *removed = false;
+  ArtNode *parent = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_byte = 0;
+  ArtNode *node = root_;
+  uint64_t version;
+  if (!node->ReadLock(&version)) {
+    return false;
+  }
+  size_t depth = 0;
+  while (true) {
+    size_t node_depth = depth;
+    if (!PrefixMatches(node, key, &depth)) {
+      return node->Validate(version);
+    }
+    bool at_value = depth == key.size();
+    uint8_t byte = at_value ? 0 : static_cast<uint8_t>(key[depth]);
+    ArtNode *child = at_value ? node->value_ : node->FindChild(byte);
+    uint32_t num_entries = node->NumChildren() + (node->value_ != nullptr ? 1 : 0);
+    bool should_shrink = node->ShouldShrink();
+    if (!node->Validate(version)) {
+      return false;
+    }
+    if (child == nullptr) {
+      return true;
+    }
+
+    if (!ArtNode::IsLeaf(child)) {
+      uint64_t child_version;
+      if (!child->ReadLock(&child_version) || !node->Validate(version)) {
+        return false;
+      }
+      parent = node;
+      parent_version = version;
+      parent_byte = byte;
+      node = child;
+      version = child_version;
+      depth++;
+      continue;
+    }
+    if (AsLeaf(child)->key_ != key) {
+      return true;
+    }
+
+    if (node != root_ && (num_entries == 2 || (!at_value && should_shrink))) {
+      if (!parent->Upgrade(parent_version)) {
+        return false;
+      }
+      if (!node->Upgrade(version)) {
+        parent->WriteUnlock();
+        return false;
+      }
+      ArtNode *replacement;
+      if (num_entries == 2) {
+        std::vector<std::pair<uint8_t, ArtNode *>> children;
+        node->GetChildren(&children);
+        auto remaining = std::find_if(children.begin(), children.end(),
+                                      [&](const auto &entry) { return at_value || entry.first != byte; });
+        if (at_value || node->value_ == nullptr) {
+          replacement = remaining->second;
+          if (!ArtNode::IsLeaf(replacement)) {
+            // the child moves up to the place of the node, its prefix grows by the prefix of the node and the byte
+            if (!replacement->WriteLock()) {
+              node->WriteUnlock();
+              parent->WriteUnlock();
+              return false;
+            }
+            std::string prefix(key.substr(node_depth, node->prefix_len_));
+            prefix.push_back(static_cast<char>(remaining->first));
+            prefix.append(reinterpret_cast<const char *>(replacement->prefix_),
+                          std::min(replacement->prefix_len_, ART_MAX_PREFIX_LEN));
+            replacement->SetPrefix(prefix.data(), node->prefix_len_ + 1 + replacement->prefix_len_);
+            replacement->WriteUnlock();
+          }
+        } else {
+          replacement = node->value_;
+        }
+      } else {
+        replacement = node->Shrink();
+        replacement->RemoveChild(byte);
+      }
+      parent->ReplaceChild(parent_byte, replacement);
+      node->WriteUnlockObsolete();
+      parent->WriteUnlock();
+      Retire(node);
+    } else {
+      if (!node->Upgrade(version)) {
+        return false;
+      }
+      if (at_value) {
+        node->value_ = nullptr;
+      } else {
+        node->RemoveChild(byte);
+      }
+      node->WriteUnlock();
+    }
+    Retire(child);
+    size_--;
+    *removed = true;
+    return true;
+  }
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename ValueType>
+auto ART_TYPE::ReadFullPrefix(const ArtNode *node, uint64_t version, size_t depth, std::string *prefix) const
+    -> bool {
+  uint32_t prefix_len = node->prefix_len_;
+  if (prefix_len <= ART_MAX_PREFIX_LEN) {
+    prefix->assign(reinterpret_cast<const char *>(node->prefix_), prefix_len);
+    return node->Validate(version);
+  }
+  // every key below the node has the prefix, take it from any of them
+  const ArtNode *current = node;
+  uint64_t current_version = version;
+  while (true) {
+    ArtNode *next = current->value_;
+    if (next == nullptr) {
+      std::vector<std::pair<uint8_t, ArtNode *>> children;
+      current->GetChildren(&children);
+      next = children.empty() ? nullptr : children.front().second;
+    }
+    if (!current->Validate(current_version) || next == nullptr) {
+      return false;
+    }
+    if (ArtNode::IsLeaf(next)) {
+      const std::string &key = AsLeaf(next)->key_;
+      if (key.size() < depth + prefix_len) {
+        return false;
+      }
+      prefix->assign(key, depth, prefix_len);
+      return node->Validate(version);
+    }
+    uint64_t next_version;
+    if (!next->ReadLock(&next_version) || !current->Validate(current_version)) {
+      return false;
+    }
+    current = next;
+    current_version = next_version;
+  }
+}
+
+template <typename ValueType>
+void ART_TYPE::Retire(ArtNode *child) {
+  std::scoped_lock lock(retired_latch_);
+  retired_.emplace_back(global_epoch_.load(), child);
+  num_retired_++;
+}
+
+/*
+ * A thread starts looking for a free slot at one picked by its id, so that the
+ * threads of a workload mostly keep to their own. The epoch is read again
+ * after it is announced, as the epoch may have advanced past the announced one
+ * without seeing it.
+ */
+template <typename ValueType>
+auto ART_TYPE::BeginOperation() const -> EpochSlot * {
+  size_t idx = std::hash<std::thread::id>()(std::this_thread::get_id()) % NUM_EPOCH_SLOTS;
+  uint64_t epoch = global_epoch_.load();
+  while (true) {
+    uint64_t free = 0;
+    if (epoch_slots_[idx].epoch_.compare_exchange_strong(free, epoch)) {
+      break;
+    }
+    idx = (idx + 1) % NUM_EPOCH_SLOTS;
+  }
+  EpochSlot *slot = &epoch_slots_[idx];
+  for (uint64_t current = global_epoch_.load(); current != epoch; current = global_epoch_.load()) {
+    epoch = current;
+    slot->epoch_.store(epoch);
+  }
+  return slot;
+}
+
+template <typename ValueType>
+void ART_TYPE::EndOperation(EpochSlot *slot) const {
+  slot->epoch_.store(0);
+  if (num_retired_.load() > 0) {
+    Reclaim();
+  }
+}
+
+/*
+ * Whatever is retired in epoch e was unlinked first, so only the operations
+ * that announced e or an older epoch can still hold it. The epoch advances
+ * from e + 1 only once every operation in flight announced e + 1, so when it
+ * reaches e + 2 none of those is left. Reclaiming is skipped while another
+ * thread is at it.
+ */
+template <typename ValueType>
+void ART_TYPE::Reclaim() const {
+  std::vector<ArtNode *> garbage;
+  {
+    std::unique_lock lock(retired_latch_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      return;
+    }
+    uint64_t epoch = global_epoch_.load();
+    bool all_current = std::all_of(epoch_slots_.begin(), epoch_slots_.end(), [epoch](const EpochSlot &slot) {
+      uint64_t announced = slot.epoch_.load();
+      return announced == 0 || announced == epoch;
+    });
+    if (all_current) {
+      epoch = global_epoch_.fetch_add(1) + 1;
+    }
+    while (!retired_.empty() && retired_.front().first + 2 <= epoch) {
+      garbage.push_back(retired_.front().second);
+      retired_.pop_front();
+    }
+    num_retired_ -= garbage.size();
+  }
+  for (auto *child : garbage) {
+    FreeChild(child);
+  }
+}
+
+template <typename ValueType>
+void ART_TYPE::FreeChild(ArtNode *child) {
+  if (ArtNode::IsLeaf(child)) {
+    delete AsLeaf(child);
+  } else {
+    ArtNode::Delete(child);
+  }
+}
+
+template <typename ValueType>
+void ART_TYPE::FreeSubtree(ArtNode *child) {
+  if (!ArtNode::IsLeaf(child)) {
+    std::vector<std::pair<uint8_t, ArtNode *>> children;
+    child->GetChildren(&children);
+    for (const auto &entry : children) {
+      FreeSubtree(entry.second);
+    }
+    if (child->value_ != nullptr) {
+      FreeChild(child->value_);
+    }
+  }
+  FreeChild(child);
+}
+
+template <typename ValueType>
+auto ART_TYPE::MemoryUsage() const -> size_t {
+  return SubtreeMemoryUsage(root_);
+}
+
+template <typename ValueType>
+auto ART_TYPE::SubtreeMemoryUsage(const ArtNode *child) -> size_t {
+  if (ArtNode::IsLeaf(child)) {
+    const Leaf *leaf = AsLeaf(child);
+    // a short key lives inside the string itself
+    return sizeof(Leaf) + (leaf->key_.capacity() > sizeof(std::string) ? leaf->key_.capacity() + 1 : 0);
+  }
+  size_t usage = child->MemoryUsage();
+  std::vector<std::pair<uint8_t, ArtNode *>> children;
+  child->GetChildren(&children);
+  for (const auto &entry : children) {
+    usage += SubtreeMemoryUsage(entry.second);
+  }
+  if (child->value_ != nullptr) {
+    usage += SubtreeMemoryUsage(child->value_);
+  }
+  return usage;
+}
+
+template class AdaptiveRadixTree<RID>;
+template class AdaptiveRadixTree<uint32_t>;
+template class AdaptiveRadixTree<uint64_t>;
+template class AdaptiveRadixTree<std::string>;
+
+}  // namespace bustub
@@ -0,0 +1,386 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// art_node.cpp
+//
+// Identification: src/container/art/art_node.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "container/art/art_node.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>  // NOLINT
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common/exception.h"
+
+namespace bustub {
+
+auto ArtNode::New(ArtNodeType type) -> ArtNode * {
+  switch (type) {
+    case ArtNodeType::NODE4:
+      return new ArtNode4();
+    case ArtNodeType::NODE16:
+      return new ArtNode16();
+    case ArtNodeType::NODE48:
+      return new ArtNode48();
+    case ArtNodeType::NODE256:
+      return new ArtNode256();
+  }
+  UNREACHABLE("unknown ART node type");
+}
+
+void ArtNode::Delete(ArtNode *node) {
+  switch (node->type_) {
+    case ArtNodeType::NODE4:
+      delete static_cast<ArtNode4 *>(node);
+      break;
+    case ArtNodeType::NODE16:
+      delete static_cast<ArtNode16 *>(node);
+      break;
+    case ArtNodeType::NODE48:
+      delete static_cast<ArtNode48 *>(node);
+      break;
+    case ArtNodeType::NODE256:
+      delete static_cast<ArtNode256 *>(node);
+      break;
+  }
+}
+
+ArtNode48::ArtNode48() : ArtNode(ArtNodeType::NODE48) { memset(child_index_, EMPTY, sizeof(child_index_)); }
+
+/*****************************************************************************
+ * VERSION LOCK
+ *****************************************************************************/
+
+auto ArtNode::ReadLock(uint64_t *version) const -> bool {
+  uint64_t current = version_.load();
+  while ((current & LOCKED_BIT) != 0) {
+    std::this_thread::yield();
+    current = version_.load();
+  }
+  *version = current;
+  return (current & OBSOLETE_BIT) == 0;
+}
+
+auto ArtNode::Upgrade(uint64_t version) -> bool {
+  return version_.compare_exchange_strong(version, version + LOCKED_BIT);
+}
+
+auto ArtNode::WriteLock() -> bool {
+  while (true) {
+    uint64_t version;
+    if (!ReadLock(&version)) {
+      return false;
+    }
+    if (Upgrade(version)) {
+      return true;
+    }
+  }
+}
+
+/*****************************************************************************
+ * CHILDREN
+ *****************************************************************************/
+
+/*
+ * The counts and slots read here may be torn by a concurrent writer, so they
+ * are clamped to the arrays: a reader must not fault before it gets to
+ * validate the version.
+ */
+auto ArtNode::FindChild(uint8_t byte) const -> ArtNode * {
+  switch (type_) {
+    case ArtNodeType::NODE4: {
+      const auto *node = static_cast<const ArtNode4 *>(this);
+      uint32_t num_children = std::min<uint32_t>(num_children_, ArtNode4::CAPACITY);
+      for (uint32_t i = 0; i < num_children; i++) {
+        if (node->keys_[i] == byte) {
+          return node->children_[i];
+        }
+      }
+      return nullptr;
+    }
+    case ArtNodeType::NODE16: {
+      const auto *node = static_cast<const ArtNode16 *>(this);
+      uint32_t num_children = std::min<uint32_t>(num_children_, ArtNode16::CAPACITY);
+#if defined(__SSE2__)
+      // compare the byte with all 16 keys at once, the slots past the children are masked off
+      __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                       _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->keys_)));
+      uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(matches)) & ((1U << num_children) - 1);
+      return mask == 0 ? nullptr : node->children_[__builtin_ctz(mask)];
+#else
+      for (uint32_t i = 0; i < num_children; i++) {
+        if (node->keys_[i] == byte) {
+          return node->children_[i];
+        }
+      }
+      return nullptr;
+#endif
+    }
+    case ArtNodeType::NODE48: {
+      const auto *node = static_cast<const ArtNode48 *>(this);
+      uint8_t slot = node->child_index_[byte];
+      return slot < ArtNode48::CAPACITY ? node->children_[slot] : nullptr;
+    }
+    case ArtNodeType::NODE256:
+      return static_cast<const ArtNode256 *>(this)->children_[byte];
+  }
+  return nullptr;
+}
+
+auto ArtNode::IsFull() const -> bool {
+  switch (type_) {
+    case ArtNodeType::NODE4:
+      return num_children_ == ArtNode4::CAPACITY;
+    case ArtNodeType::NODE16:
+      return num_children_ == ArtNode16::CAPACITY;
+    case ArtNodeType::NODE48:
+      return num_children_ == ArtNode48::CAPACITY;
+    case ArtNodeType::NODE256:
+      return false;
+  }
+  return false;
+}
+
+/*
+ * A node shrinks well below the size it grew at, so that a node on the edge
+ * does not flip between two types.
+ */
+auto ArtNode::ShouldShrink() const -> bool {
+  switch (type_) {
+    case ArtNodeType::NODE4:
+      return false;
+    case ArtNodeType::NODE16:
+      return num_children_ <= ArtNode4::CAPACITY;
+    case ArtNodeType::NODE48:
+      return num_children_ <= ArtNode16::CAPACITY - 3;
+    case ArtNodeType::NODE256:
+      return num_children_ <= ArtNode48::CAPACITY - 10;
+  }
+  return false;
+}
+
+namespace {
+
+/** Insert into sorted parallel arrays of keys and children. */
+void InsertSorted(uint8_t *keys, ArtNode **children, uint32_t num_children, uint8_t byte, ArtNode *child) {
+  uint32_t pos = 0;
+  while (pos < num_children && keys[pos] < byte) {
+    pos++;
+  }
+  std::memmove(keys + pos + 1, keys + pos, num_children - pos);
+  std::memmove(children + pos + 1, children + pos, (num_children - pos) * sizeof(ArtNode *));
+  keys[pos] = byte;
+  children[pos] = child;
+}
+
+void RemoveSorted(uint8_t *keys, ArtNode **children, uint32_t num_children, uint8_t byte) {
+  uint32_t pos = 0;
+  while (pos < num_children && keys[pos] != byte) {
+    pos++;
+  }
+  BUSTUB_ASSERT(pos < num_children, "removing a child that does not exist");
+  std::memmove(keys + pos, keys + pos + 1, num_children - pos - 1);
+  std::memmove(children + pos, children + pos + 1, (num_children - pos - 1) * sizeof(ArtNode *));
+}
+
+}  // namespace
+
+void ArtNode::InsertChild(uint8_t byte, ArtNode *child) {
+  switch (type_) {
+    case ArtNodeType::NODE4: {
+      auto *node = static_cast<ArtNode4 *>(this);
+      InsertSorted(node->keys_, node->children_, num_children_, byte, child);
+      break;
+    }
+    case ArtNodeType::NODE16: {
+      auto *node = static_cast<ArtNode16 *>(this);
+      InsertSorted(node->keys_, node->children_, num_children_, byte, child);
+      break;
+    }
+    case ArtNodeType::NODE48: {
+      auto *node = static_cast<ArtNode48 *>(this);
+      uint8_t slot = 0;
+      while (node->children_[slot] != nullptr) {
+        slot++;
+      }
+      node->children_[slot] = child;
+      node->child_index_[byte] = slot;
+      break;
+    }
+    case ArtNodeType::NODE256:
+      static_cast<ArtNode256 *>(this)->children_[byte] = child;
+      break;
+  }
+  num_children_++;
+}
+
+void ArtNode::ReplaceChild(uint8_t byte, ArtNode *child) {
+  switch (type_) {
+    case ArtNodeType::NODE4: {
+      auto *node = static_cast<ArtNode4 *>(this);
+      node->children_[std::find(node->keys_, node->keys_ + num_children_, byte) - node->keys_] = child;
+      break;
+    }
+    case ArtNodeType::NODE16: {
+      auto *node = static_cast<ArtNode16 *>(this);
+      node->children_[std::find(node->keys_, node->keys_ + num_children_, byte) - node->keys_] = child;
+      break;
+    }
+    case ArtNodeType::NODE48: {
+      auto *node = static_cast<ArtNode48 *>(this);
+      node->children_[node->child_index_[byte]] = child;
+      break;
+    }
+    case ArtNodeType::NODE256:
+      static_cast<ArtNode256 *>(this)->children_[byte] = child;
+      break;
+  }
+}
+
+void ArtNode::RemoveChild(uint8_t byte) {
+  switch (type_) {
+    case ArtNodeType::NODE4: {
+      auto *node = static_cast<ArtNode4 *>(this);
+      RemoveSorted(node->keys_, node->children_, num_children_, byte);
+      break;
+    }
+    case ArtNodeType::NODE16: {
+      auto *node = static_cast<ArtNode16 *>(this);
+      RemoveSorted(node->keys_, node->children_, num_children_, byte);
+      break;
+    }
+    case ArtNodeType::NODE48: {
+      auto *node = static_cast<ArtNode48 *>(this);
+      uint8_t slot = node->child_index_[byte];
+      node->child_index_[byte] = ArtNode48::EMPTY;
+      node->children_[slot] = nullptr;
+      break;
+    }
+    case ArtNodeType::NODE256:
+      static_cast<ArtNode256 *>(this)->children_[byte] = nullptr;
+      break;
+  }
+  num_children_--;
+}
+
+void ArtNode::GetChildren(std::vector<std::pair<uint8_t, ArtNode *>> *children) const {
+  switch (type_) {
+    case ArtNodeType::NODE4: {
+      const auto *node = static_cast<const ArtNode4 *>(this);
+      for (uint32_t i = 0; i < num_children_; i++) {
+        children->emplace_back(node->keys_[i], node->children_[i]);
+      }
+      break;
+    }
+    case ArtNodeType::NODE16: {
+      const auto *node = static_cast<const ArtNode16 *>(this);
+      for (uint32_t i = 0; i < num_children_; i++) {
+        children->emplace_back(node->keys_[i], node->children_[i]);
+      }
+      break;
+    }
+    case ArtNodeType::NODE48: {
+      const auto *node = static_cast<const ArtNode48 *>(this);
+      for (uint32_t byte = 0; byte < 256; byte++) {
+        if (node->child_index_[byte] != ArtNode48::EMPTY) {
+          children->emplace_back(byte, node->children_[node->child_index_[byte]]);
+        }
+      }
+      break;
+    }
+    case ArtNodeType::NODE256: {
+      const auto *node = static_cast<const ArtNode256 *>(this);
+      for (uint32_t byte = 0; byte < 256; byte++) {
+        if (node->children_[byte] != nullptr) {
+          children->emplace_back(byte, node->children_[byte]);
+        }
+      }
+      break;
+    }
+  }
+}
+
+void ArtNode::CopyHeader(const ArtNode &other) {
+  prefix_len_ = other.prefix_len_;
+  memcpy(prefix_, other.prefix_, sizeof(prefix_));
+  value_ = other.value_;
+}
+
+auto ArtNode::Grow() const -> ArtNode * {
+  ArtNode *bigger;
+  switch (type_) {
+    case ArtNodeType::NODE4:
+      bigger = New(ArtNodeType::NODE16);
+      break;
+    case ArtNodeType::NODE16:
+      bigger = New(ArtNodeType::NODE48);
+      break;
+    case ArtNodeType::NODE48:
+      bigger = New(ArtNodeType::NODE256);
+      break;
+    case ArtNodeType::NODE256:
+    default:
+      throw Exception(ExceptionType::INVALID, "a Node256 cannot grow");
+  }
+  bigger->CopyHeader(*this);
+  std::vector<std::pair<uint8_t, ArtNode *>> children;
+  GetChildren(&children);
+  for (const auto &[byte, child] : children) {
+    bigger->InsertChild(byte, child);
+  }
+  return bigger;
+}
+
+auto ArtNode::Shrink() const -> ArtNode * {
+  ArtNode *smaller;
+  switch (type_) {
+    case ArtNodeType::NODE16:
+      smaller = New(ArtNodeType::NODE4);
+      break;
+    case ArtNodeType::NODE48:
+      smaller = New(ArtNodeType::NODE16);
+      break;
+    case ArtNodeType::NODE256:
+      smaller = New(ArtNodeType::NODE48);
+      break;
+    case ArtNodeType::NODE4:
+    default:
+      throw Exception(ExceptionType::INVALID, "a Node4 cannot shrink");
+  }
+  smaller->CopyHeader(*this);
+  std::vector<std::pair<uint8_t, ArtNode *>> children;
+  GetChildren(&children);
+  for (const auto &[byte, child] : children) {
+    smaller->InsertChild(byte, child);
+  }
+  return smaller;
+}
+
+auto ArtNode::MemoryUsage() const -> size_t {
+  switch (type_) {
+    case ArtNodeType::NODE4:
+      return sizeof(ArtNode4);
+    case ArtNodeType::NODE16:
+      return sizeof(ArtNode16);
+    case ArtNodeType::NODE48:
+      return sizeof(ArtNode48);
+    case ArtNodeType::NODE256:
+      return sizeof(ArtNode256);
+  }
+  return 0;
+}
+
+void ArtNode::SetPrefix(const char *bytes, uint32_t len) {
+  prefix_len_ = len;
+  memcpy(prefix_, bytes, std::min(len, ART_MAX_PREFIX_LEN));
+}
+
+}  // namespace bustub
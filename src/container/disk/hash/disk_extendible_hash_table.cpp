@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -26,7 +28,16 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::DiskExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                          const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
     : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
-  //  implement me!
+  // a directory of global depth 0 pointing to a single empty bucket
+  auto *dir_page = reinterpret_cast<HashTableDirectoryPage *>(
+      NewZeroedPage(&directory_page_id_, "failed to allocate the directory of hash table " + name));
+  dir_page->SetPageId(directory_page_id_);
+  page_id_t bucket_page_id;
+  NewBucketPage(&bucket_page_id, "failed to allocate the first bucket of hash table " + name);
+  dir_page->SetBucketPageId(0, bucket_page_id);
+  dir_page->SetLocalDepth(0, 0);
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, true);
 }
 
 /*****************************************************************************
@@ -46,22 +57,42 @@ auto HASH_TABLE_TYPE::Hash(KeyType key) -> uint32_t {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToDirectoryIndex(KeyType key, HashTableDirectoryPage *dir_page) -> uint32_t {
-  return 0;
+  return Hash(key) & dir_page->GetGlobalDepthMask();
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) -> page_id_t {
-  return 0;
+  return dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page));
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchDirectoryPage() -> HashTableDirectoryPage * {
-  return nullptr;
+  Page *page = buffer_pool_manager_->FetchPage(directory_page_id_);
+  return page == nullptr ? nullptr : reinterpret_cast<HashTableDirectoryPage *>(page->GetData());
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE * {
-  return nullptr;
+  Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  return page == nullptr ? nullptr : reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::NewZeroedPage(page_id_t *page_id, const std::string &what) -> char * {
+  Page *page = buffer_pool_manager_->NewPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, what);
+  }
+  // the buffer pool does not clear recycled frames, and an empty bucket must have no slot occupied
+  memset(page->GetData(), 0, BUSTUB_PAGE_SIZE);
+  return page->GetData();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::NewBucketPage(page_id_t *page_id, const std::string &what) -> HASH_TABLE_BUCKET_TYPE * {
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(NewZeroedPage(page_id, what));
+  bucket->SetNextPageId(INVALID_PAGE_ID);
+  return bucket;
 }
 
 /*****************************************************************************
@@ -69,20 +100,232 @@ auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BU
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.RUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch the directory of the hash table");
+  }
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  if (page == nullptr) {
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+    table_latch_.RUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch a bucket of the hash table");
+  }
+  page->RLatch();
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool found = bucket->GetValue(key, comparator_, result);
+  page_id_t overflow_page_id = bucket->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  // overflow pages are only changed under the exclusive table latch, so they are read without latching them
+  while (overflow_page_id != INVALID_PAGE_ID) {
+    HASH_TABLE_BUCKET_TYPE *overflow = FetchBucketPage(overflow_page_id);
+    if (overflow == nullptr) {
+      buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+      table_latch_.RUnlock();
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch an overflow page of the hash table");
+    }
+    found = overflow->GetValue(key, comparator_, result) || found;
+    page_id_t next_page_id = overflow->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(overflow_page_id, false);
+    overflow_page_id = next_page_id;
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  return found;
 }
 
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
+/*
+ * The directory is only read, so inserts into different buckets run side by
+ * side under the shared table latch, each write-latching its bucket. A full
+ * bucket, or one with overflow pages, is left to SplitInsert, which takes the
+ * table latch exclusively.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.RUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch the directory of the hash table");
+  }
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  if (page == nullptr) {
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+    table_latch_.RUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch a bucket of the hash table");
+  }
+  page->WLatch();
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool full = bucket->IsFull() || bucket->GetNextPageId() != INVALID_PAGE_ID;
+  bool inserted = !full && bucket->Insert(key, value, comparator_);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  if (full) {
+    return SplitInsert(transaction, key, value);
+  }
+  return inserted;
 }
 
+/*
+ * Split the bucket of the key until it has room, doubling the directory
+ * whenever the bucket is already told apart by every bit of the directory.
+ * A split may leave every entry on one side, so it is retried as long as the
+ * directory can grow. Once it cannot, the bucket goes on in overflow pages.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.WUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch the directory of the hash table");
+  }
+  bool dir_dirty = false;
+  bool inserted = false;
+  while (true) {
+    uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    HASH_TABLE_BUCKET_TYPE *bucket = FetchBucketPage(bucket_page_id);
+    if (bucket == nullptr) {
+      buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+      table_latch_.WUnlock();
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch a bucket of the hash table");
+    }
+    if (!bucket->IsFull() && bucket->GetNextPageId() == INVALID_PAGE_ID) {
+      inserted = bucket->Insert(key, value, comparator_);
+      buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+      break;
+    }
+    std::vector<ValueType> values;
+    bucket->GetValue(key, comparator_, &values);
+    if (std::find(values.begin(), values.end(), value) != values.end()) {
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      break;
+    }
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    if (local_depth == dir_page->GetGlobalDepth() && dir_page->Size() == DIRECTORY_ARRAY_SIZE) {
+      // the directory cannot grow to split the bucket
+      try {
+        inserted = ChainInsert(bucket_page_id, bucket, key, value);
+      } catch (const Exception &e) {
+        buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+        table_latch_.WUnlock();
+        throw;
+      }
+      break;
+    }
+
+    // the split image is allocated before the directory changes, so that running out of frames leaves the table as
+    // it was after the previous split, and the pins and the latch are given back before the error goes up
+    page_id_t image_page_id;
+    HASH_TABLE_BUCKET_TYPE *image;
+    try {
+      image = NewBucketPage(&image_page_id, "failed to allocate a bucket to split into");
+    } catch (const Exception &e) {
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+      table_latch_.WUnlock();
+      throw;
+    }
+    if (local_depth == dir_page->GetGlobalDepth()) {
+      dir_page->IncrGlobalDepth();
+    }
+    dir_dirty = true;
+    // the entries whose hash has the next bit set move to the split image, and so do the directory slots
+    uint32_t high_bit = 1U << local_depth;
+    for (uint32_t slot = 0; slot < BUCKET_ARRAY_SIZE; slot++) {
+      if (bucket->IsReadable(slot) && (Hash(bucket->KeyAt(slot)) & high_bit) != 0) {
+        image->Insert(bucket->KeyAt(slot), bucket->ValueAt(slot), comparator_);
+        bucket->RemoveAt(slot);
+      }
+    }
+    for (uint32_t idx = 0; idx < dir_page->Size(); idx++) {
+      if (dir_page->GetBucketPageId(idx) == bucket_page_id) {
+        dir_page->SetLocalDepth(idx, local_depth + 1);
+        if ((idx & high_bit) != 0) {
+          dir_page->SetBucketPageId(idx, image_page_id);
+        }
+      }
+    }
+    buffer_pool_manager_->UnpinPage(image_page_id, true);
+    buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+  table_latch_.WUnlock();
+  return inserted;
+}
+
+/*
+ * The pair may already be in any page of the chain, so all of them are looked
+ * at before the first one with room takes it. A new overflow page is linked
+ * right after the first page of the bucket, which leaves the rest of the
+ * chain as it is.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::ChainInsert(page_id_t bucket_page_id, HASH_TABLE_BUCKET_TYPE *bucket, const KeyType &key,
+                                  const ValueType &value) -> bool {
+  page_id_t free_page_id = bucket->IsFull() ? INVALID_PAGE_ID : bucket_page_id;
+  page_id_t overflow_page_id = bucket->GetNextPageId();
+  while (overflow_page_id != INVALID_PAGE_ID) {
+    HASH_TABLE_BUCKET_TYPE *overflow = FetchBucketPage(overflow_page_id);
+    if (overflow == nullptr) {
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch an overflow page of the hash table");
+    }
+    std::vector<ValueType> values;
+    overflow->GetValue(key, comparator_, &values);
+    bool duplicate = std::find(values.begin(), values.end(), value) != values.end();
+    if (free_page_id == INVALID_PAGE_ID && !overflow->IsFull()) {
+      free_page_id = overflow_page_id;
+    }
+    page_id_t next_page_id = overflow->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(overflow_page_id, false);
+    if (duplicate) {
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      return false;
+    }
+    overflow_page_id = next_page_id;
+  }
+
+  if (free_page_id == bucket_page_id) {
+    bool inserted = bucket->Insert(key, value, comparator_);
+    buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+    return inserted;
+  }
+  if (free_page_id != INVALID_PAGE_ID) {
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+    HASH_TABLE_BUCKET_TYPE *overflow = FetchBucketPage(free_page_id);
+    if (overflow == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch an overflow page of the hash table");
+    }
+    bool inserted = overflow->Insert(key, value, comparator_);
+    buffer_pool_manager_->UnpinPage(free_page_id, inserted);
+    return inserted;
+  }
+
+  page_id_t new_page_id;
+  HASH_TABLE_BUCKET_TYPE *overflow;
+  try {
+    overflow = NewBucketPage(&new_page_id, "failed to allocate an overflow page of the hash table");
+  } catch (const Exception &e) {
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+    throw;
+  }
+  overflow->SetNextPageId(bucket->GetNextPageId());
+  bucket->SetNextPageId(new_page_id);
+  overflow->Insert(key, value, comparator_);
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  return true;
 }
 
 /*****************************************************************************
@@ -90,14 +333,169 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.RUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch the directory of the hash table");
+  }
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  if (page == nullptr) {
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+    table_latch_.RUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch a bucket of the hash table");
+  }
+  page->WLatch();
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool chained = bucket->GetNextPageId() != INVALID_PAGE_ID;
+  bool removed = !chained && bucket->Remove(key, value, comparator_);
+  bool empty = removed && bucket->IsEmpty();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, removed);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  if (chained) {
+    return ChainRemove(transaction, key, value);
+  }
+  if (empty) {
+    Merge(transaction, key, value);
+  }
+  return removed;
+}
+
+/*
+ * An overflow page that the removal leaves empty is unlinked and deleted, so
+ * that a bucket whose entries are all gone has no chain and can merge again.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::ChainRemove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.WUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch the directory of the hash table");
+  }
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  HASH_TABLE_BUCKET_TYPE *bucket = FetchBucketPage(bucket_page_id);
+  if (bucket == nullptr) {
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+    table_latch_.WUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch a bucket of the hash table");
+  }
+  bool removed = bucket->Remove(key, value, comparator_);
+  bool bucket_dirty = removed;
+  // the page before the one looked at, which is the first page of the bucket or an overflow page pinned here
+  page_id_t prev_page_id = bucket_page_id;
+  HASH_TABLE_BUCKET_TYPE *prev = bucket;
+  bool prev_dirty = false;
+  page_id_t overflow_page_id = bucket->GetNextPageId();
+  while (!removed && overflow_page_id != INVALID_PAGE_ID) {
+    HASH_TABLE_BUCKET_TYPE *overflow = FetchBucketPage(overflow_page_id);
+    if (overflow == nullptr) {
+      if (prev != bucket) {
+        buffer_pool_manager_->UnpinPage(prev_page_id, false);
+      }
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+      table_latch_.WUnlock();
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch an overflow page of the hash table");
+    }
+    removed = overflow->Remove(key, value, comparator_);
+    if (removed && overflow->IsEmpty()) {
+      prev->SetNextPageId(overflow->GetNextPageId());
+      bucket_dirty = bucket_dirty || prev == bucket;
+      prev_dirty = prev != bucket;
+      buffer_pool_manager_->UnpinPage(overflow_page_id, false);
+      buffer_pool_manager_->DeletePage(overflow_page_id);
+      break;
+    }
+    if (prev != bucket) {
+      buffer_pool_manager_->UnpinPage(prev_page_id, false);
+    }
+    prev_page_id = overflow_page_id;
+    prev = overflow;
+    prev_dirty = removed;
+    overflow_page_id = overflow->GetNextPageId();
+  }
+  if (prev != bucket) {
+    buffer_pool_manager_->UnpinPage(prev_page_id, prev_dirty);
+  }
+  bool empty = bucket->IsEmpty() && bucket->GetNextPageId() == INVALID_PAGE_ID;
+  buffer_pool_manager_->UnpinPage(bucket_page_id, bucket_dirty);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.WUnlock();
+  if (empty) {
+    Merge(transaction, key, value);
+  }
+  return removed;
 }
 
 /*****************************************************************************
  * MERGE
  *****************************************************************************/
+/*
+ * The bucket is checked again under the exclusive table latch, an insert may
+ * have refilled it. Merging goes on as long as one of the merged bucket and
+ * its split image is empty, as an empty image may have been left behind while
+ * it could not merge with a bucket split deeper. A bucket with overflow pages
+ * is not empty even if its first page is. The directory then halves as long
+ * as no bucket needs all of its bits. Merging only saves space, so a page that
+ * cannot be fetched just ends it.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {}
+void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.WUnlock();
+    return;
+  }
+  bool dir_dirty = false;
+  while (true) {
+    uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    uint32_t image_idx = dir_page->GetSplitImageIndex(bucket_idx);
+    if (local_depth == 0 || dir_page->GetLocalDepth(image_idx) != local_depth) {
+      break;
+    }
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    page_id_t image_page_id = dir_page->GetBucketPageId(image_idx);
+    HASH_TABLE_BUCKET_TYPE *bucket = FetchBucketPage(bucket_page_id);
+    if (bucket == nullptr) {
+      break;
+    }
+    bool bucket_empty = bucket->IsEmpty() && bucket->GetNextPageId() == INVALID_PAGE_ID;
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+    HASH_TABLE_BUCKET_TYPE *image = FetchBucketPage(image_page_id);
+    if (image == nullptr) {
+      break;
+    }
+    bool image_empty = image->IsEmpty() && image->GetNextPageId() == INVALID_PAGE_ID;
+    buffer_pool_manager_->UnpinPage(image_page_id, false);
+    if (!bucket_empty && !image_empty) {
+      break;
+    }
+
+    page_id_t empty_page_id = bucket_empty ? bucket_page_id : image_page_id;
+    page_id_t kept_page_id = bucket_empty ? image_page_id : bucket_page_id;
+    for (uint32_t idx = 0; idx < dir_page->Size(); idx++) {
+      page_id_t page_id = dir_page->GetBucketPageId(idx);
+      if (page_id == bucket_page_id || page_id == image_page_id) {
+        dir_page->SetBucketPageId(idx, kept_page_id);
+        dir_page->SetLocalDepth(idx, local_depth - 1);
+      }
+    }
+    buffer_pool_manager_->DeletePage(empty_page_id);
+    dir_dirty = true;
+  }
+  while (dir_page->CanShrink()) {
+    dir_page->DecrGlobalDepth();
+    dir_dirty = true;
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+  table_latch_.WUnlock();
+}
 
 /*****************************************************************************
  * GETGLOBALDEPTH - DO NOT TOUCH
@@ -106,6 +504,10 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetGlobalDepth() -> uint32_t {
   table_latch_.RLock();
   HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.RUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch the directory of the hash table");
+  }
   uint32_t global_depth = dir_page->GetGlobalDepth();
   assert(buffer_pool_manager_->UnpinPage(directory_page_id_, false));
   table_latch_.RUnlock();
@@ -119,6 +521,10 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_TYPE::VerifyIntegrity() {
   table_latch_.RLock();
   HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.RUnlock();
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "failed to fetch the directory of the hash table");
+  }
   dir_page->VerifyIntegrity();
   assert(buffer_pool_manager_->UnpinPage(directory_page_id_, false));
   table_latch_.RUnlock();
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "execution/executors/aggregation_executor.h"
@@ -22,23 +23,38 @@ AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const Aggreg
       plan_(plan),
       child_(std::move(child)),
       aht_(plan_->GetAggregates(), plan_->GetAggregateTypes()),
-      aht_iterator_(aht_.Begin()) {}
+      aht_iterator_(aht_.Begin()) {
+  for (const auto &expr : plan_->GetGroupBys()) {
+    group_bys_.emplace_back(*expr, child_->GetOutputSchema());
+  }
+  for (const auto &expr : plan_->GetAggregates()) {
+    aggregates_.emplace_back(*expr, child_->GetOutputSchema());
+  }
+}
 
 void AggregationExecutor::Init() {
   child_->Init();
   aht_.Clear();
-  Tuple agg_tuple;
-  RID agg_rid;
-  // std::cout<<plan_->GetAggregates().size()<<" "<<plan_->GetAggregateTypes().size()<<std::endl;
-  while (true) {
-    // Get the next tuple
-    const auto status = child_->Next(&agg_tuple, &agg_rid);
-    if (!status) {
-      break;
+  DataChunk chunk;
+  std::vector<const ColumnVector *> group_bys(group_bys_.size());
+  std::vector<const ColumnVector *> aggregates(aggregates_.size());
+  std::vector<AggregateKey> agg_keys;
+  std::vector<AggregateValue> agg_vals;
+  while (child_->NextBatch(&chunk)) {
+    for (size_t i = 0; i < group_bys_.size(); i++) {
+      group_bys[i] = &group_bys_[i].Evaluate(chunk);
     }
-    AggregateKey aggregate_key = MakeAggregateKey(&agg_tuple);
-    AggregateValue aggregate_value = MakeAggregateValue(&agg_tuple);
-    aht_.InsertCombine(aggregate_key, aggregate_value);
+    for (size_t i = 0; i < aggregates_.size(); i++) {
+      aggregates[i] = &aggregates_[i].Evaluate(chunk);
+    }
+    agg_keys.clear();
+    agg_vals.clear();
+    for (size_t i = 0; i < chunk.Size(); i++) {
+      size_t row = chunk.RowAt(i);
+      agg_keys.emplace_back(MakeAggregateKey(group_bys, row));
+      agg_vals.emplace_back(MakeAggregateValue(aggregates, row));
+    }
+    aht_.InsertCombineBatch(agg_keys, agg_vals);
   }
   aht_iterator_ = aht_.Begin();
   done_ = false;
@@ -68,6 +84,27 @@ auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   return true;
 }
 
+auto AggregationExecutor::NextBatch(DataChunk *chunk) -> bool {
+  if (aht_.Begin() == aht_.End()) {
+    // no input: at most the one row of initial aggregate values
+    return AbstractExecutor::NextBatch(chunk);
+  }
+  chunk->Reset(&GetOutputSchema());
+  while (!chunk->IsFull() && aht_iterator_ != aht_.End()) {
+    const auto &group_bys = aht_iterator_.Key().group_bys_;
+    const auto &aggregates = aht_iterator_.Val().aggregates_;
+    size_t row = chunk->AppendRow(RID{});
+    for (size_t col = 0; col < group_bys.size(); col++) {
+      chunk->GetColumn(col).SetValue(row, group_bys[col]);
+    }
+    for (size_t col = 0; col < aggregates.size(); col++) {
+      chunk->GetColumn(group_bys.size() + col).SetValue(row, aggregates[col]);
+    }
+    ++aht_iterator_;
+  }
+  return !chunk->IsEmpty();
+}
+
 auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
 
 }  // namespace bustub
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bitmap_heap_scan_executor.cpp
+//
+// Identification: src/execution/bitmap_heap_scan_executor.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <optional>
+
+#include "execution/executors/bitmap_heap_scan_executor.h"
+
+namespace bustub {
+
+BitmapHeapScanExecutor::BitmapHeapScanExecutor(ExecutorContext *exec_ctx, const BitmapHeapScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      index_info_(exec_ctx_->GetCatalog()->GetIndex(plan_->GetIndexOid())),
+      tbl_heap_(exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid())->table_.get()),
+      locks_(exec_ctx, plan_->GetTableOid()) {}
+
+void BitmapHeapScanExecutor::Init() {
+  locks_.LockTable();
+  const auto *key_schema = index_info_->index_->GetKeySchema();
+  std::optional<Tuple> lower;
+  if (plan_->lower_bound_ != nullptr) {
+    lower.emplace(std::vector<Value>{plan_->lower_bound_->Evaluate(nullptr, *key_schema)}, key_schema);
+  }
+  std::optional<Tuple> upper;
+  if (plan_->upper_bound_ != nullptr) {
+    upper.emplace(std::vector<Value>{plan_->upper_bound_->Evaluate(nullptr, *key_schema)}, key_schema);
+  }
+
+  rids_.clear();
+  index_info_->index_->ScanRange(lower ? &*lower : nullptr, upper ? &*upper : nullptr, &rids_,
+                                 exec_ctx_->GetTransaction());
+  std::sort(rids_.begin(), rids_.end(), [](const RID &a, const RID &b) {
+    return a.GetPageId() != b.GetPageId() ? a.GetPageId() < b.GetPageId() : a.GetSlotNum() < b.GetSlotNum();
+  });
+  next_rid_ = 0;
+  tuples_.clear();
+  cursor_ = 0;
+}
+
+auto BitmapHeapScanExecutor::FetchNextPage() -> bool {
+  tuples_.clear();
+  cursor_ = 0;
+  if (next_rid_ == rids_.size()) {
+    locks_.UnlockTable();
+    return false;
+  }
+  size_t end = next_rid_;
+  while (end < rids_.size() && rids_[end].GetPageId() == rids_[next_rid_].GetPageId()) {
+    end++;
+  }
+  // all the rows of the page are locked before the page is read
+  std::vector<RID> page_rids(rids_.begin() + next_rid_, rids_.begin() + end);
+  for (const auto &rid : page_rids) {
+    locks_.LockRow(rid);
+  }
+  auto page_tuples = tbl_heap_->GetTuples(page_rids);
+  next_rid_ = end;
+  for (size_t i = 0; i < page_tuples.size(); i++) {
+    auto &[meta, tuple] = page_tuples[i];
+    locks_.UnlockRow(page_rids[i], meta.is_deleted_);
+    if (!meta.is_deleted_) {
+      tuples_.push_back(std::move(tuple));
+    }
+  }
+  return true;
+}
+
+auto BitmapHeapScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (cursor_ == tuples_.size()) {
+    if (!FetchNextPage()) {
+      return false;
+    }
+  }
+  *tuple = std::move(tuples_[cursor_++]);
+  *rid = tuple->GetRid();
+  return true;
+}
+
+}  // namespace bustub
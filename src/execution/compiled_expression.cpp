@@ -0,0 +1,311 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.cpp
+//
+// Identification: src/execution/compiled_expression.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/compiled_expression.h"
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <type_traits>
+
+#include "common/exception.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the NULL sentinel of the C++ type of a column */
+template <typename T>
+constexpr auto NullOf() -> T {
+  if constexpr (std::is_same_v<T, int8_t>) {
+    return BUSTUB_INT8_NULL;
+  } else if constexpr (std::is_same_v<T, int16_t>) {
+    return BUSTUB_INT16_NULL;
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return BUSTUB_INT32_NULL;
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return BUSTUB_INT64_NULL;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return BUSTUB_DECIMAL_NULL;
+  } else {
+    return BUSTUB_TIMESTAMP_NULL;
+  }
+}
+
+/** Call `func` with a null pointer of the C++ type of the fixed-size `type`, to instantiate a kernel for it. */
+template <typename Func>
+void DispatchType(TypeId type, Func &&func) {
+  switch (type) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      func(static_cast<int8_t *>(nullptr));
+      return;
+    case TypeId::SMALLINT:
+      func(static_cast<int16_t *>(nullptr));
+      return;
+    case TypeId::INTEGER:
+      func(static_cast<int32_t *>(nullptr));
+      return;
+    case TypeId::BIGINT:
+      func(static_cast<int64_t *>(nullptr));
+      return;
+    case TypeId::DECIMAL:
+      func(static_cast<double *>(nullptr));
+      return;
+    case TypeId::TIMESTAMP:
+      func(static_cast<uint64_t *>(nullptr));
+      return;
+    default:
+      throw Exception(ExceptionType::UNKNOWN_TYPE, "not a fixed-size type");
+  }
+}
+
+auto IsCompilable(TypeId type) -> bool {
+  switch (type) {
+    case TypeId::TINYINT:
+    case TypeId::SMALLINT:
+    case TypeId::INTEGER:
+    case TypeId::BIGINT:
+    case TypeId::DECIMAL:
+    case TypeId::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** Set the validity bitmap of the first `count` rows of a fixed-size column from the NULL sentinels in it. */
+template <typename T>
+void SetValidityFromNulls(ColumnVector *column, size_t count) {
+  const T *data = column->GetData<T>();
+  uint64_t *validity = column->GetValidity();
+  for (size_t base = 0; base < count; base += 64) {
+    size_t end = std::min<size_t>(64, count - base);
+    uint64_t word = 0;
+    for (size_t bit = 0; bit < end; bit++) {
+      word |= static_cast<uint64_t>(data[base + bit] != NullOf<T>()) << bit;
+    }
+    validity[base / 64] = word;
+  }
+}
+
+template <typename T, typename Op>
+void ArithmeticKernel(const T *lhs, const T *rhs, T *out, size_t count, Op op) {
+  for (size_t row = 0; row < count; row++) {
+    out[row] = lhs[row] == NullOf<T>() || rhs[row] == NullOf<T>() ? NullOf<T>() : op(lhs[row], rhs[row]);
+  }
+}
+
+template <typename T, typename Op>
+void CompareKernel(const T *lhs, const T *rhs, int8_t *out, size_t count, Op op) {
+  for (size_t row = 0; row < count; row++) {
+    out[row] = lhs[row] == NullOf<T>() || rhs[row] == NullOf<T>() ? BUSTUB_BOOLEAN_NULL
+                                                                  : static_cast<int8_t>(op(lhs[row], rhs[row]));
+  }
+}
+
+/** Integer addition and subtraction that wrap around on overflow rather than being undefined, as the rows that a
+ * filter dropped are computed too. */
+template <typename T>
+auto WrappingAdd(T lhs, T rhs) -> T {
+  if constexpr (std::is_integral_v<T>) {
+    return static_cast<T>(static_cast<std::make_unsigned_t<T>>(lhs) + static_cast<std::make_unsigned_t<T>>(rhs));
+  } else {
+    return lhs + rhs;
+  }
+}
+
+template <typename T>
+auto WrappingSubtract(T lhs, T rhs) -> T {
+  if constexpr (std::is_integral_v<T>) {
+    return static_cast<T>(static_cast<std::make_unsigned_t<T>>(lhs) - static_cast<std::make_unsigned_t<T>>(rhs));
+  } else {
+    return lhs - rhs;
+  }
+}
+
+}  // namespace
+
+CompiledExpression::CompiledExpression(const AbstractExpression &expr, const Schema &input_schema)
+    : kernels_(GetFilterKernels()) {
+  result_ = Compile(expr, input_schema);
+  result_type_ = result_.type_;
+}
+
+auto CompiledExpression::NewRegister(TypeId type) -> Operand {
+  registers_.emplace_back(type, BUSTUB_BATCH_SIZE);
+  return {false, static_cast<uint32_t>(registers_.size() - 1), type};
+}
+
+auto CompiledExpression::Compile(const AbstractExpression &expr, const Schema &input_schema) -> Operand {
+  if (const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(&expr); column_expr != nullptr) {
+    return {true, column_expr->GetColIdx(), input_schema.GetColumn(column_expr->GetColIdx()).GetType()};
+  }
+  if (const auto *const_expr = dynamic_cast<const ConstantValueExpression *>(&expr); const_expr != nullptr) {
+    auto reg = NewRegister(const_expr->val_.GetTypeId());
+    for (size_t row = 0; row < BUSTUB_BATCH_SIZE; row++) {
+      registers_[reg.index_].SetValue(row, const_expr->val_);
+    }
+    return reg;
+  }
+
+  std::optional<OpCode> op;
+  auto comp_type = ComparisonType::Equal;
+  if (const auto *arith_expr = dynamic_cast<const ArithmeticExpression *>(&expr); arith_expr != nullptr) {
+    op = arith_expr->compute_type_ == ArithmeticType::Plus ? OpCode::Add : OpCode::Subtract;
+  } else if (const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr); cmp_expr != nullptr) {
+    op = OpCode::Compare;
+    comp_type = cmp_expr->comp_type_;
+  } else if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(&expr); logic_expr != nullptr) {
+    op = logic_expr->logic_type_ == LogicType::And ? OpCode::And : OpCode::Or;
+  }
+
+  if (op.has_value()) {
+    // the instructions of the children are dropped again if the node turns out to be interpreted
+    size_t program_size = program_.size();
+    size_t register_count = registers_.size();
+    auto lhs = Compile(*expr.GetChildAt(0), input_schema);
+    auto rhs = Compile(*expr.GetChildAt(1), input_schema);
+    bool compiled = false;
+    switch (*op) {
+      case OpCode::Add:
+      case OpCode::Subtract:
+        compiled = lhs.type_ == TypeId::INTEGER && rhs.type_ == TypeId::INTEGER;
+        break;
+      case OpCode::And:
+      case OpCode::Or:
+        compiled = lhs.type_ == TypeId::BOOLEAN && rhs.type_ == TypeId::BOOLEAN;
+        break;
+      case OpCode::Compare:
+        compiled = lhs.type_ == rhs.type_ && IsCompilable(lhs.type_);
+        break;
+      case OpCode::Interpret:
+        break;
+    }
+    if (compiled) {
+      auto dest = NewRegister(expr.GetReturnType());
+      program_.push_back({*op, comp_type, dest.index_, lhs, rhs, &expr});
+      return dest;
+    }
+    program_.resize(program_size);
+    registers_.erase(registers_.begin() + register_count, registers_.end());
+  }
+
+  auto dest = NewRegister(expr.GetReturnType());
+  program_.push_back({OpCode::Interpret, comp_type, dest.index_, {}, {}, &expr});
+  return dest;
+}
+
+auto CompiledExpression::Evaluate(const DataChunk &chunk) -> const ColumnVector & {
+  for (const auto &instruction : program_) {
+    Execute(instruction, chunk);
+  }
+  return Resolve(chunk, result_);
+}
+
+void CompiledExpression::Execute(const Instruction &instruction, const DataChunk &chunk) {
+  auto &dest = registers_[instruction.dest_];
+  size_t count = chunk.Count();
+  if (instruction.op_ == OpCode::Interpret) {
+    for (size_t i = 0; i < chunk.Size(); i++) {
+      size_t row = chunk.RowAt(i);
+      dest.SetValue(row, instruction.expr_->EvaluateAt(chunk, row));
+    }
+    return;
+  }
+
+  // the kernels run over all the rows, selected or not, so that their loops have no indirection
+  const auto &lhs = Resolve(chunk, instruction.lhs_);
+  const auto &rhs = Resolve(chunk, instruction.rhs_);
+  switch (instruction.op_) {
+    case OpCode::Add:
+      ArithmeticKernel(lhs.GetData<int32_t>(), rhs.GetData<int32_t>(), dest.GetData<int32_t>(), count,
+                       WrappingAdd<int32_t>);
+      SetValidityFromNulls<int32_t>(&dest, count);
+      return;
+    case OpCode::Subtract:
+      ArithmeticKernel(lhs.GetData<int32_t>(), rhs.GetData<int32_t>(), dest.GetData<int32_t>(), count,
+                       WrappingSubtract<int32_t>);
+      SetValidityFromNulls<int32_t>(&dest, count);
+      return;
+    case OpCode::And:
+      kernels_.and_(lhs.GetData<int8_t>(), rhs.GetData<int8_t>(), dest.GetData<int8_t>(), count);
+      SetValidityFromNulls<int8_t>(&dest, count);
+      return;
+    case OpCode::Or:
+      kernels_.or_(lhs.GetData<int8_t>(), rhs.GetData<int8_t>(), dest.GetData<int8_t>(), count);
+      SetValidityFromNulls<int8_t>(&dest, count);
+      return;
+    case OpCode::Compare:
+      break;
+    case OpCode::Interpret:
+      UNREACHABLE("interpreted above");
+  }
+
+  auto *out = dest.GetData<int8_t>();
+  if (lhs.GetType() == TypeId::INTEGER) {
+    kernels_.compare_int32_(instruction.comp_type_, lhs.GetData<int32_t>(), rhs.GetData<int32_t>(), out, count);
+  } else if (lhs.GetType() == TypeId::BIGINT) {
+    kernels_.compare_int64_(instruction.comp_type_, lhs.GetData<int64_t>(), rhs.GetData<int64_t>(), out, count);
+  } else {
+    DispatchType(lhs.GetType(), [&](auto *tag) {
+      using T = std::remove_pointer_t<decltype(tag)>;
+      const T *left = lhs.GetData<T>();
+      const T *right = rhs.GetData<T>();
+      switch (instruction.comp_type_) {
+        case ComparisonType::Equal:
+          CompareKernel(left, right, out, count, std::equal_to<T>());
+          break;
+        case ComparisonType::NotEqual:
+          CompareKernel(left, right, out, count, std::not_equal_to<T>());
+          break;
+        case ComparisonType::LessThan:
+          CompareKernel(left, right, out, count, std::less<T>());
+          break;
+        case ComparisonType::LessThanOrEqual:
+          CompareKernel(left, right, out, count, std::less_equal<T>());
+          break;
+        case ComparisonType::GreaterThan:
+          CompareKernel(left, right, out, count, std::greater<T>());
+          break;
+        case ComparisonType::GreaterThanOrEqual:
+          CompareKernel(left, right, out, count, std::greater_equal<T>());
+          break;
+      }
+    });
+  }
+  SetValidityFromNulls<int8_t>(&dest, count);
+}
+
+void CompiledExpression::Filter(DataChunk *chunk) {
+  // a NULL is neither true nor false, its sentinel is not 1
+  const auto *keep = Evaluate(*chunk).GetData<int8_t>();
+  selected_.resize(chunk->Count());
+  size_t selected = 0;
+  if (chunk->Size() == chunk->Count()) {
+    // every row is selected, the positions are the rows
+    selected = kernels_.select_true_(keep, chunk->Count(), selected_.data());
+  } else {
+    for (size_t i = 0; i < chunk->Size(); i++) {
+      selected_[selected] = i;
+      selected += static_cast<size_t>(keep[chunk->RowAt(i)] == 1);
+    }
+  }
+  selected_.resize(selected);
+  chunk->Select(selected_);
+}
+
+}  // namespace bustub
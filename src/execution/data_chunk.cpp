@@ -0,0 +1,212 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// data_chunk.cpp
+//
+// Identification: src/execution/data_chunk.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/data_chunk.h"
+
+#include <cstring>
+
+#include "common/exception.h"
+#include "type/limits.h"
+#include "type/type.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+ColumnVector::ColumnVector(TypeId type, size_t capacity)
+    : type_(type), capacity_(capacity), width_(Type::GetTypeSize(type)), validity_((capacity + 63) / 64) {
+  if (type_ == TypeId::VARCHAR) {
+    strings_.resize(capacity);
+  } else {
+    data_.resize((capacity * width_ + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+  }
+}
+
+auto ColumnVector::GetValue(size_t row) const -> Value {
+  if (!IsValid(row)) {
+    return ValueFactory::GetNullValueByType(type_);
+  }
+  switch (type_) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      return {type_, GetData<int8_t>()[row]};
+    case TypeId::SMALLINT:
+      return {type_, GetData<int16_t>()[row]};
+    case TypeId::INTEGER:
+      return {type_, GetData<int32_t>()[row]};
+    case TypeId::BIGINT:
+      return {type_, GetData<int64_t>()[row]};
+    case TypeId::DECIMAL:
+      return {type_, GetData<double>()[row]};
+    case TypeId::TIMESTAMP:
+      return {type_, GetData<uint64_t>()[row]};
+    case TypeId::VARCHAR:
+      return {type_, strings_[row].data(), static_cast<uint32_t>(strings_[row].size()), true};
+    default:
+      break;
+  }
+  throw Exception(ExceptionType::UNKNOWN_TYPE, "Unknown type.");
+}
+
+void ColumnVector::SetValue(size_t row, const Value &value) {
+  bool valid = !value.IsNull();
+  SetValid(row, valid);
+  switch (type_) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      GetData<int8_t>()[row] = valid ? value.GetAs<int8_t>() : BUSTUB_INT8_NULL;
+      return;
+    case TypeId::SMALLINT:
+      GetData<int16_t>()[row] = valid ? value.GetAs<int16_t>() : BUSTUB_INT16_NULL;
+      return;
+    case TypeId::INTEGER:
+      GetData<int32_t>()[row] = valid ? value.GetAs<int32_t>() : BUSTUB_INT32_NULL;
+      return;
+    case TypeId::BIGINT:
+      GetData<int64_t>()[row] = valid ? value.GetAs<int64_t>() : BUSTUB_INT64_NULL;
+      return;
+    case TypeId::DECIMAL:
+      GetData<double>()[row] = valid ? value.GetAs<double>() : BUSTUB_DECIMAL_NULL;
+      return;
+    case TypeId::TIMESTAMP:
+      GetData<uint64_t>()[row] = valid ? value.GetAs<uint64_t>() : BUSTUB_TIMESTAMP_NULL;
+      return;
+    case TypeId::VARCHAR:
+      if (valid) {
+        strings_[row].assign(value.GetData(), value.GetLength());
+      } else {
+        strings_[row].clear();
+      }
+      return;
+    default:
+      break;
+  }
+  throw Exception(ExceptionType::UNKNOWN_TYPE, "Unknown type.");
+}
+
+void ColumnVector::CopyRow(size_t row, const ColumnVector &source, size_t source_row) {
+  SetValid(row, source.IsValid(source_row));
+  if (type_ == TypeId::VARCHAR) {
+    strings_[row] = source.strings_[source_row];
+    return;
+  }
+  memcpy(reinterpret_cast<char *>(data_.data()) + row * width_,
+         reinterpret_cast<const char *>(source.data_.data()) + source_row * width_, width_);
+}
+
+void ColumnVector::SetFromTuple(size_t row, const Tuple &tuple, const Column &column) {
+  const char *field = tuple.GetData() + column.GetOffset();
+  if (type_ == TypeId::VARCHAR) {
+    // a VARCHAR field holds the offset of the length and the bytes of the string
+    const char *varlen = tuple.GetData() + *reinterpret_cast<const uint32_t *>(field);
+    SetString(row, varlen + sizeof(uint32_t), *reinterpret_cast<const uint32_t *>(varlen));
+    return;
+  }
+  SetFromBytes(row, field);
+}
+
+void ColumnVector::SetString(size_t row, const char *data, uint32_t length) {
+  SetValid(row, length != BUSTUB_VALUE_NULL);
+  if (length == BUSTUB_VALUE_NULL) {
+    strings_[row].clear();
+  } else {
+    strings_[row].assign(data, length);
+  }
+}
+
+void ColumnVector::SetFromBytes(size_t row, const char *bytes) {
+  auto *dest = reinterpret_cast<char *>(data_.data()) + row * width_;
+  memcpy(dest, bytes, width_);
+  switch (type_) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      SetValid(row, GetData<int8_t>()[row] != BUSTUB_INT8_NULL);
+      return;
+    case TypeId::SMALLINT:
+      SetValid(row, GetData<int16_t>()[row] != BUSTUB_INT16_NULL);
+      return;
+    case TypeId::INTEGER:
+      SetValid(row, GetData<int32_t>()[row] != BUSTUB_INT32_NULL);
+      return;
+    case TypeId::BIGINT:
+      SetValid(row, GetData<int64_t>()[row] != BUSTUB_INT64_NULL);
+      return;
+    case TypeId::DECIMAL:
+      SetValid(row, GetData<double>()[row] != BUSTUB_DECIMAL_NULL);
+      return;
+    case TypeId::TIMESTAMP:
+      SetValid(row, GetData<uint64_t>()[row] != BUSTUB_TIMESTAMP_NULL);
+      return;
+    default:
+      break;
+  }
+  throw Exception(ExceptionType::UNKNOWN_TYPE, "Unknown type.");
+}
+
+void DataChunk::Reset(const Schema *schema) {
+  if (schema != schema_) {
+    schema_ = schema;
+    columns_.clear();
+    columns_.reserve(schema->GetColumnCount());
+    for (const auto &column : schema->GetColumns()) {
+      columns_.emplace_back(column.GetType(), BUSTUB_BATCH_SIZE);
+    }
+    rids_.resize(BUSTUB_BATCH_SIZE);
+  }
+  count_ = 0;
+  has_selection_ = false;
+  selection_.clear();
+}
+
+void DataChunk::Select(const std::vector<uint32_t> &positions) {
+  if (!has_selection_) {
+    selection_.assign(positions.begin(), positions.end());
+    has_selection_ = true;
+    return;
+  }
+  for (size_t i = 0; i < positions.size(); i++) {
+    selection_[i] = selection_[positions[i]];
+  }
+  selection_.resize(positions.size());
+}
+
+void DataChunk::Truncate(size_t size) {
+  if (size >= Size()) {
+    return;
+  }
+  if (has_selection_) {
+    selection_.resize(size);
+  } else {
+    count_ = size;
+  }
+}
+
+auto DataChunk::AppendRow(RID rid) -> size_t {
+  BUSTUB_ASSERT(!IsFull() && !has_selection_, "append to a full or filtered chunk");
+  rids_[count_] = rid;
+  return count_++;
+}
+
+void DataChunk::AppendTuple(const Tuple &tuple, RID rid) {
+  size_t row = AppendRow(rid);
+  for (size_t i = 0; i < columns_.size(); i++) {
+    columns_[i].SetFromTuple(row, tuple, schema_->GetColumn(i));
+  }
+}
+
+auto DataChunk::GetTuple(size_t row) const -> Tuple {
+  std::vector<Value> values;
+  values.reserve(columns_.size());
+  for (const auto &column : columns_) {
+    values.push_back(column.GetValue(row));
+  }
+  return {values, schema_};
+}
+
+}  // namespace bustub
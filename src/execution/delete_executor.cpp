@@ -49,9 +49,11 @@ auto DeleteExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
     table_write_record.wtype_ = WType::DELETE;
     exec_ctx_->GetTransaction()->AppendTableWriteRecord(table_write_record);
     for (const auto &indexs : table_index_) {
-      indexs->index_->DeleteEntry(
-          delete_tuple.KeyFromTuple(table_info_->schema_, indexs->key_schema_, indexs->index_->GetKeyAttrs()),
-          delete_rid, exec_ctx_->GetTransaction());
+      indexs->index_->DeleteEntry(delete_tuple.KeyFromTuple(table_info_->schema_, *indexs->index_->GetEntrySchema(),
+                                                            indexs->index_->GetEntryAttrs()),
+                                  delete_rid, exec_ctx_->GetTransaction());
+      exec_ctx_->GetTransaction()->AppendIndexWriteRecord(IndexWriteRecord(
+          delete_rid, table_info_->oid_, WType::DELETE, delete_tuple, indexs->index_oid_, exec_ctx_->GetCatalog()));
     }
     col++;
   }
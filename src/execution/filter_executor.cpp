@@ -6,7 +6,10 @@ namespace bustub {
 
 FilterExecutor::FilterExecutor(ExecutorContext *exec_ctx, const FilterPlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      predicate_(*plan_->GetPredicate(), child_executor_->GetOutputSchema()) {}
 
 void FilterExecutor::Init() {
   // Initialize the child executor
@@ -31,4 +34,15 @@ auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   }
 }
 
+auto FilterExecutor::NextBatch(DataChunk *chunk) -> bool {
+  // a child chunk may be filtered down to nothing, the filter is only done once its child is
+  while (child_executor_->NextBatch(chunk)) {
+    predicate_.Filter(chunk);
+    if (!chunk->IsEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace bustub
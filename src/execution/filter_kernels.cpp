@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// filter_kernels.cpp
+//
+// Identification: src/execution/filter_kernels.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/filter_kernels.h"
+
+#include <string_view>
+
+#include "common/macros.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+// Defined by filter_kernels_sse42.cpp and filter_kernels_avx2.cpp, which are compiled for their instruction set and
+// return nullptr if the build does not support it. Only call them once the CPU is known to support it.
+auto Sse42FilterKernels() -> const FilterKernels *;
+auto Avx2FilterKernels() -> const FilterKernels *;
+
+namespace {
+
+template <typename T>
+void CompareScalar(ComparisonType op, const T *lhs, const T *rhs, int8_t *out, size_t count, T null) {
+  auto compare = [&](auto cmp) {
+    for (size_t row = 0; row < count; row++) {
+      out[row] =
+          lhs[row] == null || rhs[row] == null ? BUSTUB_BOOLEAN_NULL : static_cast<int8_t>(cmp(lhs[row], rhs[row]));
+    }
+  };
+  switch (op) {
+    case ComparisonType::Equal:
+      compare([](T l, T r) { return l == r; });
+      return;
+    case ComparisonType::NotEqual:
+      compare([](T l, T r) { return l != r; });
+      return;
+    case ComparisonType::LessThan:
+      compare([](T l, T r) { return l < r; });
+      return;
+    case ComparisonType::LessThanOrEqual:
+      compare([](T l, T r) { return l <= r; });
+      return;
+    case ComparisonType::GreaterThan:
+      compare([](T l, T r) { return l > r; });
+      return;
+    case ComparisonType::GreaterThanOrEqual:
+      compare([](T l, T r) { return l >= r; });
+      return;
+  }
+  UNREACHABLE("Unsupported comparison type.");
+}
+
+void CompareInt32Scalar(ComparisonType op, const int32_t *lhs, const int32_t *rhs, int8_t *out, size_t count) {
+  CompareScalar(op, lhs, rhs, out, count, BUSTUB_INT32_NULL);
+}
+
+void CompareInt64Scalar(ComparisonType op, const int64_t *lhs, const int64_t *rhs, int8_t *out, size_t count) {
+  CompareScalar(op, lhs, rhs, out, count, BUSTUB_INT64_NULL);
+}
+
+/** false if either side is false, else NULL if either side is NULL */
+void AndScalar(const int8_t *lhs, const int8_t *rhs, int8_t *out, size_t count) {
+  for (size_t row = 0; row < count; row++) {
+    bool is_false = lhs[row] == 0 || rhs[row] == 0;
+    bool is_null = lhs[row] == BUSTUB_BOOLEAN_NULL || rhs[row] == BUSTUB_BOOLEAN_NULL;
+    out[row] = is_false ? 0 : (is_null ? BUSTUB_BOOLEAN_NULL : 1);
+  }
+}
+
+/** true if either side is true, else NULL if either side is NULL */
+void OrScalar(const int8_t *lhs, const int8_t *rhs, int8_t *out, size_t count) {
+  for (size_t row = 0; row < count; row++) {
+    bool is_true = lhs[row] == 1 || rhs[row] == 1;
+    bool is_null = lhs[row] == BUSTUB_BOOLEAN_NULL || rhs[row] == BUSTUB_BOOLEAN_NULL;
+    out[row] = is_true ? 1 : (is_null ? BUSTUB_BOOLEAN_NULL : 0);
+  }
+}
+
+auto SelectTrueScalar(const int8_t *keep, size_t count, uint32_t *positions) -> size_t {
+  size_t selected = 0;
+  for (size_t row = 0; row < count; row++) {
+    // write every row and only advance past the kept ones, so that there is no branch to mispredict
+    positions[selected] = row;
+    selected += static_cast<size_t>(keep[row] == 1);
+  }
+  return selected;
+}
+
+const FilterKernels SCALAR_FILTER_KERNELS{"scalar",  CompareInt32Scalar, CompareInt64Scalar,
+                                          AndScalar, OrScalar,           SelectTrueScalar};
+
+auto CpuSupports(const char *isa) -> bool {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if (std::string_view(isa) == "avx2") {
+    return __builtin_cpu_supports("avx2") != 0;
+  }
+  if (std::string_view(isa) == "sse4.2") {
+    return __builtin_cpu_supports("sse4.2") != 0;
+  }
+#endif
+  return false;
+}
+
+auto PickFilterKernels() -> const FilterKernels & {
+  if (const auto *kernels = GetAvx2FilterKernels(); kernels != nullptr) {
+    return *kernels;
+  }
+  if (const auto *kernels = GetSse42FilterKernels(); kernels != nullptr) {
+    return *kernels;
+  }
+  return SCALAR_FILTER_KERNELS;
+}
+
+}  // namespace
+
+auto GetFilterKernels() -> const FilterKernels & {
+  static const FilterKernels &kernels = PickFilterKernels();
+  return kernels;
+}
+
+auto GetScalarFilterKernels() -> const FilterKernels * { return &SCALAR_FILTER_KERNELS; }
+
+auto GetSse42FilterKernels() -> const FilterKernels * {
+  return CpuSupports("sse4.2") ? Sse42FilterKernels() : nullptr;
+}
+
+auto GetAvx2FilterKernels() -> const FilterKernels * { return CpuSupports("avx2") ? Avx2FilterKernels() : nullptr; }
+
+}  // namespace bustub
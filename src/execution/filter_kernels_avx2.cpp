@@ -0,0 +1,207 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// filter_kernels_avx2.cpp
+//
+// Identification: src/execution/filter_kernels_avx2.cpp
+//
+// The filter kernels for AVX2. This file is compiled with -mavx2; GetFilterKernels() only hands them out when the CPU
+// supports AVX2.
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/filter_kernels.h"
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+#include <array>
+#include <cstring>
+
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+/** SPREAD[bits] has byte i set to 1 if bit i of `bits` is set, to turn the mask of 8 rows into 8 booleans. */
+constexpr auto MakeSpread() -> std::array<uint64_t, 256> {
+  std::array<uint64_t, 256> spread{};
+  for (uint32_t bits = 0; bits < 256; bits++) {
+    for (uint32_t i = 0; i < 8; i++) {
+      if ((bits >> i) & 1) {
+        spread[bits] |= uint64_t{1} << (i * 8);
+      }
+    }
+  }
+  return spread;
+}
+
+constexpr std::array<uint64_t, 256> SPREAD = MakeSpread();
+
+/** Store the booleans of 8 rows: 1 where `bits` is set, NULL where `nulls` is set and 0 elsewhere. */
+inline void StoreBooleans(int8_t *out, uint32_t bits, uint32_t nulls) {
+  uint64_t booleans = SPREAD[bits & ~nulls & 0xFF] | SPREAD[nulls] * static_cast<uint8_t>(BUSTUB_BOOLEAN_NULL);
+  memcpy(out, &booleans, sizeof(booleans));
+}
+
+inline auto Mask32(__m256i mask) -> uint32_t { return _mm256_movemask_ps(_mm256_castsi256_ps(mask)); }
+inline auto Mask64(__m256i mask) -> uint32_t { return _mm256_movemask_pd(_mm256_castsi256_pd(mask)); }
+
+inline auto Load(const void *data) -> __m256i { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data)); }
+
+/** Compare 8 rows, setting the bits of the rows where lhs == rhs, where lhs > rhs and where either side is NULL. */
+inline void Compare8(const int32_t *lhs, const int32_t *rhs, uint32_t *eq, uint32_t *gt, uint32_t *nulls) {
+  const __m256i null = _mm256_set1_epi32(BUSTUB_INT32_NULL);
+  __m256i l = Load(lhs);
+  __m256i r = Load(rhs);
+  *eq = Mask32(_mm256_cmpeq_epi32(l, r));
+  *gt = Mask32(_mm256_cmpgt_epi32(l, r));
+  *nulls = Mask32(_mm256_or_si256(_mm256_cmpeq_epi32(l, null), _mm256_cmpeq_epi32(r, null)));
+}
+
+inline void Compare8(const int64_t *lhs, const int64_t *rhs, uint32_t *eq, uint32_t *gt, uint32_t *nulls) {
+  const __m256i null = _mm256_set1_epi64x(BUSTUB_INT64_NULL);
+  *eq = 0;
+  *gt = 0;
+  *nulls = 0;
+  for (uint32_t half = 0; half < 2; half++) {
+    __m256i l = Load(lhs + half * 4);
+    __m256i r = Load(rhs + half * 4);
+    *eq |= Mask64(_mm256_cmpeq_epi64(l, r)) << (half * 4);
+    *gt |= Mask64(_mm256_cmpgt_epi64(l, r)) << (half * 4);
+    *nulls |= Mask64(_mm256_or_si256(_mm256_cmpeq_epi64(l, null), _mm256_cmpeq_epi64(r, null))) << (half * 4);
+  }
+}
+
+template <ComparisonType Op>
+constexpr auto Combine(uint32_t eq, uint32_t gt) -> uint32_t {
+  switch (Op) {
+    case ComparisonType::Equal:
+      return eq;
+    case ComparisonType::NotEqual:
+      return ~eq;
+    case ComparisonType::LessThan:
+      return ~(eq | gt);
+    case ComparisonType::LessThanOrEqual:
+      return ~gt;
+    case ComparisonType::GreaterThan:
+      return gt;
+    case ComparisonType::GreaterThanOrEqual:
+      return eq | gt;
+  }
+  return 0;
+}
+
+template <ComparisonType Op, typename T>
+void CompareOp(const T *lhs, const T *rhs, int8_t *out, size_t count) {
+  size_t row = 0;
+  for (; row + 8 <= count; row += 8) {
+    uint32_t eq;
+    uint32_t gt;
+    uint32_t nulls;
+    Compare8(lhs + row, rhs + row, &eq, &gt, &nulls);
+    StoreBooleans(out + row, Combine<Op>(eq, gt), nulls);
+  }
+  if constexpr (sizeof(T) == sizeof(int32_t)) {
+    GetScalarFilterKernels()->compare_int32_(Op, lhs + row, rhs + row, out + row, count - row);
+  } else {
+    GetScalarFilterKernels()->compare_int64_(Op, lhs + row, rhs + row, out + row, count - row);
+  }
+}
+
+template <typename T>
+void Compare(ComparisonType op, const T *lhs, const T *rhs, int8_t *out, size_t count) {
+  switch (op) {
+    case ComparisonType::Equal:
+      return CompareOp<ComparisonType::Equal>(lhs, rhs, out, count);
+    case ComparisonType::NotEqual:
+      return CompareOp<ComparisonType::NotEqual>(lhs, rhs, out, count);
+    case ComparisonType::LessThan:
+      return CompareOp<ComparisonType::LessThan>(lhs, rhs, out, count);
+    case ComparisonType::LessThanOrEqual:
+      return CompareOp<ComparisonType::LessThanOrEqual>(lhs, rhs, out, count);
+    case ComparisonType::GreaterThan:
+      return CompareOp<ComparisonType::GreaterThan>(lhs, rhs, out, count);
+    case ComparisonType::GreaterThanOrEqual:
+      return CompareOp<ComparisonType::GreaterThanOrEqual>(lhs, rhs, out, count);
+  }
+}
+
+void CompareInt32(ComparisonType op, const int32_t *lhs, const int32_t *rhs, int8_t *out, size_t count) {
+  Compare(op, lhs, rhs, out, count);
+}
+
+void CompareInt64(ComparisonType op, const int64_t *lhs, const int64_t *rhs, int8_t *out, size_t count) {
+  Compare(op, lhs, rhs, out, count);
+}
+
+void And(const int8_t *lhs, const int8_t *rhs, int8_t *out, size_t count) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi8(1);
+  const __m256i null = _mm256_set1_epi8(BUSTUB_BOOLEAN_NULL);
+  size_t row = 0;
+  for (; row + 32 <= count; row += 32) {
+    __m256i l = Load(lhs + row);
+    __m256i r = Load(rhs + row);
+    __m256i is_false = _mm256_or_si256(_mm256_cmpeq_epi8(l, zero), _mm256_cmpeq_epi8(r, zero));
+    __m256i is_null = _mm256_or_si256(_mm256_cmpeq_epi8(l, null), _mm256_cmpeq_epi8(r, null));
+    __m256i result = _mm256_andnot_si256(is_false, _mm256_blendv_epi8(one, null, is_null));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + row), result);
+  }
+  GetScalarFilterKernels()->and_(lhs + row, rhs + row, out + row, count - row);
+}
+
+void Or(const int8_t *lhs, const int8_t *rhs, int8_t *out, size_t count) {
+  const __m256i one = _mm256_set1_epi8(1);
+  const __m256i null = _mm256_set1_epi8(BUSTUB_BOOLEAN_NULL);
+  size_t row = 0;
+  for (; row + 32 <= count; row += 32) {
+    __m256i l = Load(lhs + row);
+    __m256i r = Load(rhs + row);
+    __m256i is_true = _mm256_or_si256(_mm256_cmpeq_epi8(l, one), _mm256_cmpeq_epi8(r, one));
+    __m256i is_null = _mm256_or_si256(_mm256_cmpeq_epi8(l, null), _mm256_cmpeq_epi8(r, null));
+    __m256i result =
+        _mm256_or_si256(_mm256_and_si256(is_true, one), _mm256_andnot_si256(is_true, _mm256_and_si256(is_null, null)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + row), result);
+  }
+  GetScalarFilterKernels()->or_(lhs + row, rhs + row, out + row, count - row);
+}
+
+auto SelectTrue(const int8_t *keep, size_t count, uint32_t *positions) -> size_t {
+  const __m256i one = _mm256_set1_epi8(1);
+  size_t selected = 0;
+  size_t row = 0;
+  for (; row + 32 <= count; row += 32) {
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Load(keep + row), one)));
+    while (mask != 0) {
+      positions[selected++] = row + __builtin_ctz(mask);
+      mask &= mask - 1;
+    }
+  }
+  size_t tail = GetScalarFilterKernels()->select_true_(keep + row, count - row, positions + selected);
+  for (size_t i = selected; i < selected + tail; i++) {
+    positions[i] += row;
+  }
+  return selected + tail;
+}
+
+const FilterKernels AVX2_FILTER_KERNELS{"avx2", CompareInt32, CompareInt64, And, Or, SelectTrue};
+
+}  // namespace
+
+auto Avx2FilterKernels() -> const FilterKernels * { return &AVX2_FILTER_KERNELS; }
+
+}  // namespace bustub
+
+#else
+
+namespace bustub {
+
+auto Avx2FilterKernels() -> const FilterKernels * { return nullptr; }
+
+}  // namespace bustub
+
+#endif
@@ -26,88 +26,331 @@ HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlan
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
+  std::vector<TypeId> left_key_types;
+  std::vector<TypeId> right_key_types;
+  for (const auto &expr : plan_->LeftJoinKeyExpressions()) {
+    left_key_exprs_.emplace_back(*expr, left_child_->GetOutputSchema());
+    left_key_types.push_back(left_key_exprs_.back().GetReturnType());
+  }
+  for (const auto &expr : plan_->RightJoinKeyExpressions()) {
+    right_key_exprs_.emplace_back(*expr, right_child_->GetOutputSchema());
+    right_key_types.push_back(right_key_exprs_.back().GetReturnType());
+  }
+  jht_.emplace(right_child_->GetOutputSchema(), right_key_types, left_key_types);
+  left_rows_.emplace(left_child_->GetOutputSchema(), left_key_types, right_key_types,
+                     plan->GetJoinType() == JoinType::LEFT);
+  // a left join outputs every left row, so only an inner join may drop the left rows that match nothing
+  if (plan->GetJoinType() == JoinType::INNER) {
+    runtime_filter_.emplace(exec_ctx_, &*jht_, plan_->LeftJoinKeyExpressions(), left_child_->GetOutputSchema());
+    if (!left_child_->SetRuntimeFilter(&*runtime_filter_)) {
+      runtime_filter_.reset();
+    }
+  }
 }
 
 void HashJoinExecutor::Init() {
   left_child_->Init();
   right_child_->Init();
-  Tuple tuple;
-  RID rid;
-  while (true) {
-    // Get the next tuple
-    const auto status = right_child_->Next(&tuple, &rid);
-    if (!status) {
+  jht_->Clear();
+  spilled_ = false;
+  partitions_.clear();
+  current_.reset();
+  tmp_files_.reset();
+  if (runtime_filter_.has_value()) {
+    runtime_filter_->Clear();
+  }
+  DataChunk chunk;
+  std::vector<const ColumnVector *> keys;
+  while (right_child_->NextBatch(&chunk)) {
+    EvaluateKeys(&right_key_exprs_, chunk, &keys);
+    jht_->Append(chunk, keys);
+    if (jht_->GetMemoryUsage() > exec_ctx_->GetHashJoinMemoryBudget()) {
+      SpillInputs();
       break;
     }
-    HashJoinKey hash_join_key = MakeRightHashJoinKey(&tuple);
-    hjt_.InsertCombine(hash_join_key, tuple);
   }
-  have_found_ = false;
-  index_ = 0;
-  hash_join_key_ = HashJoinKey();
+  if (!spilled_) {
+    BuildHashTable();
+    BuildRuntimeFilter();
+  }
+  left_chunk_.Reset(&left_child_->GetOutputSchema());
+  left_pos_ = 0;
+  match_ = JoinHashTable::NONE;
+  left_rows_->Clear();
+  probing_partitions_ = false;
+  out_chunk_.Reset(&GetOutputSchema());
+  out_pos_ = 0;
 }
 
 auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (have_found_) {
-    if (!hjt_.IfEnd(hash_join_key_, index_)) {
-      index_++;
-      auto right_tuple = hjt_.FindValue(hash_join_key_, index_);
-      std::vector<Value> values;
-      for (uint32_t i = 0; i < left_child_->GetOutputSchema().GetColumnCount(); i++) {
-        values.emplace_back(left_tuple_.GetValue(&left_child_->GetOutputSchema(), i));
+  if (out_pos_ == out_chunk_.Size()) {
+    out_pos_ = 0;
+    if (!NextBatch(&out_chunk_)) {
+      return false;
+    }
+  }
+  *tuple = out_chunk_.GetTuple(out_chunk_.RowAt(out_pos_++));
+  return true;
+}
+
+auto HashJoinExecutor::NextBatch(DataChunk *chunk) -> bool {
+  chunk->Reset(&GetOutputSchema());
+  while (!chunk->IsFull()) {
+    // finish the matches of the current left row before moving on
+    if (match_ != JoinHashTable::NONE) {
+      AppendJoinRow(chunk, match_);
+      match_ = jht_->Next(match_);
+      continue;
+    }
+    if (probing_partitions_) {
+      if (probe_entry_ == left_rows_->GetPartitionEnd(probe_partition_)) {
+        if (++probe_partition_ == left_rows_->GetPartitionCount()) {
+          probing_partitions_ = false;
+        } else {
+          probe_entry_ = left_rows_->GetPartitionBegin(probe_partition_);
+        }
+        continue;
       }
-      // 连接操作右边元组的值均不为null的情况下
-      for (uint32_t i = 0; i < right_child_->GetOutputSchema().GetColumnCount(); i++) {
-        values.emplace_back(right_tuple.GetValue(&right_child_->GetOutputSchema(), i));
+      left_entry_ = probe_entry_;
+      probe_entry_ = left_rows_->RowAfter(probe_entry_);
+      match_ = jht_->Find(*left_rows_, left_entry_);
+    } else {
+      if (left_pos_ == left_chunk_.Size()) {
+        left_pos_ = 0;
+        if (!NextLeftChunk()) {
+          break;
+        }
+        if (jht_->GetPartitionCount() > 1) {
+          StartPartitionedProbe();
+          continue;
+        }
+        EvaluateKeys(&left_key_exprs_, left_chunk_, &left_keys_);
+        jht_->FindBatch(left_chunk_, left_keys_, &left_matches_);
       }
-      *tuple = {values, &GetOutputSchema()};
-      return true;
+      left_row_ = left_chunk_.RowAt(left_pos_);
+      match_ = left_matches_[left_pos_++];
+    }
+    if (match_ == JoinHashTable::NONE && plan_->GetJoinType() == JoinType::LEFT) {
+      AppendJoinRow(chunk, JoinHashTable::NONE);
     }
   }
-  Tuple left_tuple;
-  RID left_rid;
-  have_found_ = false;
-  index_ = 0;
-  hash_join_key_ = HashJoinKey();
-  while (true) {
-    const auto status = left_child_->Next(&left_tuple, &left_rid);
-    if (!status) {
-      return false;
+  return !chunk->IsEmpty();
+}
+
+auto HashJoinExecutor::ReadChunk(TmpTupleFile *file, const Schema *schema, DataChunk *chunk) -> bool {
+  chunk->Reset(schema);
+  Tuple tuple;
+  while (!chunk->IsFull() && file->Next(&tuple)) {
+    chunk->AppendTuple(tuple, RID{});
+  }
+  return !chunk->IsEmpty();
+}
+
+auto HashJoinExecutor::MakePartitions(size_t depth) -> std::vector<SpillPartition> {
+  if (tmp_files_ == nullptr) {
+    tmp_files_ = std::make_unique<TmpFileManager>();
+  }
+  std::vector<SpillPartition> partitions;
+  for (size_t i = 0; i < SPILL_FANOUT; i++) {
+    partitions.push_back(
+        {std::make_unique<TmpTupleFile>(tmp_files_.get()), std::make_unique<TmpTupleFile>(tmp_files_.get()), depth});
+  }
+  exec_ctx_->AddHashJoinSpilledPartitions(SPILL_FANOUT);
+  return partitions;
+}
+
+void HashJoinExecutor::SpillChunk(const DataChunk &chunk, const std::vector<const ColumnVector *> &keys, bool is_left,
+                                  size_t depth, std::vector<SpillPartition> *partitions) {
+  for (size_t i = 0; i < chunk.Size(); i++) {
+    size_t row = chunk.RowAt(i);
+    bool has_null_key = false;
+    for (const auto *key : keys) {
+      has_null_key |= !key->IsValid(row);
     }
-    HashJoinKey hash_join_key = MakeLeftHashJoinKey(&left_tuple);
-    if (hjt_.Find(hash_join_key) != hjt_.End()) {
-      auto right_tuple = hjt_.FindValue(hash_join_key, 0);
-      std::vector<Value> values;
-      for (uint32_t i = 0; i < left_child_->GetOutputSchema().GetColumnCount(); i++) {
-        values.emplace_back(left_tuple.GetValue(&left_child_->GetOutputSchema(), i));
-      }
-      // 连接操作右边元组的值均不为null的情况下
-      for (uint32_t i = 0; i < right_child_->GetOutputSchema().GetColumnCount(); i++) {
-        values.emplace_back(right_tuple.GetValue(&right_child_->GetOutputSchema(), i));
+    size_t partition = 0;
+    if (has_null_key) {
+      // such a row joins nothing: only the left rows of a left join are output, and any partition will do for them
+      if (!is_left || plan_->GetJoinType() != JoinType::LEFT) {
+        continue;
       }
-      *tuple = {values, &GetOutputSchema()};
-      have_found_ = true;
-      index_ = 0;
-      hash_join_key_ = hash_join_key;
-      left_tuple_ = left_tuple;
+    } else {
+      partition = PartitionOf(jht_->Hash(keys, row), depth);
+    }
+    auto tuple = chunk.GetTuple(row);
+    auto &pair = (*partitions)[partition];
+    (is_left ? pair.left_ : pair.right_)->Append(tuple);
+    exec_ctx_->AddHashJoinSpilledBytes(tuple.GetLength());
+  }
+}
+
+void HashJoinExecutor::SpillInputs() {
+  spilled_ = true;
+  auto partitions = MakePartitions(0);
+  DataChunk chunk;
+  std::vector<const ColumnVector *> keys;
+  uint64_t cursor = 0;
+  while (jht_->ScanRows(&cursor, &chunk)) {
+    EvaluateKeys(&right_key_exprs_, chunk, &keys);
+    SpillChunk(chunk, keys, false, 0, &partitions);
+  }
+  jht_->Clear();
+  while (right_child_->NextBatch(&chunk)) {
+    EvaluateKeys(&right_key_exprs_, chunk, &keys);
+    SpillChunk(chunk, keys, false, 0, &partitions);
+  }
+  BuildRuntimeFilter(&partitions);
+  while (left_child_->NextBatch(&chunk)) {
+    EvaluateKeys(&left_key_exprs_, chunk, &keys);
+    SpillChunk(chunk, keys, true, 0, &partitions);
+  }
+  for (auto &partition : partitions) {
+    partitions_.push_back(std::move(partition));
+  }
+}
+
+auto HashJoinExecutor::LoadPartition(SpillPartition *partition) -> bool {
+  jht_->Clear();
+  DataChunk chunk;
+  std::vector<const ColumnVector *> keys;
+  partition->right_->Rewind();
+  while (ReadChunk(partition->right_.get(), &right_child_->GetOutputSchema(), &chunk)) {
+    EvaluateKeys(&right_key_exprs_, chunk, &keys);
+    jht_->Append(chunk, keys);
+    if (jht_->GetMemoryUsage() > exec_ctx_->GetHashJoinMemoryBudget() && partition->depth_ < MAX_SPILL_DEPTH) {
+      jht_->Clear();
+      Repartition(partition);
+      return false;
+    }
+  }
+  BuildHashTable();
+  partition->left_->Rewind();
+  return true;
+}
+
+void HashJoinExecutor::Repartition(SpillPartition *partition) {
+  size_t depth = partition->depth_ + 1;
+  exec_ctx_->AddHashJoinRepartitions(1);
+  auto children = MakePartitions(depth);
+  DataChunk chunk;
+  std::vector<const ColumnVector *> keys;
+  partition->right_->Rewind();
+  while (ReadChunk(partition->right_.get(), &right_child_->GetOutputSchema(), &chunk)) {
+    EvaluateKeys(&right_key_exprs_, chunk, &keys);
+    SpillChunk(chunk, keys, false, depth, &children);
+  }
+  partition->left_->Rewind();
+  while (ReadChunk(partition->left_.get(), &left_child_->GetOutputSchema(), &chunk)) {
+    EvaluateKeys(&left_key_exprs_, chunk, &keys);
+    SpillChunk(chunk, keys, true, depth, &children);
+  }
+  for (auto &child : children) {
+    // the rows of one key, or of one hash, never split: a partition that did not shrink is joined as it is
+    if (child.right_->GetTupleCount() == partition->right_->GetTupleCount()) {
+      child.depth_ = MAX_SPILL_DEPTH;
+    }
+    partitions_.push_back(std::move(child));
+  }
+}
+
+auto HashJoinExecutor::ReadLeftChunk() -> bool {
+  if (!spilled_) {
+    return left_child_->NextBatch(&left_chunk_);
+  }
+  return current_.has_value() && ReadChunk(current_->left_.get(), &left_child_->GetOutputSchema(), &left_chunk_);
+}
+
+auto HashJoinExecutor::NextLeftChunk() -> bool {
+  while (true) {
+    if (ReadLeftChunk()) {
       return true;
     }
-    if (plan_->GetJoinType() == JoinType::LEFT) {
-      break;
+    current_.reset();
+    if (!spilled_ || partitions_.empty()) {
+      tmp_files_.reset();
+      return false;
+    }
+    auto partition = std::move(partitions_.back());
+    partitions_.pop_back();
+    if (partition.left_->GetTupleCount() == 0 ||
+        (partition.right_->GetTupleCount() == 0 && plan_->GetJoinType() == JoinType::INNER)) {
+      continue;
     }
+    if (LoadPartition(&partition)) {
+      current_ = std::move(partition);
+    }
+  }
+}
+
+void HashJoinExecutor::BuildHashTable() {
+  jht_->Build(JoinHashTable::PartitionBitsFor(jht_->GetMemoryUsage(), exec_ctx_->GetHashJoinCacheSize()));
+}
+
+void HashJoinExecutor::BuildRuntimeFilter() {
+  if (!runtime_filter_.has_value()) {
+    return;
+  }
+  runtime_filter_->Start(jht_->GetRowCount());
+  jht_->ForEachHash([this](hash_t hash) { runtime_filter_->Insert(hash); });
+  runtime_filter_->Finish();
+}
+
+void HashJoinExecutor::BuildRuntimeFilter(std::vector<SpillPartition> *partitions) {
+  if (!runtime_filter_.has_value()) {
+    return;
   }
-  if (plan_->GetJoinType() == JoinType::LEFT) {
-    std::vector<Value> values;
-    for (uint32_t i = 0; i < left_child_->GetOutputSchema().GetColumnCount(); i++) {
-      values.emplace_back(left_tuple.GetValue(&left_child_->GetOutputSchema(), i));
+  // the right rows with a NULL key were not spilled, and the others are read back to be hashed
+  size_t row_count = 0;
+  for (const auto &partition : *partitions) {
+    row_count += partition.right_->GetTupleCount();
+  }
+  runtime_filter_->Start(row_count);
+  DataChunk chunk;
+  std::vector<const ColumnVector *> keys;
+  for (auto &partition : *partitions) {
+    partition.right_->Rewind();
+    while (ReadChunk(partition.right_.get(), &right_child_->GetOutputSchema(), &chunk)) {
+      EvaluateKeys(&right_key_exprs_, chunk, &keys);
+      for (size_t i = 0; i < chunk.Size(); i++) {
+        runtime_filter_->Insert(jht_->Hash(keys, chunk.RowAt(i)));
+      }
     }
-    for (const Column &col : right_child_->GetOutputSchema().GetColumns()) {
-      values.emplace_back(ValueFactory::GetNullValueByType(col.GetType()));
+  }
+  runtime_filter_->Finish();
+}
+
+void HashJoinExecutor::StartPartitionedProbe() {
+  left_rows_->Clear();
+  std::vector<const ColumnVector *> keys;
+  do {
+    EvaluateKeys(&left_key_exprs_, left_chunk_, &keys);
+    left_rows_->Append(left_chunk_, keys);
+  } while (left_rows_->GetMemoryUsage() < exec_ctx_->GetHashJoinMemoryBudget() && ReadLeftChunk());
+  left_chunk_.Reset(&left_child_->GetOutputSchema());
+  left_rows_->Partition(jht_->GetPartitionBits());
+  probing_partitions_ = true;
+  probe_partition_ = 0;
+  probe_entry_ = left_rows_->GetPartitionBegin(0);
+}
+
+void HashJoinExecutor::AppendJoinRow(DataChunk *chunk, uint64_t entry) const {
+  const auto left_count = left_child_->GetOutputSchema().GetColumnCount();
+  const auto &right_schema = right_child_->GetOutputSchema();
+  size_t row = chunk->AppendRow(RID{});
+  if (probing_partitions_) {
+    left_rows_->CopyRow(left_entry_, chunk, row, 0);
+  } else {
+    for (uint32_t i = 0; i < left_count; i++) {
+      chunk->GetColumn(i).CopyRow(row, left_chunk_.GetColumn(i), left_row_);
     }
-    *tuple = {values, &GetOutputSchema()};
-    return true;
   }
-  return false;
+  if (entry != JoinHashTable::NONE) {
+    jht_->CopyRow(entry, chunk, row, left_count);
+    return;
+  }
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    chunk->GetColumn(left_count + i)
+        .SetValue(row, ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType()));
+  }
 }
 
 }  // namespace bustub
@@ -11,35 +11,183 @@
 //===----------------------------------------------------------------------===//
 #include "execution/executors/index_scan_executor.h"
 
+#include <algorithm>
+#include <optional>
+
+#include "common/exception.h"
+#include "storage/index/key_encoder.h"
+#include "type/value_factory.h"
+
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
     : AbstractExecutor(exec_ctx),
       plan_(plan),
       index_info_(exec_ctx_->GetCatalog()->GetIndex(plan_->GetIndexOid())),
       tbl_heap_(exec_ctx_->GetCatalog()->GetTable(index_info_->table_name_)->table_.get()),
-      tree_(dynamic_cast<BPlusTreeIndexForTwoIntegerColumn *>(index_info_->index_.get())),
-      it_(tree_->GetBeginIterator()) {}
-
-void IndexScanExecutor::Init() { it_ = tree_->GetBeginIterator(); }
+      locks_(exec_ctx, exec_ctx_->GetCatalog()->GetTable(index_info_->table_name_)->oid_) {}
 
-auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (it_.IsEnd()) {
+template <size_t KeySize>
+auto IndexScanExecutor::InitIterator() -> bool {
+  auto *tree = dynamic_cast<BPlusTreeIndex<GenericKey<KeySize>, RID, GenericComparator<KeySize>> *>(
+      index_info_->index_.get());
+  if (tree == nullptr) {
     return false;
   }
-  auto current_rid = (*it_).second;
-  auto tuple_meta = tbl_heap_->GetTuple(current_rid).first;
-  while (tuple_meta.is_deleted_) {
-    ++it_;
-    if (it_.IsEnd()) {
+  auto it = plan_->IsReverse() ? tree->GetReverseBeginIterator() : tree->GetBeginIterator();
+  const Schema *entry_schema = tree->GetEntrySchema();
+  next_entry_ = [it = std::move(it), entry_schema](RID *rid, std::vector<Value> *entry) mutable {
+    if (it.IsEnd()) {
       return false;
     }
-    current_rid = (*it_).second;
-    tuple_meta = tbl_heap_->GetTuple(current_rid).first;
+    *rid = (*it).second;
+    if (entry != nullptr) {
+      *entry = KeyEncoder::Decode((*it).first.data_, *entry_schema);
+    }
+    ++it;
+    return true;
+  };
+  return true;
+}
+
+void IndexScanExecutor::InitRange() {
+  const auto *key_schema = index_info_->index_->GetKeySchema();
+  std::optional<Tuple> lower;
+  if (plan_->lower_bound_ != nullptr) {
+    lower.emplace(std::vector<Value>{plan_->lower_bound_->Evaluate(nullptr, *key_schema)}, key_schema);
+  }
+  std::optional<Tuple> upper;
+  if (plan_->upper_bound_ != nullptr) {
+    upper.emplace(std::vector<Value>{plan_->upper_bound_->Evaluate(nullptr, *key_schema)}, key_schema);
+  }
+
+  // the RIDs are collected up front, so the scan does not see the entries its parent inserts
+  std::vector<RID> rids;
+  std::vector<std::vector<Value>> entries;
+  const Tuple *lower_key = lower ? &*lower : nullptr;
+  const Tuple *upper_key = upper ? &*upper : nullptr;
+  if (filter_entry_columns_.empty() || (!ScanRangeEntries<8>(lower_key, upper_key, &rids, &entries) &&
+                                        !ScanRangeEntries<16>(lower_key, upper_key, &rids, &entries) &&
+                                        !ScanRangeEntries<32>(lower_key, upper_key, &rids, &entries) &&
+                                        !ScanRangeEntries<64>(lower_key, upper_key, &rids, &entries) &&
+                                        !ScanRangeEntries<4>(lower_key, upper_key, &rids, &entries))) {
+    // only the entries of a B+ tree are decoded, the runtime filter reads the fetched tuples otherwise
+    filter_entry_columns_.clear();
+    index_info_->index_->ScanRange(lower_key, upper_key, &rids, exec_ctx_->GetTransaction());
+  }
+  if (plan_->IsReverse()) {
+    std::reverse(rids.begin(), rids.end());
+    std::reverse(entries.begin(), entries.end());
+  }
+  next_entry_ = [rids = std::move(rids), entries = std::move(entries), cursor = size_t{0}](
+                    RID *rid, std::vector<Value> *entry) mutable {
+    if (cursor == rids.size()) {
+      return false;
+    }
+    if (entry != nullptr) {
+      *entry = std::move(entries[cursor]);
+    }
+    *rid = rids[cursor++];
+    return true;
+  };
+}
+
+template <size_t KeySize>
+auto IndexScanExecutor::ScanRangeEntries(const Tuple *lower, const Tuple *upper, std::vector<RID> *rids,
+                                         std::vector<std::vector<Value>> *entries) -> bool {
+  auto *tree = dynamic_cast<BPlusTreeIndex<GenericKey<KeySize>, RID, GenericComparator<KeySize>> *>(
+      index_info_->index_.get());
+  if (tree == nullptr) {
+    return false;
+  }
+  std::vector<GenericKey<KeySize>> keys;
+  tree->ScanRange(lower, upper, rids, &keys, exec_ctx_->GetTransaction());
+  entries->reserve(keys.size());
+  for (const auto &key : keys) {
+    entries->push_back(KeyEncoder::Decode(key.data_, *tree->GetEntrySchema()));
   }
-  *tuple = tbl_heap_->GetTuple(current_rid).second;
-  *rid = current_rid;
-  ++it_;
   return true;
 }
 
+void IndexScanExecutor::Init() {
+  locks_.LockTable();
+  filter_entry_columns_.clear();
+  if (runtime_filter_ != nullptr) {
+    if (auto key_columns = runtime_filter_->GetKeyColumns(); key_columns.has_value()) {
+      const auto &entry_attrs = index_info_->index_->GetEntryAttrs();
+      for (auto column : *key_columns) {
+        auto pos = std::find(entry_attrs.begin(), entry_attrs.end(), column);
+        if (pos == entry_attrs.end()) {
+          filter_entry_columns_.clear();
+          break;
+        }
+        filter_entry_columns_.push_back(pos - entry_attrs.begin());
+      }
+    }
+  }
+  if (plan_->IsRangeScan()) {
+    InitRange();
+  } else if (!InitIterator<8>() && !InitIterator<16>() && !InitIterator<32>() && !InitIterator<64>() &&
+             !InitIterator<4>()) {
+    throw ExecutionException("index scan needs a B+ tree index");
+  }
+  if (plan_->IsIndexOnly()) {
+    // where each output column is found in the index entries, -1 if it is not stored there
+    const auto &entry_attrs = index_info_->index_->GetEntryAttrs();
+    entry_column_of_.assign(GetOutputSchema().GetColumnCount(), -1);
+    for (size_t i = 0; i < entry_attrs.size(); i++) {
+      entry_column_of_[entry_attrs[i]] = static_cast<int>(i);
+    }
+  }
+}
+
+auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  RID current_rid;
+  std::vector<Value> entry;
+  bool decode_entry = plan_->IsIndexOnly() || !filter_entry_columns_.empty();
+  std::vector<Value> filter_keys(filter_entry_columns_.size());
+  while (next_entry_(&current_rid, decode_entry ? &entry : nullptr)) {
+    if (!filter_entry_columns_.empty()) {
+      // the keys of the runtime filter are in the entry, so a row that it drops is neither locked nor fetched
+      for (size_t i = 0; i < filter_entry_columns_.size(); i++) {
+        filter_keys[i] = entry[filter_entry_columns_[i]];
+      }
+      if (!runtime_filter_->MayMatch(filter_keys)) {
+        continue;
+      }
+    }
+    locks_.LockRow(current_rid);
+    if (plan_->IsIndexOnly()) {
+      // the values come from the entry, but only the tuple meta says whether the row is still visible
+      auto tuple_meta = tbl_heap_->GetTupleMeta(current_rid);
+      locks_.UnlockRow(current_rid, tuple_meta.is_deleted_);
+      if (tuple_meta.is_deleted_) {
+        continue;
+      }
+      std::vector<Value> values;
+      values.reserve(GetOutputSchema().GetColumnCount());
+      for (uint32_t i = 0; i < GetOutputSchema().GetColumnCount(); i++) {
+        values.push_back(entry_column_of_[i] >= 0
+                             ? entry[entry_column_of_[i]]
+                             : ValueFactory::GetNullValueByType(GetOutputSchema().GetColumn(i).GetType()));
+      }
+      *tuple = Tuple(values, &GetOutputSchema());
+    } else {
+      auto [tuple_meta, heap_tuple] = tbl_heap_->GetTuple(current_rid);
+      locks_.UnlockRow(current_rid, tuple_meta.is_deleted_);
+      if (tuple_meta.is_deleted_) {
+        continue;
+      }
+      *tuple = std::move(heap_tuple);
+    }
+    // a filter whose keys are not all in the entries tests the row, before it goes into a chunk
+    if (runtime_filter_ != nullptr && filter_entry_columns_.empty() && !runtime_filter_->MayMatch(*tuple)) {
+      continue;
+    }
+    *rid = current_rid;
+    return true;
+  }
+  locks_.UnlockTable();
+  return false;
+}
+
 }  // namespace bustub
@@ -41,6 +41,8 @@ auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
   TupleMeta insert_tuple_meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
   Tuple insert_tuple;
   RID common_rid;
+  // index entries are collected per index and inserted as one sorted batch once the child is drained
+  std::vector<std::vector<std::pair<Tuple, RID>>> index_entries(table_index_.size());
   while (true) {
     // Get the next tuple
     const auto status = child_executor_->Next(&insert_tuple, &common_rid);
@@ -52,13 +54,19 @@ auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
     TableWriteRecord table_write_record = TableWriteRecord(table_info_->oid_, *insert_rid, table_info_->table_.get());
     table_write_record.wtype_ = WType::INSERT;
     exec_ctx_->GetTransaction()->AppendTableWriteRecord(table_write_record);
-    for (const auto &indexs : table_index_) {
-      indexs->index_->InsertEntry(
-          insert_tuple.KeyFromTuple(table_info_->schema_, indexs->key_schema_, indexs->index_->GetKeyAttrs()),
-          *insert_rid, exec_ctx_->GetTransaction());
+    for (size_t i = 0; i < table_index_.size(); i++) {
+      const auto &indexs = table_index_[i];
+      index_entries[i].emplace_back(insert_tuple.KeyFromTuple(table_info_->schema_, *indexs->index_->GetEntrySchema(),
+                                                              indexs->index_->GetEntryAttrs()),
+                                    *insert_rid);
+      exec_ctx_->GetTransaction()->AppendIndexWriteRecord(IndexWriteRecord(
+          *insert_rid, table_info_->oid_, WType::INSERT, insert_tuple, indexs->index_oid_, exec_ctx_->GetCatalog()));
     }
     col++;
   }
+  for (size_t i = 0; i < table_index_.size(); i++) {
+    table_index_[i]->index_->InsertEntries(index_entries[i], exec_ctx_->GetTransaction());
+  }
   done_ = true;
   *tuple = Tuple({Value(INTEGER, col)}, &GetOutputSchema());
   return true;
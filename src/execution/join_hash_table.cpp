@@ -0,0 +1,477 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table.cpp
+//
+// Identification: src/execution/join_hash_table.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/join_hash_table.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "common/exception.h"
+#include "type/limits.h"
+#include "type/type.h"
+
+namespace bustub {
+
+namespace {
+
+auto ReadInteger(const ColumnVector &column, size_t row) -> int64_t {
+  switch (column.GetType()) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      return column.GetData<int8_t>()[row];
+    case TypeId::SMALLINT:
+      return column.GetData<int16_t>()[row];
+    case TypeId::INTEGER:
+      return column.GetData<int32_t>()[row];
+    case TypeId::BIGINT:
+      return column.GetData<int64_t>()[row];
+    case TypeId::TIMESTAMP:
+      return static_cast<int64_t>(column.GetData<uint64_t>()[row]);
+    default:
+      break;
+  }
+  throw Exception(ExceptionType::MISMATCH_TYPE, "Join key is not an integer.");
+}
+
+auto ReadDecimal(const ColumnVector &column, size_t row) -> double {
+  // -0.0 == 0.0, so both are stored and hashed as 0.0
+  double value = column.GetType() == TypeId::DECIMAL ? column.GetData<double>()[row]
+                                                     : static_cast<double>(ReadInteger(column, row));
+  return value == 0 ? 0 : value;
+}
+
+auto ValueAsInteger(const Value &value) -> int64_t {
+  switch (value.GetTypeId()) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      return value.GetAs<int8_t>();
+    case TypeId::SMALLINT:
+      return value.GetAs<int16_t>();
+    case TypeId::INTEGER:
+      return value.GetAs<int32_t>();
+    case TypeId::BIGINT:
+      return value.GetAs<int64_t>();
+    case TypeId::TIMESTAMP:
+      return static_cast<int64_t>(value.GetAs<uint64_t>());
+    default:
+      break;
+  }
+  throw Exception(ExceptionType::MISMATCH_TYPE, "Join key is not an integer.");
+}
+
+auto ValueAsDecimal(const Value &value) -> double {
+  double decimal =
+      value.GetTypeId() == TypeId::DECIMAL ? value.GetAs<double>() : static_cast<double>(ValueAsInteger(value));
+  return decimal == 0 ? 0 : decimal;
+}
+
+template <typename T>
+auto Load(const char *data) -> T {
+  T value;
+  memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void Store(char *data, T value) {
+  memcpy(data, &value, sizeof(T));
+}
+
+constexpr auto AlignUp(size_t size) -> size_t { return (size + alignof(uint64_t) - 1) & ~(alignof(uint64_t) - 1); }
+
+}  // namespace
+
+JoinHashTable::JoinHashTable(const Schema &build_schema, const std::vector<TypeId> &build_key_types,
+                             const std::vector<TypeId> &probe_key_types, bool keep_null_keys)
+    : build_schema_(build_schema), keep_null_keys_(keep_null_keys) {
+  BUSTUB_ASSERT(build_key_types.size() == probe_key_types.size(), "the two sides must have as many keys");
+  for (size_t i = 0; i < build_key_types.size(); i++) {
+    auto build_type = build_key_types[i];
+    auto probe_type = probe_key_types[i];
+    if (build_type == TypeId::VARCHAR || probe_type == TypeId::VARCHAR) {
+      if (build_type != probe_type) {
+        throw NotImplementedException("join of a VARCHAR key with a key of another type");
+      }
+      key_kinds_.push_back(KeyKind::String);
+    } else if (build_type == TypeId::DECIMAL || probe_type == TypeId::DECIMAL) {
+      key_kinds_.push_back(KeyKind::Decimal);
+    } else {
+      key_kinds_.push_back(KeyKind::Integer);
+    }
+  }
+  for (const auto &column : build_schema_.GetColumns()) {
+    column_offsets_.push_back(fixed_size_);
+    fixed_size_ += column.GetType() == TypeId::VARCHAR ? sizeof(uint32_t) : Type::GetTypeSize(column.GetType());
+  }
+}
+
+void JoinHashTable::Clear() {
+  arena_.clear();
+  row_count_ = 0;
+  partition_bits_ = 0;
+  partitions_.clear();
+  slots_.clear();
+}
+
+void JoinHashTable::Append(const DataChunk &chunk, const std::vector<const ColumnVector *> &keys) {
+  for (size_t i = 0; i < chunk.Size(); i++) {
+    size_t row = chunk.RowAt(i);
+    size_t key_size = 0;
+    bool has_null_key = false;
+    for (size_t k = 0; k < keys.size(); k++) {
+      has_null_key |= !keys[k]->IsValid(row);
+      key_size += key_kinds_[k] == KeyKind::String ? sizeof(uint32_t) + keys[k]->GetString(row).size() : 8;
+    }
+    if (has_null_key) {
+      if (!keep_null_keys_) {
+        continue;
+      }
+      key_size = 0;
+    }
+    size_t row_size = fixed_size_;
+    for (size_t c = 0; c < build_schema_.GetColumnCount(); c++) {
+      const auto &column = chunk.GetColumn(c);
+      if (column.GetType() == TypeId::VARCHAR && column.IsValid(row)) {
+        row_size += column.GetString(row).size();
+      }
+    }
+
+    uint64_t entry = arena_.size();
+    size_t size = AlignUp(sizeof(EntryHeader) + key_size + row_size);
+    arena_.resize(entry + size);
+    auto *header = Header(entry);
+    header->next_ = NONE;
+    header->hash_ = has_null_key ? 0 : Hash(keys, row);
+    header->key_size_ = key_size;
+    header->size_ = size;
+
+    char *data = arena_.data() + entry + sizeof(EntryHeader);
+    for (size_t k = 0; k < keys.size() && !has_null_key; k++) {
+      switch (key_kinds_[k]) {
+        case KeyKind::Integer:
+          Store(data, ReadInteger(*keys[k], row));
+          data += sizeof(int64_t);
+          break;
+        case KeyKind::Decimal:
+          Store(data, ReadDecimal(*keys[k], row));
+          data += sizeof(double);
+          break;
+        case KeyKind::String: {
+          const auto &value = keys[k]->GetString(row);
+          Store(data, static_cast<uint32_t>(value.size()));
+          memcpy(data + sizeof(uint32_t), value.data(), value.size());
+          data += sizeof(uint32_t) + value.size();
+          break;
+        }
+      }
+    }
+
+    char *varlen = data + fixed_size_;
+    for (size_t c = 0; c < build_schema_.GetColumnCount(); c++) {
+      const auto &column = chunk.GetColumn(c);
+      char *field = data + column_offsets_[c];
+      if (column.GetType() != TypeId::VARCHAR) {
+        memcpy(field, column.GetData<char>() + row * column.GetWidth(), column.GetWidth());
+      } else if (!column.IsValid(row)) {
+        Store(field, BUSTUB_VALUE_NULL);
+      } else {
+        const auto &value = column.GetString(row);
+        Store(field, static_cast<uint32_t>(value.size()));
+        memcpy(varlen, value.data(), value.size());
+        varlen += value.size();
+      }
+    }
+
+    row_count_++;
+  }
+}
+
+void JoinHashTable::Partition(size_t partition_bits) {
+  BUSTUB_ASSERT(partition_bits <= MAX_PARTITION_BITS, "too many partitions");
+  partition_bits_ = partition_bits;
+  partitions_.assign(size_t{1} << partition_bits, PartitionInfo{0, 0, 0, 0, 0});
+  if (partitions_.size() == 1) {
+    partitions_[0] = {0, arena_.size(), row_count_, 0, 0};
+    return;
+  }
+
+  // size the partitions, then lay them out one after the other; end_ is the write position until the copy is done
+  for (uint64_t entry = 0; entry < arena_.size(); entry = RowAfter(entry)) {
+    const auto *header = Header(entry);
+    auto &partition = partitions_[PartitionOf(header->hash_)];
+    partition.end_ += header->size_;
+    partition.row_count_++;
+  }
+  uint64_t offset = 0;
+  for (auto &partition : partitions_) {
+    partition.begin_ = offset;
+    offset += partition.end_;
+    partition.end_ = partition.begin_;
+  }
+
+  std::vector<char> partitioned(arena_.size());
+  std::vector<WriteCombineBuffer> buffers(partitions_.size());
+  std::vector<uint32_t> buffered(partitions_.size(), 0);
+  auto flush = [&](size_t p) {
+    memcpy(partitioned.data() + partitions_[p].end_, buffers[p].data_, buffered[p]);
+    partitions_[p].end_ += buffered[p];
+    buffered[p] = 0;
+  };
+  for (uint64_t entry = 0; entry < arena_.size(); entry = RowAfter(entry)) {
+    const auto *header = Header(entry);
+    size_t p = PartitionOf(header->hash_);
+    if (buffered[p] + header->size_ > WriteCombineBuffer::SIZE) {
+      flush(p);
+    }
+    if (header->size_ > WriteCombineBuffer::SIZE) {
+      memcpy(partitioned.data() + partitions_[p].end_, header, header->size_);
+      partitions_[p].end_ += header->size_;
+    } else {
+      memcpy(buffers[p].data_ + buffered[p], header, header->size_);
+      buffered[p] += header->size_;
+    }
+  }
+  for (size_t p = 0; p < partitions_.size(); p++) {
+    flush(p);
+  }
+  arena_.swap(partitioned);
+}
+
+void JoinHashTable::Build(size_t partition_bits) {
+  Partition(partition_bits);
+  uint64_t slot_count = 0;
+  for (auto &partition : partitions_) {
+    size_t capacity = DirectoryCapacity(partition.row_count_);
+    partition.slot_begin_ = slot_count;
+    partition.slot_mask_ = capacity - 1;
+    slot_count += capacity;
+  }
+  slots_.assign(slot_count, 0);
+  std::vector<uint64_t> entries;
+  for (const auto &partition : partitions_) {
+    entries.clear();
+    for (uint64_t entry = partition.begin_; entry < partition.end_; entry = RowAfter(entry)) {
+      if (Header(entry)->key_size_ != 0) {
+        entries.push_back(entry);
+      }
+    }
+    // insert from the last row to the first, each in front of the rows with its key, so that the rows of a key are
+    // found in the order they were appended
+    for (auto entry = entries.rbegin(); entry != entries.rend(); entry++) {
+      Insert(partition, *entry);
+    }
+  }
+}
+
+void JoinHashTable::Insert(const PartitionInfo &partition, uint64_t entry) {
+  auto *header = Header(entry);
+  uint64_t slot_value = Tag(header->hash_) | (entry + 1);
+  for (uint64_t i = header->hash_;; i++) {
+    uint64_t &existing = slots_[partition.slot_begin_ + (i & partition.slot_mask_)];
+    if (existing == 0) {
+      header->next_ = NONE;
+      existing = slot_value;
+      return;
+    }
+    if (Tag(existing) != Tag(header->hash_)) {
+      continue;
+    }
+    uint64_t head = (existing & SLOT_OFFSET_MASK) - 1;
+    const auto *head_header = Header(head);
+    if (head_header->hash_ == header->hash_ && head_header->key_size_ == header->key_size_ &&
+        memcmp(Key(head), Key(entry), header->key_size_) == 0) {
+      header->next_ = head;
+      existing = slot_value;
+      return;
+    }
+  }
+}
+
+auto JoinHashTable::Hash(const std::vector<const ColumnVector *> &keys, size_t row) const -> hash_t {
+  hash_t hash = 0;
+  for (size_t k = 0; k < keys.size(); k++) {
+    uint64_t bits = 0;
+    switch (key_kinds_[k]) {
+      case KeyKind::Integer:
+        bits = static_cast<uint64_t>(ReadInteger(*keys[k], row));
+        break;
+      case KeyKind::Decimal: {
+        double value = ReadDecimal(*keys[k], row);
+        memcpy(&bits, &value, sizeof(bits));
+        break;
+      }
+      case KeyKind::String: {
+        const auto &value = keys[k]->GetString(row);
+        bits = HashUtil::HashBytes(value.data(), value.size());
+        break;
+      }
+    }
+    hash = HashUtil::MixHash(hash ^ bits);
+  }
+  return hash;
+}
+
+auto JoinHashTable::Hash(const std::vector<Value> &keys) const -> hash_t {
+  hash_t hash = 0;
+  for (size_t k = 0; k < keys.size(); k++) {
+    uint64_t bits = 0;
+    switch (key_kinds_[k]) {
+      case KeyKind::Integer:
+        bits = static_cast<uint64_t>(ValueAsInteger(keys[k]));
+        break;
+      case KeyKind::Decimal: {
+        double value = ValueAsDecimal(keys[k]);
+        memcpy(&bits, &value, sizeof(bits));
+        break;
+      }
+      case KeyKind::String:
+        bits = HashUtil::HashBytes(keys[k].GetData(), keys[k].GetLength());
+        break;
+    }
+    hash = HashUtil::MixHash(hash ^ bits);
+  }
+  return hash;
+}
+
+auto JoinHashTable::Find(hash_t hash, const std::vector<const ColumnVector *> &keys, size_t row) const -> uint64_t {
+  if (slots_.empty()) {
+    return NONE;
+  }
+  for (const auto *key : keys) {
+    if (!key->IsValid(row)) {
+      return NONE;
+    }
+  }
+  const auto &partition = partitions_[PartitionOf(hash)];
+  for (uint64_t i = hash;; i++) {
+    uint64_t existing = slots_[partition.slot_begin_ + (i & partition.slot_mask_)];
+    if (existing == 0) {
+      return NONE;
+    }
+    if (Tag(existing) != Tag(hash)) {
+      continue;
+    }
+    uint64_t entry = (existing & SLOT_OFFSET_MASK) - 1;
+    if (Header(entry)->hash_ == hash && KeyEquals(entry, keys, row)) {
+      return entry;
+    }
+  }
+}
+
+auto JoinHashTable::Find(const JoinHashTable &probe, uint64_t probe_entry) const -> uint64_t {
+  const auto *probe_header = probe.Header(probe_entry);
+  if (slots_.empty() || probe_header->key_size_ == 0) {
+    return NONE;
+  }
+  hash_t hash = probe_header->hash_;
+  const auto &partition = partitions_[PartitionOf(hash)];
+  for (uint64_t i = hash;; i++) {
+    uint64_t existing = slots_[partition.slot_begin_ + (i & partition.slot_mask_)];
+    if (existing == 0) {
+      return NONE;
+    }
+    if (Tag(existing) != Tag(hash)) {
+      continue;
+    }
+    uint64_t entry = (existing & SLOT_OFFSET_MASK) - 1;
+    const auto *header = Header(entry);
+    if (header->hash_ == hash && header->key_size_ == probe_header->key_size_ &&
+        memcmp(Key(entry), probe.Key(probe_entry), header->key_size_) == 0) {
+      return entry;
+    }
+  }
+}
+
+void JoinHashTable::FindBatch(const DataChunk &chunk, const std::vector<const ColumnVector *> &keys,
+                              std::vector<uint64_t> *matches) const {
+  matches->assign(chunk.Size(), NONE);
+  if (slots_.empty()) {
+    return;
+  }
+  std::array<hash_t, PROBE_GROUP_SIZE> hashes;
+  for (size_t begin = 0; begin < chunk.Size(); begin += PROBE_GROUP_SIZE) {
+    size_t count = std::min(PROBE_GROUP_SIZE, chunk.Size() - begin);
+    for (size_t i = 0; i < count; i++) {
+      hashes[i] = Hash(keys, chunk.RowAt(begin + i));
+      __builtin_prefetch(&slots_[FirstSlot(hashes[i])]);
+    }
+    // the first slot of a probe almost always holds its row or is empty, so only the row it points to is prefetched
+    for (size_t i = 0; i < count; i++) {
+      uint64_t existing = slots_[FirstSlot(hashes[i])];
+      if (existing != 0 && Tag(existing) == Tag(hashes[i])) {
+        __builtin_prefetch(arena_.data() + (existing & SLOT_OFFSET_MASK) - 1);
+      }
+    }
+    for (size_t i = 0; i < count; i++) {
+      (*matches)[begin + i] = Find(hashes[i], keys, chunk.RowAt(begin + i));
+    }
+  }
+}
+
+auto JoinHashTable::KeyEquals(uint64_t entry, const std::vector<const ColumnVector *> &keys, size_t row) const
+    -> bool {
+  const char *data = Key(entry);
+  for (size_t k = 0; k < keys.size(); k++) {
+    switch (key_kinds_[k]) {
+      case KeyKind::Integer:
+        if (Load<int64_t>(data) != ReadInteger(*keys[k], row)) {
+          return false;
+        }
+        data += sizeof(int64_t);
+        break;
+      case KeyKind::Decimal:
+        if (Load<double>(data) != ReadDecimal(*keys[k], row)) {
+          return false;
+        }
+        data += sizeof(double);
+        break;
+      case KeyKind::String: {
+        auto size = Load<uint32_t>(data);
+        const auto &value = keys[k]->GetString(row);
+        if (size != value.size() || memcmp(data + sizeof(uint32_t), value.data(), size) != 0) {
+          return false;
+        }
+        data += sizeof(uint32_t) + size;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+void JoinHashTable::CopyRow(uint64_t entry, DataChunk *chunk, size_t row, size_t first_column) const {
+  const char *data = Key(entry) + Header(entry)->key_size_;
+  const char *varlen = data + fixed_size_;
+  for (size_t c = 0; c < build_schema_.GetColumnCount(); c++) {
+    auto &column = chunk->GetColumn(first_column + c);
+    const char *field = data + column_offsets_[c];
+    if (column.GetType() != TypeId::VARCHAR) {
+      column.SetFromBytes(row, field);
+      continue;
+    }
+    auto size = Load<uint32_t>(field);
+    column.SetString(row, varlen, size);
+    if (size != BUSTUB_VALUE_NULL) {
+      varlen += size;
+    }
+  }
+}
+
+auto JoinHashTable::ScanRows(uint64_t *cursor, DataChunk *chunk) const -> bool {
+  chunk->Reset(&build_schema_);
+  while (!chunk->IsFull() && *cursor < arena_.size()) {
+    CopyRow(*cursor, chunk, chunk->AppendRow(RID{}), 0);
+    *cursor = RowAfter(*cursor);
+  }
+  return !chunk->IsEmpty();
+}
+
+}  // namespace bustub
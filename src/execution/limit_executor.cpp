@@ -31,9 +31,21 @@ auto LimitExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   if (!status) {
     return false;
   }
-  std::cout << tuple->ToString(&GetOutputSchema()) << std::endl;
   ++cursor_;
   return true;
 }
 
+auto LimitExecutor::NextBatch(DataChunk *chunk) -> bool {
+  if (cursor_ == plan_->GetLimit()) {
+    chunk->Reset(&GetOutputSchema());
+    return false;
+  }
+  if (!child_executor_->NextBatch(chunk)) {
+    return false;
+  }
+  chunk->Truncate(plan_->GetLimit() - cursor_);
+  cursor_ += chunk->Size();
+  return true;
+}
+
 }  // namespace bustub
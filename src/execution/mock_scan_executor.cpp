@@ -429,6 +429,15 @@ auto MockScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   return EXECUTOR_ACTIVE;
 }
 
+auto MockScanExecutor::NextBatch(DataChunk *chunk) -> bool {
+  chunk->Reset(&GetOutputSchema());
+  while (!chunk->IsFull() && cursor_ < size_) {
+    chunk->AppendTuple(func_(shuffled_idx_.empty() ? cursor_ : shuffled_idx_[cursor_]), MakeDummyRID());
+    ++cursor_;
+  }
+  return !chunk->IsEmpty();
+}
+
 auto MockScanExecutor::MakeDummyRID() -> RID { return RID{0}; }
 
 }  // namespace bustub
@@ -11,20 +11,115 @@
 //===----------------------------------------------------------------------===//
 
 #include "execution/executors/nested_index_join_executor.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
 NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const NestedIndexJoinPlanNode *plan,
                                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      index_info_(exec_ctx_->GetCatalog()->GetIndex(plan_->GetIndexOid())),
+      inner_table_(exec_ctx_->GetCatalog()->GetTable(plan_->GetInnerTableOid())->table_.get()) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestIndexJoinExecutor::Init() { throw NotImplementedException("NestIndexJoinExecutor is not implemented"); }
+void NestIndexJoinExecutor::Init() {
+  child_executor_->Init();
+  results_.clear();
+  cursor_ = 0;
+  child_done_ = false;
+}
+
+auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (cursor_ == results_.size()) {
+    if (!FillBatch()) {
+      return false;
+    }
+  }
+  *tuple = std::move(results_[cursor_++]);
+  return true;
+}
+
+auto NestIndexJoinExecutor::FillBatch() -> bool {
+  results_.clear();
+  cursor_ = 0;
+  if (child_done_) {
+    return false;
+  }
+  const auto &outer_schema = child_executor_->GetOutputSchema();
+  const auto *key_schema = index_info_->index_->GetKeySchema();
+  std::vector<Tuple> outer_tuples;
+  std::vector<Tuple> keys;
+  std::vector<size_t> key_owner;
+  Tuple outer_tuple;
+  RID outer_rid;
+  while (outer_tuples.size() < BATCH_SIZE) {
+    if (!child_executor_->Next(&outer_tuple, &outer_rid)) {
+      child_done_ = true;
+      break;
+    }
+    auto key_value = plan_->KeyPredicate()->Evaluate(&outer_tuple, outer_schema);
+    if (!key_value.IsNull()) {
+      keys.emplace_back(std::vector<Value>{key_value}, key_schema);
+      key_owner.push_back(outer_tuples.size());
+    }
+    outer_tuples.push_back(outer_tuple);
+  }
+  if (outer_tuples.empty()) {
+    return false;
+  }
+
+  // one batched probe for the whole batch; outer tuples with a null key never match
+  std::vector<std::vector<RID>> key_rids;
+  index_info_->index_->ScanKeys(keys, &key_rids, exec_ctx_->GetTransaction());
+  std::vector<std::vector<RID>> matches(outer_tuples.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    matches[key_owner[i]] = std::move(key_rids[i]);
+  }
 
-auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+  // fetch the inner tuples of the whole batch page by page instead of in key order
+  std::vector<RID> inner_rids;
+  for (const auto &rids : matches) {
+    inner_rids.insert(inner_rids.end(), rids.begin(), rids.end());
+  }
+  auto inner_tuples = inner_table_->GetTuples(inner_rids);
+
+  const auto &inner_schema = plan_->InnerTableSchema();
+  size_t next_inner = 0;
+  for (size_t i = 0; i < outer_tuples.size(); i++) {
+    bool matched = false;
+    for (size_t k = 0; k < matches[i].size(); k++) {
+      const auto &[meta, inner_tuple] = inner_tuples[next_inner++];
+      if (meta.is_deleted_) {
+        continue;
+      }
+      std::vector<Value> values;
+      for (uint32_t j = 0; j < outer_schema.GetColumnCount(); j++) {
+        values.emplace_back(outer_tuples[i].GetValue(&outer_schema, j));
+      }
+      for (uint32_t j = 0; j < inner_schema.GetColumnCount(); j++) {
+        values.emplace_back(inner_tuple.GetValue(&inner_schema, j));
+      }
+      results_.emplace_back(values, &GetOutputSchema());
+      matched = true;
+    }
+    if (!matched && plan_->GetJoinType() == JoinType::LEFT) {
+      std::vector<Value> values;
+      for (uint32_t j = 0; j < outer_schema.GetColumnCount(); j++) {
+        values.emplace_back(outer_tuples[i].GetValue(&outer_schema, j));
+      }
+      for (const Column &col : inner_schema.GetColumns()) {
+        values.emplace_back(ValueFactory::GetNullValueByType(col.GetType()));
+      }
+      results_.emplace_back(values, &GetOutputSchema());
+    }
+  }
+  return true;
+}
 
 }  // namespace bustub
@@ -5,7 +5,11 @@ namespace bustub {
 
 ProjectionExecutor::ProjectionExecutor(ExecutorContext *exec_ctx, const ProjectionPlanNode *plan,
                                        std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
+  for (const auto &expr : plan_->GetExpressions()) {
+    exprs_.emplace_back(*expr, child_executor_->GetOutputSchema());
+  }
+}
 
 void ProjectionExecutor::Init() {
   // Initialize the child executor
@@ -35,4 +39,29 @@ auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
 
   return true;
 }
+
+auto ProjectionExecutor::NextBatch(DataChunk *chunk) -> bool {
+  chunk->Reset(&GetOutputSchema());
+  if (!child_executor_->NextBatch(&child_chunk_)) {
+    return false;
+  }
+  for (size_t i = 0; i < child_chunk_.Size(); i++) {
+    chunk->AppendRow(child_chunk_.GetRID(child_chunk_.RowAt(i)));
+  }
+  for (size_t col = 0; col < exprs_.size(); col++) {
+    const auto &result = exprs_[col].Evaluate(child_chunk_);
+    auto &column = chunk->GetColumn(col);
+    if (result.GetType() == column.GetType()) {
+      for (size_t i = 0; i < child_chunk_.Size(); i++) {
+        column.CopyRow(i, result, child_chunk_.RowAt(i));
+      }
+    } else {
+      for (size_t i = 0; i < child_chunk_.Size(); i++) {
+        column.SetValue(i, result.GetValue(child_chunk_.RowAt(i)));
+      }
+    }
+  }
+  return true;
+}
+
 }  // namespace bustub
@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter.cpp
+//
+// Identification: src/execution/runtime_filter.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/runtime_filter.h"
+
+#include <algorithm>
+
+#include "execution/expressions/column_value_expression.h"
+
+namespace bustub {
+
+RuntimeFilter::RuntimeFilter(ExecutorContext *exec_ctx, const JoinHashTable *table,
+                             const std::vector<AbstractExpressionRef> &key_exprs, const Schema &probe_schema)
+    : exec_ctx_(exec_ctx), table_(table), key_exprs_(key_exprs), probe_schema_(probe_schema) {}
+
+void RuntimeFilter::Clear() {
+  built_ = false;
+  words_.clear();
+  word_mask_ = 0;
+}
+
+void RuntimeFilter::Start(size_t key_count) {
+  // a word for every 4 keys, i.e. 16 bits per key
+  size_t word_count = 1;
+  while (word_count * 4 < key_count) {
+    word_count *= 2;
+  }
+  words_.assign(word_count, 0);
+  word_mask_ = word_count - 1;
+  built_ = false;
+}
+
+auto RuntimeFilter::GetKeyColumns() const -> std::optional<std::vector<uint32_t>> {
+  std::vector<uint32_t> columns;
+  for (const auto &expr : key_exprs_) {
+    const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get());
+    if (column == nullptr) {
+      return std::nullopt;
+    }
+    columns.push_back(column->GetColIdx());
+  }
+  return columns;
+}
+
+auto RuntimeFilter::MayMatch(const Tuple &tuple) -> bool {
+  if (!built_) {
+    return true;
+  }
+  std::vector<Value> keys;
+  keys.reserve(key_exprs_.size());
+  for (const auto &expr : key_exprs_) {
+    keys.push_back(expr->Evaluate(&tuple, probe_schema_));
+  }
+  return MayMatch(keys);
+}
+
+auto RuntimeFilter::MayMatch(const std::vector<Value> &keys) -> bool {
+  if (!built_) {
+    return true;
+  }
+  bool has_null_key = std::any_of(keys.begin(), keys.end(), [](const Value &key) { return key.IsNull(); });
+  if (!has_null_key && MayContain(table_->Hash(keys))) {
+    return true;
+  }
+  exec_ctx_->AddRuntimeFilterRowsEliminated(1);
+  return false;
+}
+
+}  // namespace bustub
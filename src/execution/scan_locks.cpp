@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// scan_locks.cpp
+//
+// Identification: src/execution/scan_locks.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/scan_locks.h"
+
+#include "concurrency/lock_manager.h"
+
+namespace bustub {
+
+void ScanLocks::LockTable() {
+  if (exec_ctx_->IsDelete()) {
+    exec_ctx_->GetLockManager()->LockTable(txn_, LockManager::LockMode::INTENTION_EXCLUSIVE, oid_);
+  } else {
+    if (txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED ||
+        txn_->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ) {
+      if (txn_->GetIntentionExclusiveTableLockSet()->find(oid_) == txn_->GetIntentionExclusiveTableLockSet()->end()) {
+        exec_ctx_->GetLockManager()->LockTable(txn_, LockManager::LockMode::INTENTION_SHARED, oid_);
+      }
+    }
+  }
+}
+
+void ScanLocks::UnlockTable() {
+  if (!exec_ctx_->IsDelete() && txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED) {
+    if (txn_->GetIntentionSharedTableLockSet()->find(oid_) != txn_->GetIntentionSharedTableLockSet()->end()) {
+      exec_ctx_->GetLockManager()->UnlockTable(txn_, oid_);
+    }
+  }
+}
+
+void ScanLocks::LockRow(const RID &rid) {
+  if (exec_ctx_->IsDelete()) {
+    exec_ctx_->GetLockManager()->LockRow(txn_, LockManager::LockMode::EXCLUSIVE, oid_, rid);
+  } else {
+    if (txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED ||
+        txn_->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ) {
+      if (txn_->GetExclusiveRowLockSet()->find(oid_) == txn_->GetExclusiveRowLockSet()->end()) {
+        exec_ctx_->GetLockManager()->LockRow(txn_, LockManager::LockMode::SHARED, oid_, rid);
+      }
+    }
+  }
+}
+
+void ScanLocks::UnlockRow(const RID &rid, bool is_deleted) {
+  if (is_deleted) {
+    if (!(txn_->GetIsolationLevel() == IsolationLevel::READ_UNCOMMITTED && !exec_ctx_->IsDelete())) {
+      exec_ctx_->GetLockManager()->UnlockRow(txn_, oid_, rid, true);
+    }
+    return;
+  }
+  if (!exec_ctx_->IsDelete() && txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED) {
+    if ((*txn_->GetSharedRowLockSet())[oid_].find(rid) != (*txn_->GetSharedRowLockSet())[oid_].end()) {
+      exec_ctx_->GetLockManager()->UnlockRow(txn_, oid_, rid);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -12,6 +12,8 @@
 
 #include "execution/executors/seq_scan_executor.h"
 
+#include <utility>
+
 namespace bustub {
 
 SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan)
@@ -19,80 +21,74 @@ SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNod
       plan_(plan),
       table_info_(exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid())),
       it_(std::make_unique<TableIterator>(table_info_->table_->MakeEagerIterator())),
-      txn_(exec_ctx->GetTransaction()) {}
+      txn_(exec_ctx->GetTransaction()),
+      locks_(exec_ctx, table_info_->oid_) {
+  if (plan_->filter_predicate_ != nullptr) {
+    predicate_.emplace(*plan_->filter_predicate_, GetOutputSchema());
+  }
+}
 
 void SeqScanExecutor::Init() {
-  if (exec_ctx_->IsDelete()) {
-    exec_ctx_->GetLockManager()->LockTable(txn_, LockManager::LockMode::INTENTION_EXCLUSIVE, table_info_->oid_);
-  } else {
-    if (txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED ||
-        txn_->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ) {
-      if (txn_->GetIntentionExclusiveTableLockSet()->find(table_info_->oid_) ==
-          txn_->GetIntentionExclusiveTableLockSet()->end()) {
-        exec_ctx_->GetLockManager()->LockTable(txn_, LockManager::LockMode::INTENTION_SHARED, table_info_->oid_);
-      }
-    }
-  }
+  locks_.LockTable();
   it_ = std::make_unique<TableIterator>(table_info_->table_->MakeEagerIterator());
 }
 
 auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (it_->IsEnd()) {
-    if (!exec_ctx_->IsDelete() && txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED) {
-      if (txn_->GetIntentionSharedTableLockSet()->find(table_info_->oid_) !=
-          txn_->GetIntentionSharedTableLockSet()->end()) {
-        exec_ctx_->GetLockManager()->UnlockTable(txn_, table_info_->oid_);
-      }
+  while (NextRow(tuple, rid)) {
+    if (plan_->filter_predicate_ == nullptr) {
+      return true;
     }
-    return false;
-  }
-  if (exec_ctx_->IsDelete()) {
-    exec_ctx_->GetLockManager()->LockRow(txn_, LockManager::LockMode::EXCLUSIVE, table_info_->oid_, it_->GetRID());
-  } else {
-    if (txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED ||
-        txn_->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ) {
-      if (txn_->GetExclusiveRowLockSet()->find(table_info_->oid_) == txn_->GetExclusiveRowLockSet()->end()) {
-        exec_ctx_->GetLockManager()->LockRow(txn_, LockManager::LockMode::SHARED, table_info_->oid_, it_->GetRID());
-      }
+    auto value = plan_->filter_predicate_->Evaluate(tuple, GetOutputSchema());
+    if (!value.IsNull() && value.GetAs<bool>()) {
+      return true;
     }
   }
-  auto tuple_meta = it_->GetTuple().first;
-  while (tuple_meta.is_deleted_) {
-    if (!(txn_->GetIsolationLevel() == IsolationLevel::READ_UNCOMMITTED && !exec_ctx_->IsDelete())) {
-      exec_ctx_->GetLockManager()->UnlockRow(txn_, table_info_->oid_, it_->GetRID(), true);
-    }
-    ++(*it_);
-    if (it_->IsEnd()) {
-      if (!exec_ctx_->IsDelete() && txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED) {
-        if (txn_->GetIntentionSharedTableLockSet()->find(table_info_->oid_) !=
-            txn_->GetIntentionSharedTableLockSet()->end()) {
-          exec_ctx_->GetLockManager()->UnlockTable(txn_, table_info_->oid_);
-        }
+  return false;
+}
+
+auto SeqScanExecutor::NextBatch(DataChunk *chunk) -> bool {
+  Tuple tuple{};
+  RID rid{};
+  while (true) {
+    chunk->Reset(&GetOutputSchema());
+    while (!chunk->IsFull() && NextRow(&tuple, &rid)) {
+      // the runtime filter reads only the key of the tuple, so a row it drops is never copied into the chunk
+      if (runtime_filter_ == nullptr || runtime_filter_->MayMatch(tuple)) {
+        chunk->AppendTuple(tuple, rid);
       }
+    }
+    if (chunk->IsEmpty()) {
       return false;
     }
-    if (exec_ctx_->IsDelete()) {
-      exec_ctx_->GetLockManager()->LockRow(txn_, LockManager::LockMode::EXCLUSIVE, table_info_->oid_, it_->GetRID());
-    } else {
-      if (txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED ||
-          txn_->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ) {
-        if (txn_->GetExclusiveRowLockSet()->find(table_info_->oid_) == txn_->GetExclusiveRowLockSet()->end()) {
-          exec_ctx_->GetLockManager()->LockRow(txn_, LockManager::LockMode::SHARED, table_info_->oid_, it_->GetRID());
-        }
-      }
+    // evaluate the merged predicate on the scanned chunk, and scan on if it drops every row
+    if (predicate_.has_value()) {
+      predicate_->Filter(chunk);
+    }
+    if (!chunk->IsEmpty()) {
+      return true;
     }
-    tuple_meta = it_->GetTuple().first;
   }
-  *tuple = it_->GetTuple().second;
-  *rid = it_->GetRID();
-  if (!exec_ctx_->IsDelete() && txn_->GetIsolationLevel() == IsolationLevel::READ_COMMITTED) {
-    if ((*txn_->GetSharedRowLockSet())[table_info_->oid_].find(it_->GetRID()) !=
-        (*txn_->GetSharedRowLockSet())[table_info_->oid_].end()) {
-      exec_ctx_->GetLockManager()->UnlockRow(txn_, table_info_->oid_, it_->GetRID());
+}
+
+auto SeqScanExecutor::NextRow(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    if (it_->IsEnd()) {
+      locks_.UnlockTable();
+      return false;
     }
+    locks_.LockRow(it_->GetRID());
+    // fetch the meta and the tuple together, the page is only read once
+    auto [tuple_meta, row] = it_->GetTuple();
+    locks_.UnlockRow(it_->GetRID(), tuple_meta.is_deleted_);
+    if (tuple_meta.is_deleted_) {
+      ++(*it_);
+      continue;
+    }
+    *tuple = std::move(row);
+    *rid = it_->GetRID();
+    ++(*it_);
+    return true;
   }
-  ++(*it_);
-  return true;
 }
 
 }  // namespace bustub
@@ -51,13 +51,23 @@ auto UpdateExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
     }
     Tuple insert_tuple(values, &table_info_->schema_);
     auto insert_rid = table_info_->table_->InsertTuple(insert_tuple_meta, insert_tuple);
+    TableWriteRecord delete_record(table_info_->oid_, update_rid, table_info_->table_.get());
+    delete_record.wtype_ = WType::DELETE;
+    exec_ctx_->GetTransaction()->AppendTableWriteRecord(delete_record);
+    TableWriteRecord insert_record(table_info_->oid_, *insert_rid, table_info_->table_.get());
+    insert_record.wtype_ = WType::INSERT;
+    exec_ctx_->GetTransaction()->AppendTableWriteRecord(insert_record);
     for (const auto &indexs : table_index_) {
-      indexs->index_->DeleteEntry(
-          update_tuple.KeyFromTuple(table_info_->schema_, indexs->key_schema_, indexs->index_->GetKeyAttrs()),
-          update_rid, exec_ctx_->GetTransaction());
-      indexs->index_->InsertEntry(
-          insert_tuple.KeyFromTuple(table_info_->schema_, indexs->key_schema_, indexs->index_->GetKeyAttrs()),
-          *insert_rid, exec_ctx_->GetTransaction());
+      indexs->index_->DeleteEntry(update_tuple.KeyFromTuple(table_info_->schema_, *indexs->index_->GetEntrySchema(),
+                                                            indexs->index_->GetEntryAttrs()),
+                                  update_rid, exec_ctx_->GetTransaction());
+      indexs->index_->InsertEntry(insert_tuple.KeyFromTuple(table_info_->schema_, *indexs->index_->GetEntrySchema(),
+                                                            indexs->index_->GetEntryAttrs()),
+                                  *insert_rid, exec_ctx_->GetTransaction());
+      exec_ctx_->GetTransaction()->AppendIndexWriteRecord(IndexWriteRecord(
+          update_rid, table_info_->oid_, WType::DELETE, update_tuple, indexs->index_oid_, exec_ctx_->GetCatalog()));
+      exec_ctx_->GetTransaction()->AppendIndexWriteRecord(IndexWriteRecord(
+          *insert_rid, table_info_->oid_, WType::INSERT, insert_tuple, indexs->index_oid_, exec_ctx_->GetCatalog()));
     }
     num++;
   }
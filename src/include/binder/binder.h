@@ -153,6 +153,8 @@ class Binder {
 
   auto BindAExpr(duckdb_libpgquery::PGAExpr *root) -> std::unique_ptr<BoundExpression>;
 
+  auto BindBetween(duckdb_libpgquery::PGAExpr *root) -> std::unique_ptr<BoundExpression>;
+
   auto BindBoolExpr(duckdb_libpgquery::PGBoolExpr *root) -> std::unique_ptr<BoundExpression>;
 
   auto BindFrom(duckdb_libpgquery::PGList *list) -> std::unique_ptr<BoundTableRef>;
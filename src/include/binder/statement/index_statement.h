@@ -8,6 +8,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -21,7 +22,9 @@ namespace bustub {
 class IndexStatement : public BoundStatement {
  public:
   explicit IndexStatement(std::string index_name, std::unique_ptr<BoundBaseTableRef> table,
-                          std::vector<std::unique_ptr<BoundColumnRef>> cols);
+                          std::vector<std::unique_ptr<BoundColumnRef>> cols, std::string index_type,
+                          std::vector<std::unique_ptr<BoundColumnRef>> include_cols, bool adaptive_hash_index,
+                          std::optional<double> merge_threshold, bool compaction);
 
   /** Name of the index */
   std::string index_name_;
@@ -32,6 +35,21 @@ class IndexStatement : public BoundStatement {
   /** Name of the columns */
   std::vector<std::unique_ptr<BoundColumnRef>> cols_;
 
+  /** Access method given in `USING <method>`, empty if none was given */
+  std::string index_type_;
+
+  /** Name of the columns stored in the index in addition to the key */
+  std::vector<std::unique_ptr<BoundColumnRef>> include_cols_;
+
+  /** Whether a B+ tree index caches the leaves of hot keys, `WITH (adaptive_hash = 'off')` turns it off */
+  bool adaptive_hash_index_;
+
+  /** How full a B+ tree node must stay before a delete rebalances it, `WITH (merge_threshold = '0.1')` */
+  std::optional<double> merge_threshold_;
+
+  /** Whether a B+ tree index merges its sparse leaves on a background thread, `WITH (compaction = 'on')` */
+  bool compaction_;
+
   auto ToString() const -> std::string override;
 };
 
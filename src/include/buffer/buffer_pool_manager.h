@@ -12,10 +12,14 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
+#include <deque>
 #include <list>
 #include <memory>
-#include <mutex>  // NOLINT
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
 #include <unordered_map>
+#include <vector>
 
 #include "buffer/lru_k_replacer.h"
 #include "common/config.h"
@@ -121,6 +125,26 @@ class BufferPoolManager {
   auto FetchPageRead(page_id_t page_id) -> ReadPageGuard;
   auto FetchPageWrite(page_id_t page_id) -> WritePageGuard;
 
+  /**
+   * @brief Fetch a page without latching it, see OptimisticPageGuard.
+   *
+   * @param page_id, the id of the page to fetch
+   * @return an optimistic guard, invalid if the page could not be fetched or is write-latched
+   */
+  auto FetchPageOptimistic(page_id_t page_id) -> OptimisticPageGuard;
+
+  /**
+   * @brief Start reading pages that are not in the buffer pool in the background, so that fetching them soon after
+   * waits for what is left of their reads instead of the whole of them, and their reads overlap with each other.
+   *
+   * A prefetched page is put in a frame unpinned. A FetchPage of a page still queued reads it itself, and one of a page
+   * being read waits for it. Pages are not prefetched while a quarter of the pool is already on its way in, and a page
+   * for which no frame can be found is dropped.
+   *
+   * @param page_ids ids of the pages about to be fetched
+   */
+  void PrefetchPages(const std::vector<page_id_t> &page_ids);
+
   /**
    * TODO(P1): Add implementation
    *
@@ -190,9 +214,29 @@ class BufferPoolManager {
   std::unique_ptr<LRUKReplacer> replacer_;
   /** List of free frames that don't have any pages on them. */
   std::list<frame_id_t> free_list_;
+  /**
+   * Pages put in a frame so far. A frame that gets a page starts its version at this count times 2^32, so that
+   * versions are never repeated across frames and a page and version seen earlier still means an unwritten page.
+   */
+  uint64_t page_loads_{0};
   /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
   std::mutex latch_;
 
+  /** Pages that PrefetchPages queued and that are not in a frame yet, each with whether a prefetch thread reads it */
+  std::unordered_map<page_id_t, bool> prefetching_;
+  /** The queued pages, in the order they were asked for; some may have been fetched or deleted in the meantime */
+  std::deque<page_id_t> prefetch_queue_;
+  /** Wakes the prefetch threads when pages are queued, and when the pool shuts down */
+  std::condition_variable prefetch_cv_;
+  /** Wakes the fetches that wait for a page a prefetch thread reads */
+  std::condition_variable prefetched_cv_;
+  /** Started by the first prefetch */
+  std::vector<std::thread> prefetch_threads_;
+  bool shutdown_{false};
+
+  /** Read the queued pages and put them in frames, until the pool shuts down. Runs on the prefetch threads. */
+  void PrefetchLoop();
+
   /**
    * @brief Allocate a page on disk. Caller should acquire the latch before calling this function.
    * @return the id of the allocated page
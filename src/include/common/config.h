@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <chrono>  // NOLINT
+#include <cstddef>
 #include <cstdint>
 
 namespace bustub {
@@ -21,6 +22,9 @@ namespace bustub {
 /** Cycle detection is performed every CYCLE_DETECTION_INTERVAL milliseconds. */
 extern std::chrono::milliseconds cycle_detection_interval;
 
+/** A B+ tree with background compaction started merges its sparse leaves every B_PLUS_TREE_COMPACTION_INTERVAL. */
+extern std::chrono::milliseconds b_plus_tree_compaction_interval;
+
 /** True if logging should be enabled, false otherwise. */
 extern std::atomic<bool> enable_logging;
 
@@ -36,6 +40,10 @@ static constexpr int BUFFER_POOL_SIZE = 10;
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * BUSTUB_PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                               // size of extendible hash bucket
 static constexpr int LRUK_REPLACER_K = 10;  // lookback window for lru-k replacer
+static constexpr size_t BUSTUB_BATCH_SIZE = 1024;  // tuples an executor produces per NextBatch call
+static constexpr size_t HASH_JOIN_MEMORY_BUDGET = 128 << 20;  // bytes of a hash join table before it spills to disk
+static constexpr size_t HASH_JOIN_CACHE_SIZE = 1 << 20;  // bytes of a hash join table partition, to fit in cache
+static constexpr size_t BUFFER_POOL_PREFETCH_THREADS = 4;  // threads that read the pages a buffer pool prefetches
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// reader_biased_latch.h
+//
+// Identification: src/include/common/reader_biased_latch.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/** Default number of reader indicators of a ReaderBiasedLatch. */
+static constexpr size_t READER_BIASED_LATCH_STRIPES = 8;
+
+/**
+ * Reader-writer latch whose readers do not share a cache line.
+ *
+ * A std::shared_mutex keeps a single reader count, so every read latch writes the same line and readers on different
+ * cores keep stealing it from each other, which is what a B+ tree root read by every lookup suffers from. Here the
+ * readers count themselves in one of several indicators, each on its own cache line, picked by thread, and only
+ * read the writer flag, which stays shared in every cache while there is no writer.
+ *
+ * A writer raises the flag and then waits for every indicator to drain. A reader publishes itself in its indicator
+ * before it looks at the flag, so either the writer sees the reader or the reader sees the flag, backs out and
+ * waits for the writer on its mutex. Writers are therefore preferred: a read latch must not be taken again by a
+ * thread that already holds it, as a writer waiting in between would block it.
+ */
+template <size_t Stripes = READER_BIASED_LATCH_STRIPES>
+class ReaderBiasedLatch {
+  static_assert(Stripes > 0, "a reader biased latch needs at least one reader indicator");
+
+ public:
+  ReaderBiasedLatch() = default;
+  DISALLOW_COPY_AND_MOVE(ReaderBiasedLatch);
+
+  /**
+   * Acquire a write latch.
+   */
+  void WLock() {
+    writer_mutex_.lock();
+    writer_.store(true);
+    for (auto &indicator : readers_) {
+      while (indicator.count_.load() != 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /**
+   * Release a write latch.
+   */
+  void WUnlock() {
+    writer_.store(false);
+    writer_mutex_.unlock();
+  }
+
+  /**
+   * Acquire a read latch.
+   */
+  void RLock() {
+    auto &indicator = readers_[ThreadStripe()];
+    while (true) {
+      indicator.count_.fetch_add(1);
+      if (!writer_.load()) {
+        return;
+      }
+      indicator.count_.fetch_sub(1);
+      // sleep until the writer is done rather than spin on its flag
+      std::scoped_lock wait_for_writer(writer_mutex_);
+    }
+  }
+
+  /**
+   * Release a read latch.
+   */
+  void RUnlock() { readers_[ThreadStripe()].count_.fetch_sub(1, std::memory_order_release); }
+
+ private:
+  /** Cache line size assumed for the reader indicators. */
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  struct alignas(CACHE_LINE_SIZE) ReaderIndicator {
+    std::atomic<int32_t> count_{0};
+  };
+
+  /** @return the indicator of the calling thread, threads are spread over them in the order they first latch */
+  static auto ThreadStripe() -> size_t {
+    static std::atomic<size_t> next_stripe{0};
+    thread_local size_t stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % Stripes;
+    return stripe;
+  }
+
+  std::array<ReaderIndicator, Stripes> readers_;
+  alignas(CACHE_LINE_SIZE) std::atomic<bool> writer_{false};
+  /** Serializes the writers and parks the readers that arrive while one holds the latch */
+  std::mutex writer_mutex_;
+};
+
+}  // namespace bustub
@@ -45,6 +45,19 @@ class HashUtil {
     return HashBytes(reinterpret_cast<char *>(both), sizeof(hash_t) * 2);
   }
 
+  /**
+   * @return the 64-bit finalizer of MurmurHash3 applied to `key`, which spreads every bit of the key over all the bits
+   * of the hash, so that the low bits of the hash can index a table
+   */
+  static inline auto MixHash(uint64_t key) -> hash_t {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+  }
+
   static inline auto SumHashes(hash_t l, hash_t r) -> hash_t {
     return (l % PRIME_FACTOR + r % PRIME_FACTOR) % PRIME_FACTOR;
   }
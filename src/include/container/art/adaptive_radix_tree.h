@@ -0,0 +1,152 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// adaptive_radix_tree.h
+//
+// Identification: src/include/container/art/adaptive_radix_tree.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "common/macros.h"
+#include "container/art/art_node.h"
+
+namespace bustub {
+
+#define ART_TYPE AdaptiveRadixTree<ValueType>
+
+/**
+ * An in-memory adaptive radix tree (Leis et al., ICDE 2013) mapping byte strings to values, with optimistic lock
+ * coupling (Leis et al., DaMoN 2016) for concurrent readers and writers.
+ *
+ * Like the primer Trie it branches on one byte of the key per level, but inner nodes come in four sizes chosen by
+ * their number of children (see ArtNode) and single-child paths are compressed into the node below, so that the tree
+ * stays shallow and small on sparse keys. Any key may be a prefix of another.
+ *
+ * Lookups take no latch. Writers lock the one or two nodes they change, and the parent of a node they replace. Nodes
+ * and leaves taken out of the tree are retired rather than freed, since readers may still be reading them, and freed
+ * by epoch-based reclamation (Fraser, 2004): every operation announces the global epoch it started in, the epoch
+ * advances once no operation is left in an older one, and what was retired two epochs ago is freed then.
+ *
+ * Get, Put and Remove follow TrieStore, except that Get returns a copy of the value: a leaf whose value is
+ * overwritten is retired, so no reference into the tree outlives the call.
+ */
+template <typename ValueType>
+class AdaptiveRadixTree {
+ public:
+  AdaptiveRadixTree();
+  ~AdaptiveRadixTree();
+
+  DISALLOW_COPY_AND_MOVE(AdaptiveRadixTree);
+
+  /** @return the value of the key, or std::nullopt if the key is not in the tree */
+  auto Get(std::string_view key) const -> std::optional<ValueType>;
+
+  /**
+   * Insert the key unless it is already in the tree.
+   * @return false if the key was already in the tree, which is left unchanged
+   */
+  auto Insert(std::string_view key, ValueType value) -> bool;
+
+  /** Insert the key, overwriting its value if it is already in the tree. */
+  void Put(std::string_view key, ValueType value);
+
+  /** @return false if the key was not in the tree */
+  auto Remove(std::string_view key) -> bool;
+
+  /** @return the number of keys in the tree */
+  auto Size() const -> size_t { return size_.load(); }
+
+  /** @return the bytes taken by the nodes and leaves of the tree, must not run alongside writers */
+  auto MemoryUsage() const -> size_t;
+
+  /** @return the number of nodes and leaves retired but not freed yet */
+  auto NumRetired() const -> size_t {
+    std::scoped_lock lock(retired_latch_);
+    return retired_.size();
+  }
+
+ private:
+  struct Leaf {
+    std::string key_;
+    ValueType value_;
+  };
+
+  /** The epoch announced by an operation in flight, 0 when the slot is free. One cache line each. */
+  struct alignas(64) EpochSlot {
+    std::atomic<uint64_t> epoch_{0};
+  };
+
+  /** Announces an epoch for as long as the operation may read nodes and leaves. */
+  class OperationGuard {
+   public:
+    explicit OperationGuard(const AdaptiveRadixTree *tree) : tree_(tree), slot_(tree_->BeginOperation()) {}
+    ~OperationGuard() { tree_->EndOperation(slot_); }
+    DISALLOW_COPY_AND_MOVE(OperationGuard);
+
+   private:
+    const AdaptiveRadixTree *tree_;
+    EpochSlot *slot_;
+  };
+
+  /** Operations beyond this many at once wait for a free slot */
+  static constexpr size_t NUM_EPOCH_SLOTS = 64;
+
+  static auto AsLeaf(const ArtNode *child) -> Leaf * { return static_cast<Leaf *>(ArtNode::UntagLeaf(child)); }
+
+  /*
+   * Each Try* runs an operation once, returning false if a concurrent writer
+   * got in its way and it has to restart from the root.
+   */
+  auto TryGet(std::string_view key, std::optional<ValueType> *result) const -> bool;
+  auto TryInsert(std::string_view key, Leaf *leaf, bool overwrite, bool *inserted) -> bool;
+  auto TryRemove(std::string_view key, bool *removed) -> bool;
+  auto InsertLeaf(std::string_view key, Leaf *leaf, bool overwrite) -> bool;
+
+  /**
+   * Read the whole prefix of a node, finding the bytes it does not store in a leaf below it.
+   * @param depth the position of the prefix in the keys below the node
+   * @param[out] prefix the prefix
+   * @return false if the node changed since `version`
+   */
+  auto ReadFullPrefix(const ArtNode *node, uint64_t version, size_t depth, std::string *prefix) const -> bool;
+
+  /** Hand a node or leaf unlinked from the tree over to be freed once no operation can reach it. */
+  void Retire(ArtNode *child);
+  /** @return the slot in which the calling thread announced the current epoch */
+  auto BeginOperation() const -> EpochSlot *;
+  void EndOperation(EpochSlot *slot) const;
+  /** Advance the epoch if no operation is left in an older one, and free what can no longer be reached. */
+  void Reclaim() const;
+
+  static void FreeChild(ArtNode *child);
+  /** Free a node and everything below it. */
+  static void FreeSubtree(ArtNode *child);
+  static auto SubtreeMemoryUsage(const ArtNode *child) -> size_t;
+
+  /** A Node256 that is never replaced, so that writers always have a parent to lock */
+  ArtNode *root_;
+  std::atomic<size_t> size_{0};
+
+  /** Starts at 1, as 0 marks a free slot; only advanced under retired_latch_ */
+  mutable std::atomic<uint64_t> global_epoch_{1};
+  mutable std::array<EpochSlot, NUM_EPOCH_SLOTS> epoch_slots_;
+  mutable std::atomic<size_t> num_retired_{0};
+  /** Protects retired_ */
+  mutable std::mutex retired_latch_;
+  /** The nodes and leaves retired, with the epoch they were retired in, oldest first */
+  mutable std::deque<std::pair<uint64_t, ArtNode *>> retired_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,186 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// art_node.h
+//
+// Identification: src/include/container/art/art_node.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/** Prefix bytes an ART node stores itself, longer prefixes are only checked against the key in the leaf. */
+static constexpr uint32_t ART_MAX_PREFIX_LEN = 8;
+
+/** The adaptive node sizes, named after the number of children they hold. */
+enum class ArtNodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+/**
+ * An inner node of an adaptive radix tree. The node holds the bytes that all keys below it share past its parent
+ * (path compression) and one child per distinct next byte, in the smallest of four layouts that fits them:
+ *
+ * - Node4 and Node16 keep sorted parallel arrays of bytes and children. Node16 is searched with one SSE2 comparison.
+ * - Node48 maps each byte to one of 48 child slots.
+ * - Node256 is indexed by the byte directly.
+ *
+ * A child is either another node or, with the lowest bit of the pointer set, a leaf. Leaves belong to the tree, which
+ * knows their type. A key that ends where the node starts branching is kept in `value_` instead of a child.
+ *
+ * Every node carries a version for optimistic lock coupling. Readers never write the node: they read its version,
+ * read the node, and check the version again before they trust what they read or follow a child. Writers lock the
+ * node by upgrading the version they read, so that the node cannot have changed since. A node that is replaced is
+ * marked obsolete, readers that still reach it restart from the root.
+ */
+class ArtNode {
+ public:
+  /** @return a new empty node of the type, unlocked */
+  static auto New(ArtNodeType type) -> ArtNode *;
+
+  /** Free a node, but not its children. */
+  static void Delete(ArtNode *node);
+
+  DISALLOW_COPY_AND_MOVE(ArtNode);
+
+  static auto IsLeaf(const ArtNode *child) -> bool { return (reinterpret_cast<uintptr_t>(child) & 1) != 0; }
+
+  /** @return the child that refers to a leaf */
+  static auto TagLeaf(void *leaf) -> ArtNode * {
+    return reinterpret_cast<ArtNode *>(reinterpret_cast<uintptr_t>(leaf) | 1);
+  }
+
+  /** @return the leaf a child refers to */
+  static auto UntagLeaf(const ArtNode *child) -> void * {
+    return reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(child) & ~static_cast<uintptr_t>(1));
+  }
+
+  /*****************************************************************************
+   * VERSION LOCK
+   *****************************************************************************/
+
+  /**
+   * Start reading the node, waiting for a writer that holds it.
+   * @param[out] version the version to check the reads against
+   * @return false if the node is obsolete and the operation must restart
+   */
+  auto ReadLock(uint64_t *version) const -> bool;
+
+  /** @return true if the node did not change since `version` was read, so that what was read of it is consistent */
+  auto Validate(uint64_t version) const -> bool { return version_.load() == version; }
+
+  /** Lock the node for writing if it did not change since `version` was read. @return false if it did */
+  auto Upgrade(uint64_t version) -> bool;
+
+  /** Lock the node for writing, waiting for the writer that holds it. @return false if the node became obsolete */
+  auto WriteLock() -> bool;
+
+  void WriteUnlock() { version_.fetch_add(LOCKED_BIT); }
+
+  /** Unlock a node that has been unlinked from the tree. */
+  void WriteUnlockObsolete() { version_.fetch_add(LOCKED_BIT | OBSOLETE_BIT); }
+
+  /*****************************************************************************
+   * CHILDREN
+   *****************************************************************************/
+
+  /**
+   * Find the child of the byte. Safe to call while a writer changes the node, the result is only to be trusted once
+   * the version is validated.
+   * @return the child, or nullptr if there is none
+   */
+  auto FindChild(uint8_t byte) const -> ArtNode *;
+
+  /** @return true if another child needs a larger node */
+  auto IsFull() const -> bool;
+
+  /** @return true if removing a child should move the node to a smaller type */
+  auto ShouldShrink() const -> bool;
+
+  /** Add a child for a byte that has none. The node must not be full. */
+  void InsertChild(uint8_t byte, ArtNode *child);
+
+  /** Replace the child of a byte that has one. */
+  void ReplaceChild(uint8_t byte, ArtNode *child);
+
+  void RemoveChild(uint8_t byte);
+
+  auto NumChildren() const -> uint32_t { return num_children_; }
+
+  /** @param[out] children the children with their bytes, in byte order */
+  void GetChildren(std::vector<std::pair<uint8_t, ArtNode *>> *children) const;
+
+  /** @return a copy of the node in the next larger type */
+  auto Grow() const -> ArtNode *;
+
+  /** @return a copy of the node in the next smaller type, which must be able to hold its children */
+  auto Shrink() const -> ArtNode *;
+
+  /** @return the size of the node in memory */
+  auto MemoryUsage() const -> size_t;
+
+  /** Set the prefix to `len` bytes, of which only the first ART_MAX_PREFIX_LEN are read from `bytes`. */
+  void SetPrefix(const char *bytes, uint32_t len);
+
+  ArtNodeType type_;
+  uint32_t prefix_len_{0};
+  uint8_t prefix_[ART_MAX_PREFIX_LEN]{};
+  /** The leaf of the key that ends at this node, if any */
+  ArtNode *value_{nullptr};
+
+ protected:
+  explicit ArtNode(ArtNodeType type) : type_(type) {}
+  ~ArtNode() = default;
+
+  static constexpr uint64_t OBSOLETE_BIT = 1;
+  static constexpr uint64_t LOCKED_BIT = 2;
+
+  /** Copy the prefix and the value of another node. */
+  void CopyHeader(const ArtNode &other);
+
+  std::atomic<uint64_t> version_{0};
+  uint16_t num_children_{0};
+};
+
+class ArtNode4 : public ArtNode {
+ public:
+  static constexpr uint32_t CAPACITY = 4;
+  ArtNode4() : ArtNode(ArtNodeType::NODE4) {}
+  uint8_t keys_[CAPACITY]{};
+  ArtNode *children_[CAPACITY]{};
+};
+
+class ArtNode16 : public ArtNode {
+ public:
+  static constexpr uint32_t CAPACITY = 16;
+  ArtNode16() : ArtNode(ArtNodeType::NODE16) {}
+  uint8_t keys_[CAPACITY]{};
+  ArtNode *children_[CAPACITY]{};
+};
+
+class ArtNode48 : public ArtNode {
+ public:
+  static constexpr uint32_t CAPACITY = 48;
+  /** Marks the bytes without a child in `child_index_` */
+  static constexpr uint8_t EMPTY = CAPACITY;
+  ArtNode48();
+  uint8_t child_index_[256];
+  ArtNode *children_[CAPACITY]{};
+};
+
+class ArtNode256 : public ArtNode {
+ public:
+  static constexpr uint32_t CAPACITY = 256;
+  ArtNode256() : ArtNode(ArtNodeType::NODE256) {}
+  ArtNode *children_[CAPACITY]{};
+};
+
+}  // namespace bustub
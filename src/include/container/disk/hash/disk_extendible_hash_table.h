@@ -124,7 +124,7 @@ class DiskExtendibleHashTable {
   /**
    * Fetches the directory page from the buffer pool manager.
    *
-   * @return a pointer to the directory page
+   * @return a pointer to the directory page, nullptr if the buffer pool has no frame for it
    */
   auto FetchDirectoryPage() -> HashTableDirectoryPage *;
 
@@ -132,10 +132,28 @@ class DiskExtendibleHashTable {
    * Fetches the a bucket page from the buffer pool manager using the bucket's page_id.
    *
    * @param bucket_page_id the page_id to fetch
-   * @return a pointer to a bucket page
+   * @return a pointer to a bucket page, nullptr if the buffer pool has no frame for it
    */
   auto FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE *;
 
+  /**
+   * Allocate a page and clear it.
+   *
+   * @param[out] page_id the id of the new page
+   * @param what the error message if the buffer pool is full
+   * @return the data of the new page, pinned
+   */
+  auto NewZeroedPage(page_id_t *page_id, const std::string &what) -> char *;
+
+  /**
+   * Allocate an empty bucket page, with no overflow page after it.
+   *
+   * @param[out] page_id the id of the new page
+   * @param what the error message if the buffer pool is full
+   * @return the new bucket page, pinned
+   */
+  auto NewBucketPage(page_id_t *page_id, const std::string &what) -> HASH_TABLE_BUCKET_TYPE *;
+
   /**
    * Performs insertion with an optional bucket splitting.
    *
@@ -146,6 +164,29 @@ class DiskExtendibleHashTable {
    */
   auto SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool;
 
+  /**
+   * Inserts into a bucket that cannot be split, putting the pair into an overflow page of the bucket. The caller holds
+   * the table latch exclusively and has checked the first page of the bucket for the pair.
+   *
+   * @param bucket_page_id the page_id of the first page of the bucket
+   * @param bucket the first page of the bucket, pinned by the caller and unpinned here
+   * @param key the key to insert
+   * @param value the value to insert
+   * @return false if the pair is already in the bucket
+   */
+  auto ChainInsert(page_id_t bucket_page_id, HASH_TABLE_BUCKET_TYPE *bucket, const KeyType &key,
+                   const ValueType &value) -> bool;
+
+  /**
+   * Removes a pair from a bucket that has overflow pages, under the exclusive table latch.
+   *
+   * @param transaction a pointer to the current transaction
+   * @param key the key to delete
+   * @param value the value to delete
+   * @return true if remove succeeded, false otherwise
+   */
+  auto ChainRemove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool;
+
   /**
    * Optionally merges an empty bucket into it's pair.  This is called by Remove,
    * if Remove makes a bucket empty.
@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.h
+//
+// Identification: src/include/execution/compiled_expression.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/data_chunk.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/filter_kernels.h"
+#include "type/type_id.h"
+
+namespace bustub {
+
+/**
+ * An expression tree compiled once into a flat register program that evaluates a whole DataChunk at a time.
+ *
+ * Each instruction runs a kernel, a loop specialized for the C++ type of its operands, over all the rows of the chunk.
+ * Column operands are read in place from the chunk, constants are broadcast into a register at compile time, and
+ * the other nodes write their results into registers of their own. A NULL is the NULL sentinel of the type (see
+ * type/limits.h), so that kernels propagate NULLs without looking at the validity bitmaps, which are rebuilt once
+ * per instruction.
+ *
+ * Integer arithmetic, comparisons of two operands of the same fixed-size type and AND/OR are compiled; comparisons of
+ * INTEGER and BIGINT and AND/OR run on the SIMD kernels of GetFilterKernels(). Any other node (strings, comparisons of
+ * mixed types) is evaluated row by row with AbstractExpression::EvaluateAt() into its register, and the rest of the
+ * program still runs compiled around it.
+ */
+class CompiledExpression {
+ public:
+  /**
+   * Compile an expression over the rows of `input_schema`.
+   * @param expr the expression, which must outlive the compiled expression
+   * @param input_schema the schema of the chunks that the expression is evaluated over
+   */
+  CompiledExpression(const AbstractExpression &expr, const Schema &input_schema);
+
+  /** @return the type of the values of the expression */
+  auto GetReturnType() const -> TypeId { return result_type_; }
+
+  /**
+   * Evaluate the expression for the rows of a chunk.
+   * @return the column of the results, indexed by the physical row of the chunk; it is valid until the next call
+   */
+  auto Evaluate(const DataChunk &chunk) -> const ColumnVector &;
+
+  /** Narrow the selection of a chunk to the rows for which the expression, a predicate, is true. */
+  void Filter(DataChunk *chunk);
+
+ private:
+  enum class OpCode : uint8_t {
+    Add,
+    Subtract,
+    /** Compare with `comp_type_` */
+    Compare,
+    And,
+    Or,
+    /** Evaluate `expr_` row by row */
+    Interpret,
+  };
+
+  /** An operand is a column of the input chunk or a register. */
+  struct Operand {
+    bool is_column_;
+    uint32_t index_;
+    TypeId type_;
+  };
+
+  struct Instruction {
+    OpCode op_;
+    ComparisonType comp_type_;
+    uint32_t dest_;
+    Operand lhs_;
+    Operand rhs_;
+    const AbstractExpression *expr_;
+  };
+
+  /** Emit the instructions of `expr` and its children. @return the operand that holds its result */
+  auto Compile(const AbstractExpression &expr, const Schema &input_schema) -> Operand;
+
+  /** @return a new register of `type` */
+  auto NewRegister(TypeId type) -> Operand;
+
+  auto Resolve(const DataChunk &chunk, const Operand &operand) const -> const ColumnVector & {
+    return operand.is_column_ ? chunk.GetColumn(operand.index_) : registers_[operand.index_];
+  }
+
+  void Execute(const Instruction &instruction, const DataChunk &chunk);
+
+  std::vector<Instruction> program_;
+  std::vector<ColumnVector> registers_;
+  Operand result_;
+  TypeId result_type_;
+  const FilterKernels &kernels_;
+  /** The positions of the rows that Filter() keeps */
+  std::vector<uint32_t> selected_;
+};
+
+}  // namespace bustub
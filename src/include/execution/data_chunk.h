@@ -0,0 +1,168 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// data_chunk.h
+//
+// Identification: src/include/execution/data_chunk.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/macros.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * The values of one column for the rows of a DataChunk.
+ *
+ * Fixed-size types are stored as a contiguous array of their C++ type (int8_t for BOOLEAN and TINYINT, int16_t,
+ * int32_t, int64_t, double for DECIMAL and uint64_t for TIMESTAMP), which GetData() hands out for tight loops.
+ * VARCHARs are stored as strings. A bitmap records which rows are valid, i.e. not NULL. A NULL row of a fixed-size
+ * type also holds the type's NULL sentinel (see type/limits.h), as Value does.
+ */
+class ColumnVector {
+ public:
+  /** Create a column of `capacity` rows. */
+  ColumnVector(TypeId type, size_t capacity);
+
+  auto GetType() const -> TypeId { return type_; }
+  auto GetCapacity() const -> size_t { return capacity_; }
+  /** @return the size of the C++ type of a fixed-size column, 0 for VARCHAR */
+  auto GetWidth() const -> size_t { return width_; }
+
+  /** @return the array of values of a fixed-size column, of the C++ type of the column */
+  template <typename T>
+  auto GetData() -> T * {
+    return reinterpret_cast<T *>(data_.data());
+  }
+  template <typename T>
+  auto GetData() const -> const T * {
+    return reinterpret_cast<const T *>(data_.data());
+  }
+
+  /** @return the validity bitmap, a word of 64 rows at a time */
+  auto GetValidity() -> uint64_t * { return validity_.data(); }
+  auto GetValidity() const -> const uint64_t * { return validity_.data(); }
+
+  auto IsValid(size_t row) const -> bool { return ((validity_[row / 64] >> (row % 64)) & 1) != 0; }
+
+  void SetValid(size_t row, bool valid) {
+    if (valid) {
+      validity_[row / 64] |= uint64_t{1} << (row % 64);
+    } else {
+      validity_[row / 64] &= ~(uint64_t{1} << (row % 64));
+    }
+  }
+
+  /** @return the value of a VARCHAR row, with the trailing '\0' that Value keeps */
+  auto GetString(size_t row) const -> const std::string & { return strings_[row]; }
+
+  /** @return the value of a row as a Value */
+  auto GetValue(size_t row) const -> Value;
+
+  /** Set the value of a row, which must be of the type of the column. */
+  void SetValue(size_t row, const Value &value);
+
+  /** Set the value of a row to the value of row `source_row` of `source`, a column of the same type. */
+  void CopyRow(size_t row, const ColumnVector &source, size_t source_row);
+
+  /** Set the value of a row to the serialized column `column` of a table tuple. */
+  void SetFromTuple(size_t row, const Tuple &tuple, const Column &column);
+
+  /** Set the value of a row of a fixed-size column to the bytes of its C++ type, NULL if they are the NULL sentinel. */
+  void SetFromBytes(size_t row, const char *bytes);
+
+  /** Set the value of a row of a VARCHAR column to `length` bytes, NULL if `length` is BUSTUB_VALUE_NULL. */
+  void SetString(size_t row, const char *data, uint32_t length);
+
+ private:
+  TypeId type_;
+  size_t capacity_;
+  /** The size of the C++ type of a fixed-size column, 0 for VARCHAR */
+  size_t width_;
+  /** The values of a fixed-size column, in words so that any of the C++ types is aligned */
+  std::vector<uint64_t> data_;
+  /** The values of a VARCHAR column */
+  std::vector<std::string> strings_;
+  /** Bit `row` is set if the row is not NULL */
+  std::vector<uint64_t> validity_;
+};
+
+/**
+ * A DataChunk is the columnar unit of data that executors exchange through NextBatch(): one ColumnVector per column
+ * of the output schema, holding up to BUSTUB_BATCH_SIZE rows, and the RID of each row.
+ *
+ * A chunk may carry a selection vector, the ascending list of the rows that are part of the chunk, so that a filter
+ * drops rows without moving the others. Size() and RowAt() go through the selection; columns are always indexed by
+ * the physical row.
+ *
+ * Tuples only come in at the table boundary (AppendTuple()) and go out at the result boundary (GetTuple()).
+ */
+class DataChunk {
+ public:
+  DataChunk() = default;
+
+  DISALLOW_COPY(DataChunk);
+
+  /** Empty the chunk and set it up for the rows of `schema`, which must outlive the chunk. */
+  void Reset(const Schema *schema);
+
+  auto GetSchema() const -> const Schema * { return schema_; }
+
+  /** @return the number of rows, selected or not */
+  auto Count() const -> size_t { return count_; }
+
+  /** @return the number of selected rows */
+  auto Size() const -> size_t { return has_selection_ ? selection_.size() : count_; }
+
+  auto IsEmpty() const -> bool { return Size() == 0; }
+
+  /** @return true if no more rows can be appended */
+  auto IsFull() const -> bool { return count_ == BUSTUB_BATCH_SIZE; }
+
+  /** @return the physical row of the i-th selected row */
+  auto RowAt(size_t i) const -> size_t { return has_selection_ ? selection_[i] : i; }
+
+  /** Keep only the selected rows at the positions in `positions`, which must be ascending. */
+  void Select(const std::vector<uint32_t> &positions);
+
+  /** Keep only the first `size` selected rows. */
+  void Truncate(size_t size);
+
+  auto GetColumn(size_t column) -> ColumnVector & { return columns_[column]; }
+  auto GetColumn(size_t column) const -> const ColumnVector & { return columns_[column]; }
+
+  auto GetValue(size_t column, size_t row) const -> Value { return columns_[column].GetValue(row); }
+
+  auto GetRID(size_t row) const -> RID { return rids_[row]; }
+
+  /** Append a row whose columns the caller then sets. @return the physical row */
+  auto AppendRow(RID rid) -> size_t;
+
+  /** Append a table tuple of the chunk's schema. */
+  void AppendTuple(const Tuple &tuple, RID rid);
+
+  /** @return the physical row as a tuple of the chunk's schema */
+  auto GetTuple(size_t row) const -> Tuple;
+
+ private:
+  const Schema *schema_{nullptr};
+  std::vector<ColumnVector> columns_;
+  std::vector<RID> rids_;
+  size_t count_{0};
+  bool has_selection_{false};
+  std::vector<uint32_t> selection_;
+};
+
+}  // namespace bustub
@@ -94,11 +94,12 @@ class ExecutionEngine {
    */
   static void PollExecutor(AbstractExecutor *executor, const AbstractPlanNodeRef &plan,
                            std::vector<Tuple> *result_set) {
-    RID rid{};
-    Tuple tuple{};
-    while (executor->Next(&tuple, &rid)) {
+    DataChunk chunk;
+    while (executor->NextBatch(&chunk)) {
       if (result_set != nullptr) {
-        result_set->push_back(tuple);
+        for (size_t i = 0; i < chunk.Size(); i++) {
+          result_set->push_back(chunk.GetTuple(chunk.RowAt(i)));
+        }
       }
     }
   }
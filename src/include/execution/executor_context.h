@@ -93,6 +93,36 @@ class ExecutorContext {
 
   auto IsDelete() const -> bool { return is_delete_; }
 
+  /** @return the number of bytes that the hash table of a hash join may take before the join spills to disk */
+  auto GetHashJoinMemoryBudget() const -> size_t { return hash_join_memory_budget_; }
+
+  void SetHashJoinMemoryBudget(size_t budget) { hash_join_memory_budget_ = budget; }
+
+  /** @return the number of bytes of a hash join table above which the join radix-partitions it to fit in cache */
+  auto GetHashJoinCacheSize() const -> size_t { return hash_join_cache_size_; }
+
+  void SetHashJoinCacheSize(size_t size) { hash_join_cache_size_ = size; }
+
+  /** @return the number of rows that the runtime filters of hash joins dropped from the scans of the query */
+  auto GetRuntimeFilterRowsEliminated() const -> size_t { return runtime_filter_rows_eliminated_; }
+
+  void AddRuntimeFilterRowsEliminated(size_t count) { runtime_filter_rows_eliminated_ += count; }
+
+  /** @return the number of bytes of rows that the hash joins of the query wrote to temporary files */
+  auto GetHashJoinSpilledBytes() const -> size_t { return hash_join_spilled_bytes_; }
+
+  void AddHashJoinSpilledBytes(size_t bytes) { hash_join_spilled_bytes_ += bytes; }
+
+  /** @return the number of pairs of partitions that the hash joins of the query spilled their inputs into */
+  auto GetHashJoinSpilledPartitions() const -> size_t { return hash_join_spilled_partitions_; }
+
+  void AddHashJoinSpilledPartitions(size_t count) { hash_join_spilled_partitions_ += count; }
+
+  /** @return the number of spilled partitions that did not fit in memory and were partitioned again */
+  auto GetHashJoinRepartitions() const -> size_t { return hash_join_repartitions_; }
+
+  void AddHashJoinRepartitions(size_t count) { hash_join_repartitions_ += count; }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -109,6 +139,12 @@ class ExecutorContext {
   /** The set of check options associated with this executor context */
   std::shared_ptr<CheckOptions> check_options_;
   bool is_delete_;
+  size_t hash_join_memory_budget_{HASH_JOIN_MEMORY_BUDGET};
+  size_t hash_join_cache_size_{HASH_JOIN_CACHE_SIZE};
+  size_t runtime_filter_rows_eliminated_{0};
+  size_t hash_join_spilled_bytes_{0};
+  size_t hash_join_spilled_partitions_{0};
+  size_t hash_join_repartitions_{0};
 };
 
 }  // namespace bustub
@@ -12,15 +12,21 @@
 
 #pragma once
 
+#include "execution/data_chunk.h"
 #include "execution/executor_context.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 class ExecutorContext;
+class RuntimeFilter;
 /**
  * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
  * This is the base class from which all executors in the BustTub execution
  * engine inherit, and defines the minimal interface that all executors support.
+ *
+ * Executors can also produce a columnar DataChunk of rows at a time through
+ * NextBatch(), which by default pulls the tuples from Next() one by one. A parent
+ * drives a child either by Next() or by NextBatch() for the whole of a run, not both.
  */
 class AbstractExecutor {
  public:
@@ -47,6 +53,30 @@ class AbstractExecutor {
    */
   virtual auto Next(Tuple *tuple, RID *rid) -> bool = 0;
 
+  /**
+   * Yield the next chunk of rows from this executor. Executors that can produce
+   * many rows for less than many calls to Next() override this.
+   * @param[out] chunk The chunk, reset to the output schema and filled with up to BUSTUB_BATCH_SIZE rows
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  virtual auto NextBatch(DataChunk *chunk) -> bool {
+    chunk->Reset(&GetOutputSchema());
+    Tuple tuple{};
+    RID rid{};
+    while (!chunk->IsFull() && Next(&tuple, &rid)) {
+      chunk->AppendTuple(tuple, rid);
+    }
+    return !chunk->IsEmpty();
+  }
+
+  /**
+   * Take a runtime filter that a hash join above this executor built over its build side, and drop the rows that it
+   * rules out from the chunks of NextBatch(). Scans accept it, other executors do not.
+   * @param filter the filter, owned by the join, whose key expressions are over the output schema of this executor
+   * @return `true` if the executor applies the filter
+   */
+  virtual auto SetRuntimeFilter(RuntimeFilter *filter) -> bool { return false; }
+
   /** @return The schema of the tuples that this executor produces */
   virtual auto GetOutputSchema() const -> const Schema & = 0;
 
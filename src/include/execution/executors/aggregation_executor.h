@@ -12,13 +12,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "common/util/hash_util.h"
 #include "container/hash/hash_function.h"
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
@@ -30,9 +33,17 @@ namespace bustub {
 
 /**
  * A simplified hash table that has all the necessary functionality for aggregations.
+ *
+ * The groups are kept in a vector in the order they were first seen. The directory is a flat array of 64-bit slots,
+ * probed linearly and kept at most half full, each holding the index of a group plus one and a 16-bit tag taken from
+ * the top of its hash, like that of JoinHashTable, so that slots of other groups are almost always skipped without
+ * touching their keys.
  */
 class SimpleAggregationHashTable {
  public:
+  /** The number of keys of InsertCombineBatch() whose cache misses overlap */
+  static constexpr size_t PROBE_GROUP_SIZE = 16;
+
   /**
    * Construct a new SimpleAggregationHashTable instance.
    * @param agg_exprs the aggregation expressions
@@ -126,28 +137,66 @@ class SimpleAggregationHashTable {
    * @param agg_val the value to be inserted
    */
   void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
-    if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
+    Reserve(groups_.size() + 1);
+    CombineAggregateValues(&groups_[FindOrInsert(Hash(agg_key), agg_key)].val_, agg_val);
+  }
+
+  /**
+   * Inserts the values of a chunk, combining each with the current aggregation of its key. The keys are inserted in
+   * groups of PROBE_GROUP_SIZE: the hashes of a group are computed and their slots prefetched, then the groups that the
+   * slots point to, and only then are the keys compared, so that a group waits for its cache misses once instead of
+   * once per key.
+   * @param agg_keys the keys to be inserted
+   * @param agg_vals the values to be inserted, by position of their key
+   */
+  void InsertCombineBatch(const std::vector<AggregateKey> &agg_keys, const std::vector<AggregateValue> &agg_vals) {
+    std::array<hash_t, PROBE_GROUP_SIZE> hashes;
+    for (size_t begin = 0; begin < agg_keys.size(); begin += PROBE_GROUP_SIZE) {
+      size_t count = std::min(PROBE_GROUP_SIZE, agg_keys.size() - begin);
+      // every key of the group may add a group, and the slots must not move while they are prefetched
+      Reserve(groups_.size() + count);
+      for (size_t i = 0; i < count; i++) {
+        hashes[i] = Hash(agg_keys[begin + i]);
+        __builtin_prefetch(&slots_[FirstSlot(hashes[i])]);
+      }
+      for (size_t i = 0; i < count; i++) {
+        uint64_t existing = slots_[FirstSlot(hashes[i])];
+        if (existing != 0 && Tag(existing) == Tag(hashes[i])) {
+          __builtin_prefetch(&groups_[(existing & SLOT_OFFSET_MASK) - 1]);
+        }
+      }
+      for (size_t i = 0; i < count; i++) {
+        CombineAggregateValues(&groups_[FindOrInsert(hashes[i], agg_keys[begin + i])].val_, agg_vals[begin + i]);
+      }
     }
-    CombineAggregateValues(&ht_[agg_key], agg_val);
   }
 
   /**
    * Clear the hash table
    */
-  void Clear() { ht_.clear(); }
+  void Clear() {
+    groups_.clear();
+    slots_.clear();
+  }
+
+  /** A group of the hash table: the hash of its key, its key and its aggregation */
+  struct Group {
+    hash_t hash_;
+    AggregateKey key_;
+    AggregateValue val_;
+  };
 
   /** An iterator over the aggregation hash table */
   class Iterator {
    public:
-    /** Creates an iterator for the aggregate map. */
-    explicit Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter) : iter_{iter} {}
+    /** Creates an iterator for the aggregate groups. */
+    explicit Iterator(std::vector<Group>::const_iterator iter) : iter_{iter} {}
 
     /** @return The key of the iterator */
-    auto Key() -> const AggregateKey & { return iter_->first; }
+    auto Key() -> const AggregateKey & { return iter_->key_; }
 
     /** @return The value of the iterator */
-    auto Val() -> const AggregateValue & { return iter_->second; }
+    auto Val() -> const AggregateValue & { return iter_->val_; }
 
     /** @return The iterator before it is incremented */
     auto operator++() -> Iterator & {
@@ -162,19 +211,73 @@ class SimpleAggregationHashTable {
     auto operator!=(const Iterator &other) -> bool { return this->iter_ != other.iter_; }
 
    private:
-    /** Aggregates map */
-    std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter_;
+    /** Aggregate groups */
+    std::vector<Group>::const_iterator iter_;
   };
 
   /** @return Iterator to the start of the hash table */
-  auto Begin() -> Iterator { return Iterator{ht_.cbegin()}; }
+  auto Begin() -> Iterator { return Iterator{groups_.cbegin()}; }
 
   /** @return Iterator to the end of the hash table */
-  auto End() -> Iterator { return Iterator{ht_.cend()}; }
+  auto End() -> Iterator { return Iterator{groups_.cend()}; }
 
  private:
-  /** The hash table is just a map from aggregate keys to aggregate values */
-  std::unordered_map<AggregateKey, AggregateValue> ht_{};
+  /** The bits of a slot that hold the index of the group plus one, so that an empty slot is 0 */
+  static constexpr uint64_t SLOT_OFFSET_MASK = (uint64_t{1} << 48) - 1;
+
+  static auto Tag(hash_t hash) -> uint64_t { return hash & ~SLOT_OFFSET_MASK; }
+
+  /** @return the hash of a key, to which its NULL values do not contribute */
+  static auto Hash(const AggregateKey &agg_key) -> hash_t {
+    hash_t hash = 0;
+    for (const auto &value : agg_key.group_bys_) {
+      hash = HashUtil::MixHash(hash ^ (value.IsNull() ? 0 : HashUtil::HashValue(&value)));
+    }
+    return hash;
+  }
+
+  /** @return the index in `slots_` of the first slot that a probe for `hash` looks at */
+  auto FirstSlot(hash_t hash) const -> uint64_t { return hash & (slots_.size() - 1); }
+
+  /** Grow the directory so that it holds `group_count` groups while at most half full. */
+  void Reserve(size_t group_count) {
+    if (group_count * 2 <= slots_.size()) {
+      return;
+    }
+    size_t capacity = std::max<size_t>(16, slots_.size());
+    while (capacity < group_count * 2) {
+      capacity *= 2;
+    }
+    slots_.assign(capacity, 0);
+    for (size_t index = 0; index < groups_.size(); index++) {
+      uint64_t slot = FirstSlot(groups_[index].hash_);
+      while (slots_[slot] != 0) {
+        slot = (slot + 1) & (capacity - 1);
+      }
+      slots_[slot] = Tag(groups_[index].hash_) | (index + 1);
+    }
+  }
+
+  /** @return the index of the group of `agg_key`, which is added with the initial aggregation if there is none */
+  auto FindOrInsert(hash_t hash, const AggregateKey &agg_key) -> size_t {
+    for (uint64_t slot = FirstSlot(hash);; slot = (slot + 1) & (slots_.size() - 1)) {
+      uint64_t existing = slots_[slot];
+      if (existing == 0) {
+        groups_.push_back({hash, agg_key, GenerateInitialAggregateValue()});
+        slots_[slot] = Tag(hash) | groups_.size();
+        return groups_.size() - 1;
+      }
+      size_t index = (existing & SLOT_OFFSET_MASK) - 1;
+      if (Tag(existing) == Tag(hash) && groups_[index].hash_ == hash && groups_[index].key_ == agg_key) {
+        return index;
+      }
+    }
+  }
+
+  /** The groups, in the order they were first seen */
+  std::vector<Group> groups_{};
+  /** The directory of the groups, whose size is a power of two */
+  std::vector<uint64_t> slots_{};
   /** The aggregate expressions that we have */
   const std::vector<AbstractExpressionRef> &agg_exprs_;
   /** The types of aggregations that we have */
@@ -207,6 +310,13 @@ class AggregationExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next chunk of aggregated rows.
+   * @param[out] chunk The next chunk of rows, one per group
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  auto NextBatch(DataChunk *chunk) -> bool override;
+
   /** @return The output schema for the aggregation */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
@@ -232,6 +342,24 @@ class AggregationExecutor : public AbstractExecutor {
     return {vals};
   }
 
+  /** @return The row of the columns of evaluated expressions as an AggregateKey */
+  auto MakeAggregateKey(const std::vector<const ColumnVector *> &group_bys, size_t row) -> AggregateKey {
+    std::vector<Value> keys;
+    for (const auto *column : group_bys) {
+      keys.emplace_back(column->GetValue(row));
+    }
+    return {keys};
+  }
+
+  /** @return The row of the columns of evaluated expressions as an AggregateValue */
+  auto MakeAggregateValue(const std::vector<const ColumnVector *> &aggregates, size_t row) -> AggregateValue {
+    std::vector<Value> vals;
+    for (const auto *column : aggregates) {
+      vals.emplace_back(column->GetValue(row));
+    }
+    return {vals};
+  }
+
  private:
   /** The aggregation plan node */
   const AggregationPlanNode *plan_;
@@ -243,6 +371,9 @@ class AggregationExecutor : public AbstractExecutor {
   /** Simple aggregation hash table iterator */
   // TODO(Student): Uncomment SimpleAggregationHashTable::Iterator aht_iterator_;
   SimpleAggregationHashTable::Iterator aht_iterator_;
+  /** The group-by and aggregate expressions, compiled for the chunks of the child */
+  std::vector<CompiledExpression> group_bys_;
+  std::vector<CompiledExpression> aggregates_;
   bool done_{false};
 };
 }  // namespace bustub
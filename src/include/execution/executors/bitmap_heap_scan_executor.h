@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bitmap_heap_scan_executor.h
+//
+// Identification: src/include/execution/executors/bitmap_heap_scan_executor.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/rid.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/bitmap_heap_scan_plan.h"
+#include "execution/scan_locks.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * BitmapHeapScanExecutor looks up a key range in an index, sorts the matching RIDs by page and then reads every
+ * table page once, emitting all the matching tuples it holds.
+ */
+class BitmapHeapScanExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new bitmap heap scan executor.
+   * @param exec_ctx the executor context
+   * @param plan the bitmap heap scan plan to be executed
+   */
+  BitmapHeapScanExecutor(ExecutorContext *exec_ctx, const BitmapHeapScanPlanNode *plan);
+
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+  void Init() override;
+
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+ private:
+  /** Read the next page that holds matching RIDs into `tuples_`. @return false once all pages have been read */
+  auto FetchNextPage() -> bool;
+
+  /** The bitmap heap scan plan node to be executed. */
+  const BitmapHeapScanPlanNode *plan_;
+  const IndexInfo *index_info_;
+  TableHeap *tbl_heap_;
+  /** The table and row locks the scan takes for its transaction */
+  ScanLocks locks_;
+  /** The RIDs found in the index, sorted by page and slot */
+  std::vector<RID> rids_;
+  /** The first RID of `rids_` on a page that has not been read yet */
+  size_t next_rid_{0};
+  /** The live tuples of the last page read */
+  std::vector<Tuple> tuples_;
+  size_t cursor_{0};
+};
+}  // namespace bustub
@@ -15,6 +15,7 @@
 #include <memory>
 #include <vector>
 
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/filter_plan.h"
@@ -48,6 +49,13 @@ class FilterExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next chunk of rows from the filter, narrowing the selection of the chunks of the child.
+   * @param[out] chunk The next chunk of rows that satisfy the predicate
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  auto NextBatch(DataChunk *chunk) -> bool override;
+
   /** @return The output schema for the filter plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -57,5 +65,8 @@ class FilterExecutor : public AbstractExecutor {
 
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The predicate, compiled for the chunks of the child */
+  CompiledExpression predicate_;
 };
 }  // namespace bustub
@@ -13,110 +13,37 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
+#include <optional>
 #include <utility>
 #include <vector>
 
-#include "common/util/hash_util.h"
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/join_hash_table.h"
 #include "execution/plans/hash_join_plan.h"
+#include "execution/runtime_filter.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 namespace bustub {
-struct HashJoinKey {
-  /** The group-by values */
-  std::vector<Value> hash_key_;
 
-  /**
-   * Compares two aggregate keys for equality.
-   * @param other the other aggregate key to be compared with
-   * @return `true` if both aggregate keys have equivalent group-by expressions, `false` otherwise
-   */
-  auto operator==(const HashJoinKey &other) const -> bool {
-    for (uint32_t i = 0; i < other.hash_key_.size(); i++) {
-      if (hash_key_[i].CompareEquals(other.hash_key_[i]) != CmpBool::CmpTrue) {
-        return false;
-      }
-    }
-    return true;
-  }
-};
-
-/** AggregateValue represents a value for each of the running aggregates */
-struct HashJoinValue {
-  /** The aggregate values */
-  std::vector<Tuple> tuples_;
-};
-
-}  // namespace bustub
-
-namespace std {
-
-/** Implements std::hash on AggregateKey */
-template <>
-struct hash<bustub::HashJoinKey> {
-  auto operator()(const bustub::HashJoinKey &hash_join_key) const -> std::size_t {
-    size_t curr_hash = 0;
-    for (const auto &key : hash_join_key.hash_key_) {
-      if (!key.IsNull()) {
-        curr_hash = bustub::HashUtil::CombineHashes(curr_hash, bustub::HashUtil::HashValue(&key));
-      }
-    }
-    return curr_hash;
-  }
-};
-
-}  // namespace std
-
-namespace bustub {
-class SimpleHashJoinTable {
- public:
-  /**
-   * Construct a new SimpleAggregationHashTable instance.
-   * @param agg_exprs the aggregation expressions
-   * @param agg_types the types of aggregations
-   */
-  SimpleHashJoinTable() = default;
-  /**
-   * TODO(Student)
-   *
-   * Combines the input into the aggregation result.
-   * @param[out] result The output aggregate value
-   * @param input The input value
-   */
-  /*void CombineAggregateValues(HashJoinValue *result, const Tuple &input) {
-          result->tuples.emplace_back(input);
-  }*/
-
-  void InsertCombine(const HashJoinKey &hash_key, const Tuple &val) {
-    if (ht_.count(hash_key) == 0) {
-      std::vector<Tuple> tuple{val};
-      ht_.insert({hash_key, {tuple}});
-    } else {
-      ht_[hash_key].tuples_.emplace_back(val);
-    }
-  }
-
-  auto FindValue(const HashJoinKey &hash_key, int index) -> Tuple { return ht_[hash_key].tuples_[index]; }
-
-  auto IfEnd(const HashJoinKey &hash_key, uint32_t index) -> bool { return index == ht_[hash_key].tuples_.size() - 1; }
-
-  /**
-   * Clear the hash table
-   */
-  void Clear() { ht_.clear(); }
-  auto End() -> std::unordered_map<HashJoinKey, HashJoinValue>::const_iterator { return ht_.cend(); }
-  auto Find(const HashJoinKey &hash_join_key) -> std::unordered_map<HashJoinKey, HashJoinValue>::const_iterator {
-    return ht_.find(hash_join_key);
-  }
-
- private:
-  /** The hash table is just a map from aggregate keys to aggregate values */
-  std::unordered_map<HashJoinKey, HashJoinValue> ht_{};
-  /** The types of aggregations that we have */
-};
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes a hash JOIN on two tables, building a hash table over the right child and probing it with
+ * the rows of the left child. A chunk of left rows is probed all at once with JoinHashTable::FindBatch(), which
+ * prefetches for groups of rows before comparing their keys.
+ *
+ * When the hash table outgrows the hash join memory budget of the executor context, the join turns into a grace hash
+ * join: both inputs are partitioned by the hash of their keys into temporary files, and the pairs of partitions are
+ * joined one at a time. A pair whose right partition still does not fit is partitioned again on other bits of the
+ * hash, up to MAX_SPILL_DEPTH levels; past that, or when all its rows share a hash, it is joined in memory anyway.
+ *
+ * When the hash table, or that of a pair of partitions, is larger than the hash join cache size of the executor
+ * context, it is radix-partitioned so that each of its partitions fits in cache (see JoinHashTable). The left rows are
+ * then gathered in rounds of as many as the memory budget allows into a table of their own, partitioned the same way,
+ * and each round probes the hash table one partition after the other.
+ *
+ * An inner join whose left child is a scan pushes a RuntimeFilter into it: once all the right rows are read, the scan
+ * drops the left rows whose key is surely not among theirs, before the join probes with them or spills them.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -141,36 +68,131 @@ class HashJoinExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next chunk of rows from the join, probing the table with the chunks of the left child.
+   * @param[out] chunk The next chunk of joined rows
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  auto NextBatch(DataChunk *chunk) -> bool override;
+
   /** @return The output schema for the join */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
-  /** @return The tuple as an AggregateKey */
-  auto MakeLeftHashJoinKey(const Tuple *tuple) -> HashJoinKey {
-    std::vector<Value> keys;
-    for (const auto &expr : plan_->LeftJoinKeyExpressions()) {
-      keys.emplace_back(expr->Evaluate(tuple, left_child_->GetOutputSchema()));
-    }
-    return {keys};
-  }
+  /** A pair of partitions of the two inputs, spilled to temporary files, whose rows can only join each other */
+  struct SpillPartition {
+    std::unique_ptr<TmpTupleFile> right_;
+    std::unique_ptr<TmpTupleFile> left_;
+    /** The level of partitioning that made the pair, which picks the bits of the hash that split it further */
+    size_t depth_;
+  };
+
+  /** The number of partitions that a level of partitioning splits its input into */
+  static constexpr size_t SPILL_FANOUT = 16;
+  /** The deepest level of partitioning */
+  static constexpr size_t MAX_SPILL_DEPTH = 3;
+
+  /**
+   * @return the partition of a key with `hash` at level `depth`: 4 bits of the hash below the 16 bits of the tag of the
+   * hash table, so that the rows of a partition still spread over the directory of the hash table
+   */
+  static auto PartitionOf(hash_t hash, size_t depth) -> size_t { return (hash >> (44 - 4 * depth)) % SPILL_FANOUT; }
+
+  /** Read the next tuples of a file into a chunk of `schema`. @return false if there was no tuple left */
+  static auto ReadChunk(TmpTupleFile *file, const Schema *schema, DataChunk *chunk) -> bool;
+
+  /** @return SPILL_FANOUT pairs of new, empty partitions at level `depth` */
+  auto MakePartitions(size_t depth) -> std::vector<SpillPartition>;
+
+  /** Write the selected rows of a chunk of the left or the right input, whose keys are `keys`, to their partitions. */
+  void SpillChunk(const DataChunk &chunk, const std::vector<const ColumnVector *> &keys, bool is_left, size_t depth,
+                  std::vector<SpillPartition> *partitions);
+
+  /** Spill the rows in the hash table and the rest of both inputs to the partitions of the first level. */
+  void SpillInputs();
+
+  /** Load the right partition of a pair into the hash table. @return false if it did not fit and was partitioned */
+  auto LoadPartition(SpillPartition *partition) -> bool;
+
+  /** Split a pair of partitions into pairs of the next level, which are queued in its place. */
+  void Repartition(SpillPartition *partition);
 
-  /** @return The tuple as an AggregateValue */
-  auto MakeRightHashJoinKey(const Tuple *tuple) -> HashJoinKey {
-    std::vector<Value> keys;
-    for (const auto &expr : plan_->RightJoinKeyExpressions()) {
-      keys.emplace_back(expr->Evaluate(tuple, right_child_->GetOutputSchema()));
+  /** Read the next chunk of left rows from the left child, or from the pair of partitions being joined. */
+  auto ReadLeftChunk() -> bool;
+
+  /** Get the next chunk of left rows to probe with, from the left child or from the pairs of partitions. */
+  auto NextLeftChunk() -> bool;
+
+  /** Build the hash table over the rows appended to it, partitioned if it does not fit in cache. */
+  void BuildHashTable();
+
+  /** Fill the runtime filter, if there is one, with the hashes that the rows in the hash table were stored with. */
+  void BuildRuntimeFilter();
+
+  /** Fill the runtime filter, if there is one, with the hashes of the keys of the right rows spilled to `partitions`. */
+  void BuildRuntimeFilter(std::vector<SpillPartition> *partitions);
+
+  /** Gather `left_chunk_` and the left chunks after it into `left_rows_`, as many as fit, partitioned for a round. */
+  void StartPartitionedProbe();
+
+  /** Evaluate the compiled key expressions over a chunk into `keys`. */
+  static void EvaluateKeys(std::vector<CompiledExpression> *exprs, const DataChunk &chunk,
+                           std::vector<const ColumnVector *> *keys) {
+    keys->resize(exprs->size());
+    for (size_t i = 0; i < exprs->size(); i++) {
+      (*keys)[i] = &(*exprs)[i].Evaluate(chunk);
     }
-    return {keys};
   }
+
+  /** Append the current left row joined with the right row at `entry` of the hash table, or with nulls if NONE. */
+  void AppendJoinRow(DataChunk *chunk, uint64_t entry) const;
+
   /** The NestedLoopJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> left_child_;
   std::unique_ptr<AbstractExecutor> right_child_;
-  SimpleHashJoinTable hjt_;
-  HashJoinKey hash_join_key_;
-  uint32_t index_;
-  bool have_found_;
-  Tuple left_tuple_;
+  /** The hash table over the rows of the right child */
+  std::optional<JoinHashTable> jht_;
+
+  /** The runtime filter pushed into the left child */
+  std::optional<RuntimeFilter> runtime_filter_;
+
+  /**
+   * The probe state of NextBatch(): the left chunk, the first match of each of its rows, the next left row in it, the
+   * current left row and its next match
+   */
+  DataChunk left_chunk_;
+  std::vector<uint64_t> left_matches_;
+  size_t left_pos_{0};
+  size_t left_row_{0};
+  uint64_t match_{JoinHashTable::NONE};
+
+  /**
+   * The probe state of a round of partitioned probing: the left rows of the round, whether it is under way, the
+   * partition being probed, the offset in `left_rows_` of the next left row to probe with, and of the current one
+   */
+  std::optional<JoinHashTable> left_rows_;
+  bool probing_partitions_{false};
+  size_t probe_partition_{0};
+  uint64_t probe_entry_{0};
+  uint64_t left_entry_{0};
+
+  /** The joined rows that Next() hands out one at a time, and the next one */
+  DataChunk out_chunk_;
+  size_t out_pos_{0};
+
+  /** Whether the inputs were spilled, the temporary file they were spilled into, which outlives the partitions and is
+   * deleted once the last of them is joined, the pairs of partitions left to join, and the one being joined */
+  bool spilled_{false};
+  std::unique_ptr<TmpFileManager> tmp_files_;
+  std::vector<SpillPartition> partitions_;
+  std::optional<SpillPartition> current_;
+
+  /** The key expressions of the two sides, compiled for the chunks of the children */
+  std::vector<CompiledExpression> left_key_exprs_;
+  std::vector<CompiledExpression> right_key_exprs_;
+  /** The keys of the rows of `left_chunk_` */
+  std::vector<const ColumnVector *> left_keys_;
 };
 
 }  // namespace bustub
@@ -12,11 +12,14 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include "common/rid.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/runtime_filter.h"
+#include "execution/scan_locks.h"
 #include "execution/plans/index_scan_plan.h"
 #include "storage/table/tuple.h"
 
@@ -41,12 +44,51 @@ class IndexScanExecutor : public AbstractExecutor {
 
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /** Drop the rows that the runtime filter of a hash join rules out, before they are fetched if it can. */
+  auto SetRuntimeFilter(RuntimeFilter *filter) -> bool override {
+    runtime_filter_ = filter;
+    return true;
+  }
+
  private:
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
+  /**
+   * Start iterating the index if it is a B+ tree with keys of `KeySize` bytes.
+   * @return false if the index is of another type
+   */
+  template <size_t KeySize>
+  auto InitIterator() -> bool;
+
+  /** Look up the RIDs between the bounds of the plan, the entries are only decoded for the runtime filter. */
+  void InitRange();
+
+  /**
+   * Look up the RIDs between `lower` and `upper` with their decoded entries, if the index is a B+ tree with keys of
+   * `KeySize` bytes.
+   * @return false if the index is of another type
+   */
+  template <size_t KeySize>
+  auto ScanRangeEntries(const Tuple *lower, const Tuple *upper, std::vector<RID> *rids,
+                        std::vector<std::vector<Value>> *entries) -> bool;
+
   const IndexInfo *index_info_;
   TableHeap *tbl_heap_;
-  BPlusTreeIndexForTwoIntegerColumn *tree_;
-  IndexIterator<IntegerKeyType, IntegerValueType, IntegerComparatorType> it_;
+  /** The table and row locks the scan takes for its transaction */
+  ScanLocks locks_;
+  /**
+   * Produces the entries of the index in key order, whatever the width of its keys. The second argument, if not
+   * null, receives the columns stored in the entry.
+   */
+  std::function<bool(RID *, std::vector<Value> *)> next_entry_;
+  /** For an index-only scan, the position of each output column in the index entries, or -1 */
+  std::vector<int> entry_column_of_;
+  /** The runtime filter that a hash join pushed into the scan, if any */
+  RuntimeFilter *runtime_filter_{nullptr};
+  /**
+   * The position in the index entries of each key of the runtime filter, if the entries store them all, so that the
+   * rows the filter drops are never fetched from the table heap; empty otherwise
+   */
+  std::vector<size_t> filter_entry_columns_;
 };
 }  // namespace bustub
@@ -45,6 +45,13 @@ class LimitExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next chunk of rows from the limit, cutting the chunks of the child at the limit.
+   * @param[out] chunk The next chunk of rows
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  auto NextBatch(DataChunk *chunk) -> bool override;
+
   /** @return The output schema for the limit */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
@@ -49,6 +49,9 @@ class MockScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /** Yield the next chunk of rows from the sequential scan. */
+  auto NextBatch(DataChunk *chunk) -> bool override;
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -48,7 +48,20 @@ class NestIndexJoinExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /** Number of outer tuples whose keys are probed against the index in one batch. */
+  static constexpr size_t BATCH_SIZE = 128;
+
+  /** Pull the next batch of outer tuples, probe the index once for all of them and buffer the joined tuples. */
+  auto FillBatch() -> bool;
+
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  const IndexInfo *index_info_;
+  TableHeap *inner_table_;
+  /** Joined tuples of the current batch, handed out by Next() */
+  std::vector<Tuple> results_;
+  size_t cursor_{0};
+  bool child_done_{false};
 };
 }  // namespace bustub
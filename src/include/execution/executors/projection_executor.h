@@ -15,6 +15,7 @@
 #include <memory>
 #include <vector>
 
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/projection_plan.h"
@@ -47,6 +48,13 @@ class ProjectionExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next chunk of rows from the projection, one for each selected row of the next chunk of the child.
+   * @param[out] chunk The next chunk of projected rows
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  auto NextBatch(DataChunk *chunk) -> bool override;
+
   /** @return The output schema for the projection plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -56,5 +64,11 @@ class ProjectionExecutor : public AbstractExecutor {
 
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The chunk pulled from the child by NextBatch() */
+  DataChunk child_chunk_;
+
+  /** The expressions, compiled for the chunks of the child */
+  std::vector<CompiledExpression> exprs_;
 };
 }  // namespace bustub
@@ -13,10 +13,14 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/runtime_filter.h"
+#include "execution/scan_locks.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "storage/table/tuple.h"
 
@@ -45,14 +49,32 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /** Yield the next chunk of rows from the sequential scan. */
+  auto NextBatch(DataChunk *chunk) -> bool override;
+
+  /** Drop the rows that the runtime filter of a hash join rules out from the chunks of NextBatch(). */
+  auto SetRuntimeFilter(RuntimeFilter *filter) -> bool override {
+    runtime_filter_ = filter;
+    return true;
+  }
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
+  /** Take the row locks, skip deleted tuples and yield the next tuple, shared by Next() and NextBatch(). */
+  auto NextRow(Tuple *tuple, RID *rid) -> bool;
+
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
   TableInfo *table_info_;
   std::unique_ptr<TableIterator> it_;
   Transaction *txn_;
+  /** The table and row locks the scan takes for its transaction */
+  ScanLocks locks_;
+  /** The filter predicate merged into the scan, compiled for the chunks of the scan, if there is one */
+  std::optional<CompiledExpression> predicate_;
+  /** The runtime filter that a hash join pushed into the scan, if any */
+  RuntimeFilter *runtime_filter_{nullptr};
 };
 }  // namespace bustub
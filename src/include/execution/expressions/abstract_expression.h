@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "execution/data_chunk.h"
 #include "fmt/format.h"
 #include "storage/table/tuple.h"
 
@@ -54,6 +55,9 @@ class AbstractExpression {
   /** @return The value obtained by evaluating the tuple with the given schema */
   virtual auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value = 0;
 
+  /** @return The value obtained by evaluating the physical row `row` of a chunk of the child's output */
+  virtual auto EvaluateAt(const DataChunk &chunk, size_t row) const -> Value = 0;
+
   /**
    * Returns the value obtained by evaluating a JOIN.
    * @param left_tuple The left tuple
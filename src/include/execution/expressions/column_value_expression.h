@@ -39,6 +39,8 @@ class ColumnValueExpression : public AbstractExpression {
     return tuple->GetValue(&schema, col_idx_);
   }
 
+  auto EvaluateAt(const DataChunk &chunk, size_t row) const -> Value override { return chunk.GetValue(col_idx_, row); }
+
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     // std::cout<<tuple_idx_<<std::endl;
@@ -42,6 +42,12 @@ class ComparisonExpression : public AbstractExpression {
     return ValueFactory::GetBooleanValue(PerformComparison(lhs, rhs));
   }
 
+  auto EvaluateAt(const DataChunk &chunk, size_t row) const -> Value override {
+    Value lhs = GetChildAt(0)->EvaluateAt(chunk, row);
+    Value rhs = GetChildAt(1)->EvaluateAt(chunk, row);
+    return ValueFactory::GetBooleanValue(PerformComparison(lhs, rhs));
+  }
+
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     // std::cout<<"left_child"<<std::endl;
@@ -50,6 +50,12 @@ class LogicExpression : public AbstractExpression {
     return ValueFactory::GetBooleanValue(PerformComputation(lhs, rhs));
   }
 
+  auto EvaluateAt(const DataChunk &chunk, size_t row) const -> Value override {
+    Value lhs = GetChildAt(0)->EvaluateAt(chunk, row);
+    Value rhs = GetChildAt(1)->EvaluateAt(chunk, row);
+    return ValueFactory::GetBooleanValue(PerformComputation(lhs, rhs));
+  }
+
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     Value lhs = GetChildAt(0)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// filter_kernels.h
+//
+// Identification: src/include/execution/filter_kernels.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "execution/expressions/comparison_expression.h"
+
+namespace bustub {
+
+/**
+ * The kernels that evaluate the predicates of a filter over whole columns. Booleans are int8_t: 1, 0, or
+ * BUSTUB_BOOLEAN_NULL; an integer operand that is BUSTUB_INT32_NULL or BUSTUB_INT64_NULL is NULL.
+ *
+ * There is an implementation for each instruction set (scalar, SSE4.2 and AVX2); GetFilterKernels() picks the widest
+ * one that the CPU supports, once, at the first call.
+ */
+struct FilterKernels {
+  /** The name of the instruction set */
+  const char *isa_;
+  /** out[row] = lhs[row] <op> rhs[row] for the rows in [0, count), NULL if either side is NULL */
+  void (*compare_int32_)(ComparisonType op, const int32_t *lhs, const int32_t *rhs, int8_t *out, size_t count);
+  void (*compare_int64_)(ComparisonType op, const int64_t *lhs, const int64_t *rhs, int8_t *out, size_t count);
+  /** out[row] = lhs[row] AND rhs[row], or OR, in three-valued logic */
+  void (*and_)(const int8_t *lhs, const int8_t *rhs, int8_t *out, size_t count);
+  void (*or_)(const int8_t *lhs, const int8_t *rhs, int8_t *out, size_t count);
+  /**
+   * Write the rows in [0, count) for which keep[row] is true to `positions`, which has room for `count` rows.
+   * @return the number of rows written
+   */
+  auto (*select_true_)(const int8_t *keep, size_t count, uint32_t *positions) -> size_t;
+};
+
+/** @return the kernels for the widest instruction set that the CPU supports */
+auto GetFilterKernels() -> const FilterKernels &;
+
+/** @return the scalar kernels, which every instruction set falls back to */
+auto GetScalarFilterKernels() -> const FilterKernels *;
+
+/** @return the SSE4.2 kernels, or nullptr if they were not built in or the CPU does not support SSE4.2 */
+auto GetSse42FilterKernels() -> const FilterKernels *;
+
+/** @return the AVX2 kernels, or nullptr if they were not built in or the CPU does not support AVX2 */
+auto GetAvx2FilterKernels() -> const FilterKernels *;
+
+}  // namespace bustub
@@ -0,0 +1,253 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table.h
+//
+// Identification: src/include/execution/join_hash_table.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/util/hash_util.h"
+#include "execution/data_chunk.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * The hash table that a hash join builds over the rows of its build side and probes with the rows of the other side.
+ *
+ * The build rows are serialized one after the other into an arena: a header with the hash of the key and the offset
+ * of the next row with the same key, the key, and the columns of the row. The directory is a flat array of 64-bit
+ * slots, probed linearly, each holding the offset of the first row of one key and a 16-bit tag taken from the top of
+ * its hash. A probe compares the tag, then the hash in the row header, and only then the key, so that slots of other
+ * keys are almost always skipped without touching the arena.
+ *
+ * Integer keys are compared as BIGINT, and as DECIMAL if either side is a DECIMAL, so that the keys of the two sides
+ * need not be of the same type. Rows with a NULL key never match and are not stored, unless the table keeps them.
+ *
+ * A table much larger than the cache can be radix-partitioned on bits of the hash: its rows are regrouped by partition
+ * and each partition gets a directory of its own, so that a partition fits in cache. Probing with the rows of one
+ * partition after the other, e.g. with the rows of a table of the probe side partitioned the same way, then misses
+ * the cache only once per line of the partition instead of once per probe.
+ */
+class JoinHashTable {
+ public:
+  /** The offset of no row */
+  static constexpr uint64_t NONE = UINT64_MAX;
+  /** The most bits of the hash that a table is partitioned on */
+  static constexpr size_t MAX_PARTITION_BITS = 10;
+  /** The number of probes of FindBatch() whose cache misses overlap */
+  static constexpr size_t PROBE_GROUP_SIZE = 16;
+
+  /**
+   * Create an empty hash table.
+   * @param build_schema the schema of the build rows, which must outlive the table
+   * @param build_key_types the types of the keys of the build rows
+   * @param probe_key_types the types of the keys that the table is probed with
+   * @param keep_null_keys whether to store the rows with a NULL key too, which Find() never returns
+   */
+  JoinHashTable(const Schema &build_schema, const std::vector<TypeId> &build_key_types,
+                const std::vector<TypeId> &probe_key_types, bool keep_null_keys = false);
+
+  /** @return the number of bits to partition a table of `bytes` bytes on, so that a partition fits in `cache_size` */
+  static auto PartitionBitsFor(size_t bytes, size_t cache_size) -> size_t {
+    size_t bits = 0;
+    while (bits < MAX_PARTITION_BITS && (bytes >> bits) > cache_size) {
+      bits++;
+    }
+    return bits;
+  }
+
+  /** Remove all the rows. */
+  void Clear();
+
+  /** Add the selected rows of a chunk of build rows, whose keys are the columns `keys`. */
+  void Append(const DataChunk &chunk, const std::vector<const ColumnVector *> &keys);
+
+  /**
+   * Regroup the rows appended so far by the partition of their hash, keeping their order within a partition. The rows
+   * are copied to a new arena through a small write-combining buffer per partition, so that the copy writes whole
+   * cache lines instead of scattering rows over as many pages as there are partitions. The arena takes twice its size
+   * while it is copied.
+   * @param partition_bits the number of bits of the hash to partition on, 0 for a single partition
+   */
+  void Partition(size_t partition_bits);
+
+  /**
+   * Partition the rows appended so far, then size and fill the directory of each partition, after which the rows can
+   * be found.
+   * @param partition_bits the number of bits of the hash to partition on, 0 for a single partition
+   */
+  void Build(size_t partition_bits = 0);
+
+  /** @return the hash of the key of `row` in the columns `keys`, of the build or the probe side */
+  auto Hash(const std::vector<const ColumnVector *> &keys, size_t row) const -> hash_t;
+
+  /** @return the hash of a key of the build or the probe side given as values, none NULL, the same as Hash() above */
+  auto Hash(const std::vector<Value> &keys) const -> hash_t;
+
+  /** Call `f` with the hash of the key of every row, as stored in the row header, but for the rows with a NULL key. */
+  template <typename F>
+  void ForEachHash(F &&f) const {
+    for (uint64_t entry = 0; entry < arena_.size(); entry = RowAfter(entry)) {
+      if (Header(entry)->key_size_ != 0) {
+        f(Header(entry)->hash_);
+      }
+    }
+  }
+
+  /**
+   * Find the build rows whose key equals the key of `row` in the probe columns `keys`.
+   * @param hash the hash of the key, from Hash()
+   * @return the offset of the first of the rows, or NONE
+   */
+  auto Find(hash_t hash, const std::vector<const ColumnVector *> &keys, size_t row) const -> uint64_t;
+
+  /**
+   * Find the build rows whose key equals the key of the row at `probe_entry` of `probe`, a table whose key types are
+   * those of this one swapped.
+   * @return the offset of the first of the rows, or NONE
+   */
+  auto Find(const JoinHashTable &probe, uint64_t probe_entry) const -> uint64_t;
+
+  /**
+   * Find the build rows of every row of a chunk of probe rows, whose keys are the columns `keys`. The rows are probed
+   * in groups of PROBE_GROUP_SIZE: the hashes of a group are computed and their slots prefetched, then the rows that
+   * the slots point to, and only then are the keys compared, so that a group waits for its cache misses once instead
+   * of once per probe.
+   * @param[out] matches the offset of the first build row of each row of the chunk, by position, or NONE
+   */
+  void FindBatch(const DataChunk &chunk, const std::vector<const ColumnVector *> &keys,
+                 std::vector<uint64_t> *matches) const;
+
+  /** @return the offset of the build row after the row at `entry` with the same key, or NONE */
+  auto Next(uint64_t entry) const -> uint64_t { return Header(entry)->next_; }
+
+  /** Copy the columns of the build row at `entry` to `row` of `chunk`, from column `first_column` on. */
+  void CopyRow(uint64_t entry, DataChunk *chunk, size_t row, size_t first_column) const;
+
+  /**
+   * Copy the build rows, in the order they were appended, into `chunk` until it is full.
+   * @param[in,out] cursor the offset of the next row to copy, 0 for the first
+   * @return false if there was no row left to copy
+   */
+  auto ScanRows(uint64_t *cursor, DataChunk *chunk) const -> bool;
+
+  /** @return the number of rows in the table */
+  auto GetRowCount() const -> size_t { return row_count_; }
+
+  /** @return the number of partitions that Partition() or Build() made, 0 before */
+  auto GetPartitionCount() const -> size_t { return partitions_.size(); }
+
+  auto GetPartitionBits() const -> size_t { return partition_bits_; }
+
+  /** @return the offset of the first row of partition `partition`, which is its end if it has none */
+  auto GetPartitionBegin(size_t partition) const -> uint64_t { return partitions_[partition].begin_; }
+
+  /** @return the offset past the last row of partition `partition` */
+  auto GetPartitionEnd(size_t partition) const -> uint64_t { return partitions_[partition].end_; }
+
+  /** @return the offset of the row stored after the row at `entry` */
+  auto RowAfter(uint64_t entry) const -> uint64_t { return entry + Header(entry)->size_; }
+
+  /** @return the number of bytes that the rows take, plus those of the directory that Build() makes for them */
+  auto GetMemoryUsage() const -> size_t { return arena_.size() + DirectoryCapacity(row_count_) * sizeof(uint64_t); }
+
+ private:
+  /** How a key is stored and compared */
+  enum class KeyKind : uint8_t { Integer, Decimal, String };
+
+  /** The header of a row in the arena, followed by the key and by the columns */
+  struct EntryHeader {
+    /** The offset of the next row with the same key, or NONE */
+    uint64_t next_;
+    hash_t hash_;
+    /** The size of the key in bytes, 0 if the key is NULL */
+    uint32_t key_size_;
+    /** The size of the whole row in the arena, header included */
+    uint32_t size_;
+  };
+
+  /** A range of rows of the arena and its part of the directory */
+  struct PartitionInfo {
+    uint64_t begin_;
+    uint64_t end_;
+    size_t row_count_;
+    /** The first slot of the directory of the partition, and its number of slots minus one */
+    uint64_t slot_begin_;
+    uint64_t slot_mask_;
+  };
+
+  /** A buffer of Partition() that gathers the rows of a partition until it holds a few cache lines of them */
+  struct alignas(64) WriteCombineBuffer {
+    static constexpr size_t SIZE = 256;
+    char data_[SIZE];
+  };
+
+  /** The bits of a slot that hold the offset of the row plus one, so that an empty slot is 0 */
+  static constexpr uint64_t SLOT_OFFSET_MASK = (uint64_t{1} << 48) - 1;
+  /**
+   * The lowest bit of the hash that partitions are taken from: above the bits that place a row in the directory of its
+   * partition, and below those that the spilling of a hash join partitions on and the tag
+   */
+  static constexpr size_t PARTITION_SHIFT = 20;
+
+  static auto Tag(hash_t hash) -> uint64_t { return hash & ~SLOT_OFFSET_MASK; }
+
+  auto PartitionOf(hash_t hash) const -> size_t {
+    return (hash >> PARTITION_SHIFT) & ((uint64_t{1} << partition_bits_) - 1);
+  }
+
+  /** @return the index in `slots_` of the first slot that a probe for `hash` looks at */
+  auto FirstSlot(hash_t hash) const -> uint64_t {
+    const auto &partition = partitions_[PartitionOf(hash)];
+    return partition.slot_begin_ + (hash & partition.slot_mask_);
+  }
+
+  /** @return the number of slots of the directory for `row_count` rows, which keeps it at most half full */
+  static auto DirectoryCapacity(size_t row_count) -> size_t {
+    size_t capacity = 16;
+    while (capacity < row_count * 2) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  auto Header(uint64_t entry) const -> const EntryHeader * {
+    return reinterpret_cast<const EntryHeader *>(arena_.data() + entry);
+  }
+  auto Header(uint64_t entry) -> EntryHeader * { return reinterpret_cast<EntryHeader *>(arena_.data() + entry); }
+
+  auto Key(uint64_t entry) const -> const char * { return arena_.data() + entry + sizeof(EntryHeader); }
+
+  /** @return true if the key of the row at `entry` equals the key of `row` in `keys` */
+  auto KeyEquals(uint64_t entry, const std::vector<const ColumnVector *> &keys, size_t row) const -> bool;
+
+  /** Link the row at `entry` into the directory of its partition, in front of the rows with the same key. */
+  void Insert(const PartitionInfo &partition, uint64_t entry);
+
+  const Schema &build_schema_;
+  std::vector<KeyKind> key_kinds_;
+  /** The offset of each column in the fixed-size part of a serialized row; VARCHARs hold their length there */
+  std::vector<uint32_t> column_offsets_;
+  /** The size of the fixed-size part of a serialized row, which the bytes of the VARCHARs follow */
+  uint32_t fixed_size_{0};
+  bool keep_null_keys_;
+
+  std::vector<char> arena_;
+  size_t row_count_{0};
+  size_t partition_bits_{0};
+  std::vector<PartitionInfo> partitions_;
+  /** The directories of all the partitions, one after the other */
+  std::vector<uint64_t> slots_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bitmap_heap_scan_plan.h
+//
+// Identification: src/include/execution/plans/bitmap_heap_scan_plan.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * BitmapHeapScanPlanNode reads the tuples whose key lies in a range of an index. The matching RIDs are collected
+ * from the index first and sorted by page, so every table page is fetched once and the tuples come out in the
+ * order of a sequential scan rather than in key order.
+ */
+class BitmapHeapScanPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new bitmap heap scan plan node.
+   * @param output the output format of this scan plan node
+   * @param table_oid the identifier of table to be scanned
+   * @param table_name the name of table to be scanned
+   * @param index_oid the identifier of the index that finds the tuples
+   * @param lower_bound the constant smallest key to scan, nullptr to scan from the first key
+   * @param upper_bound the constant largest key to scan, nullptr to scan up to the last key
+   */
+  BitmapHeapScanPlanNode(SchemaRef output, table_oid_t table_oid, std::string table_name, index_oid_t index_oid,
+                         AbstractExpressionRef lower_bound, AbstractExpressionRef upper_bound)
+      : AbstractPlanNode(std::move(output), {}),
+        table_oid_(table_oid),
+        table_name_(std::move(table_name)),
+        index_oid_(index_oid),
+        lower_bound_(std::move(lower_bound)),
+        upper_bound_(std::move(upper_bound)) {}
+
+  auto GetType() const -> PlanType override { return PlanType::BitmapHeapScan; }
+
+  /** @return the identifier of the table that should be scanned */
+  auto GetTableOid() const -> table_oid_t { return table_oid_; }
+
+  /** @return the identifier of the index that finds the tuples */
+  auto GetIndexOid() const -> index_oid_t { return index_oid_; }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(BitmapHeapScanPlanNode);
+
+  /** The table whose tuples should be scanned. */
+  table_oid_t table_oid_;
+
+  /** The table name */
+  std::string table_name_;
+
+  /** The index that finds the tuples. */
+  index_oid_t index_oid_;
+
+  /** The smallest key to scan, or nullptr. Like the upper bound it is inclusive, a filter above removes the rest. */
+  AbstractExpressionRef lower_bound_;
+
+  /** The largest key to scan, or nullptr. */
+  AbstractExpressionRef upper_bound_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override {
+    return fmt::format("BitmapHeapScan {{ table={}, index_oid={}, range=[{}, {}] }}", table_name_, index_oid_,
+                       lower_bound_ != nullptr ? lower_bound_->ToString() : "-inf",
+                       upper_bound_ != nullptr ? upper_bound_->ToString() : "+inf");
+  }
+};
+
+}  // namespace bustub
@@ -29,15 +29,40 @@ class IndexScanPlanNode : public AbstractPlanNode {
    * Creates a new index scan plan node.
    * @param output the output format of this scan plan node
    * @param table_oid the identifier of table to be scanned
+   * @param reverse whether to scan the index from the largest key to the smallest one
+   * @param index_only whether to produce the tuples from the index entries alone, without reading the table
+   * @param lower_bound the constant smallest key to scan, nullptr to scan from the first key
+   * @param upper_bound the constant largest key to scan, nullptr to scan up to the last key
    */
-  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
-      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, bool reverse = false, bool index_only = false,
+                    AbstractExpressionRef lower_bound = nullptr, AbstractExpressionRef upper_bound = nullptr)
+      : AbstractPlanNode(std::move(output), {}),
+        index_oid_(index_oid),
+        reverse_(reverse),
+        index_only_(index_only),
+        lower_bound_(std::move(lower_bound)),
+        upper_bound_(std::move(upper_bound)) {}
 
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
   /** @return the identifier of the table that should be scanned */
   auto GetIndexOid() const -> index_oid_t { return index_oid_; }
 
+  /** @return true if the index should be scanned in descending key order */
+  auto IsReverse() const -> bool { return reverse_; }
+
+  /**
+   * @return true if the tuples are built from the index entries. Columns that are not stored in the index are NULL,
+   * the optimizer only picks this when the parent does not reference them.
+   */
+  auto IsIndexOnly() const -> bool { return index_only_; }
+
+  /**
+   * @return true if only the keys between the bounds, both inclusive, are scanned. The bounds may let through keys
+   * that the query does not want, a filter above the scan removes them.
+   */
+  auto IsRangeScan() const -> bool { return lower_bound_ != nullptr || upper_bound_ != nullptr; }
+
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(IndexScanPlanNode);
 
   /** The table whose tuples should be scanned. */
@@ -45,9 +70,27 @@ class IndexScanPlanNode : public AbstractPlanNode {
 
   // Add anything you want here for index lookup
 
+  /** Scan in descending key order. */
+  bool reverse_;
+
+  /** Do not read the table heap except for the visibility of the tuples. */
+  bool index_only_;
+
+  /** The smallest key to scan, or nullptr. */
+  AbstractExpressionRef lower_bound_;
+
+  /** The largest key to scan, or nullptr. */
+  AbstractExpressionRef upper_bound_;
+
  protected:
   auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
+    std::string range;
+    if (IsRangeScan()) {
+      range = fmt::format(", range=[{}, {}]", lower_bound_ != nullptr ? lower_bound_->ToString() : "-inf",
+                          upper_bound_ != nullptr ? upper_bound_->ToString() : "+inf");
+    }
+    return fmt::format("IndexScan {{ index_oid={}{}{}{} }}", index_oid_, reverse_ ? ", reverse=true" : "",
+                       index_only_ ? ", index_only=true" : "", range);
   }
 };
 
@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter.h
+//
+// Identification: src/include/execution/runtime_filter.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "execution/executor_context.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/join_hash_table.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * A filter that an inner hash join builds over the keys of its build side and pushes into the scan of its probe side,
+ * so that the scan drops the rows whose key no build row has before the join, or anything between, sees them.
+ *
+ * It is a blocked bloom filter over the hashes of the build keys, as JoinHashTable::Hash() computes them: a key sets
+ * 3 bits of one 64-bit word, so that a test reads a single word. It has about 16 bits per build key, for a false
+ * positive rate of about 1%. Rows with a NULL key never match and are dropped too.
+ *
+ * A scan tests each row as soon as it has read its key, before the row is copied into a chunk, and an index scan
+ * before it fetches the tuple from the table heap if the key is stored in the index entries.
+ *
+ * Until Finish() is called the filter drops nothing, so the scan can run before the build side is read.
+ */
+class RuntimeFilter {
+ public:
+  /**
+   * Create a filter that drops nothing yet.
+   * @param exec_ctx the executor context, which counts the rows the filter drops
+   * @param table the hash table of the join, which hashes the keys of the probe rows
+   * @param key_exprs the key expressions of the probe side, which must outlive the filter
+   * @param probe_schema the schema of the probe rows that the filter is applied to
+   */
+  RuntimeFilter(ExecutorContext *exec_ctx, const JoinHashTable *table,
+                const std::vector<AbstractExpressionRef> &key_exprs, const Schema &probe_schema);
+
+  /** Go back to dropping nothing. */
+  void Clear();
+
+  /** Size the filter for `key_count` build keys and empty it, to be filled with Insert() and still dropping nothing. */
+  void Start(size_t key_count);
+
+  /** Add the hash of the key of a build row. */
+  void Insert(hash_t hash) { words_[hash & word_mask_] |= Mask(hash); }
+
+  /** Start dropping the rows whose key was not inserted. */
+  void Finish() { built_ = true; }
+
+  /** @return true once Finish() was called */
+  auto IsBuilt() const -> bool { return built_; }
+
+  /**
+   * @return the column of the probe schema that each key is, or std::nullopt if a key is computed otherwise; a scan
+   * whose rows are found from the entries of an index can test them with MayMatch(keys) if the entries hold these
+   */
+  auto GetKeyColumns() const -> std::optional<std::vector<uint32_t>>;
+
+  /** @return false if the key of a probe row, in the probe schema, is surely not among the build keys */
+  auto MayMatch(const Tuple &tuple) -> bool;
+
+  /** @return false if a key of the probe side, given as the values of its columns, is surely not a build key */
+  auto MayMatch(const std::vector<Value> &keys) -> bool;
+
+  /** @return true if a key with `hash` may be among the build keys */
+  auto MayContain(hash_t hash) const -> bool {
+    uint64_t mask = Mask(hash);
+    return (words_[hash & word_mask_] & mask) == mask;
+  }
+
+ private:
+  /** @return the 3 bits of its word that a key with `hash` sets, taken from above the bits that pick the word */
+  static auto Mask(hash_t hash) -> uint64_t {
+    return (uint64_t{1} << ((hash >> 46) & 63)) | (uint64_t{1} << ((hash >> 52) & 63)) |
+           (uint64_t{1} << ((hash >> 58) & 63));
+  }
+
+  ExecutorContext *exec_ctx_;
+  const JoinHashTable *table_;
+  const std::vector<AbstractExpressionRef> &key_exprs_;
+  const Schema &probe_schema_;
+  bool built_{false};
+  std::vector<uint64_t> words_;
+  uint64_t word_mask_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// scan_locks.h
+//
+// Identification: src/include/execution/scan_locks.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "catalog/catalog.h"
+#include "common/rid.h"
+#include "concurrency/transaction.h"
+#include "execution/executor_context.h"
+
+namespace bustub {
+
+/**
+ * The two-phase locking that a scan of a table does for its transaction, shared by the sequential, index and bitmap
+ * heap scans. Under a DELETE or an UPDATE the scan takes an IX lock on the table and X locks on the rows it produces,
+ * since the executor above changes them; otherwise it takes IS and S locks as the isolation level requires, and
+ * releases them early under READ_COMMITTED.
+ */
+class ScanLocks {
+ public:
+  ScanLocks(ExecutorContext *exec_ctx, table_oid_t oid)
+      : exec_ctx_(exec_ctx), txn_(exec_ctx->GetTransaction()), oid_(oid) {}
+
+  /** Lock the table before the scan starts. */
+  void LockTable();
+
+  /** Release the table lock once the scan is over, if the isolation level allows it. */
+  void UnlockTable();
+
+  /** Lock a row before its tuple is read. */
+  void LockRow(const RID &rid);
+
+  /** Release the lock of a row whose tuple was read, if it was deleted or the isolation level allows it. */
+  void UnlockRow(const RID &rid, bool is_deleted);
+
+ private:
+  ExecutorContext *exec_ctx_;
+  Transaction *txn_;
+  table_oid_t oid_;
+};
+
+}  // namespace bustub
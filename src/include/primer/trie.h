@@ -1,17 +1,20 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <future>  // NOLINT
-#include <map>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "common/macros.h"
+
 namespace bustub {
 
 /// A special type that will block the move constructor and move assignment operator. Used in TrieStore tests.
@@ -40,58 +43,85 @@ class MoveBlocked {
   std::future<int> wait_;
 };
 
-// A TrieNode is a node in a Trie.
+// The value of a key. Values are type-erased so that one trie can hold values of different types, and shared by
+// every version of the trie that has the key.
+class TrieValue {
+ public:
+  virtual ~TrieValue() = default;
+};
+
+// A TrieValueOf is a TrieValue of type T.
+template <class T>
+class TrieValueOf : public TrieValue {
+ public:
+  explicit TrieValueOf(T value) : value_(std::move(value)) {}
+
+  T value_;
+};
+
+// A TrieNode is a node in a Trie. Nodes never change once built, so that the versions of a trie can share them.
+//
+// Large dictionaries are dominated by the nodes, so a node is kept compact:
+// - The edge from the parent is path compressed. A node holds all the key bytes from the branch in its parent down to
+//   itself, so there is no chain of nodes with one child and no value below the root. The first byte of the edge is
+//   the byte the parent branches on.
+// - The header, the children and the edge are a single allocation. The children are an array of pointers followed by
+//   the sorted array of their first bytes.
+// - A node counts its own references, which are held by its parents and by the tries whose root it is, instead of
+//   carrying a shared_ptr control block per child.
 class TrieNode {
  public:
-  // Create a TrieNode with no children.
-  TrieNode() = default;
+  using Child = std::pair<char, const TrieNode *>;
 
-  // Create a TrieNode with some children.
-  explicit TrieNode(std::map<char, std::shared_ptr<const TrieNode>> children) : children_(std::move(children)) {}
+  // Create a node with one reference, which the caller owns. The node takes its own reference to each child.
+  // `children` must be sorted by their first byte (see `ChildLess`).
+  static auto Make(std::string_view edge, std::shared_ptr<const TrieValue> value, const std::vector<Child> &children)
+      -> const TrieNode *;
 
-  virtual ~TrieNode() = default;
+  void AddRef() const { refs_.fetch_add(1, std::memory_order_relaxed); }
 
-  // Clone returns a copy of this TrieNode. If the TrieNode has a value, the value is copied. The return
-  // type of this function is a unique_ptr to a TrieNode.
-  //
-  // You cannot use the copy constructor to clone the node because it doesn't know whether a `TrieNode`
-  // contains a value or not.
-  //
-  // Note: if you want to convert `unique_ptr` into `shared_ptr`, you can use `std::shared_ptr<T>(std::move(ptr))`.
-  virtual auto Clone() const -> std::unique_ptr<TrieNode> { return std::make_unique<TrieNode>(children_); }
+  // Drop a reference to the node. The last one frees the node and drops its references to its children.
+  static void Release(const TrieNode *node);
 
-  // A map of children, where the key is the next character in the key, and the value is the next TrieNode.
-  std::map<char, std::shared_ptr<const TrieNode>> children_;
+  // The order of the children of a node.
+  static auto ChildLess(char a, char b) -> bool { return static_cast<uint8_t>(a) < static_cast<uint8_t>(b); }
 
-  // Indicates if the node is the terminal node.
-  bool is_value_node_{false};
+  DISALLOW_COPY_AND_MOVE(TrieNode);
 
-  // You can add additional fields and methods here. But in general, you don't need to add extra fields to
-  // complete this project.
-};
+  auto Edge() const -> std::string_view { return {EdgeData(), edge_len_}; }
 
-// A TrieNodeWithValue is a TrieNode that also has a value of type T associated with it.
-template <class T>
-class TrieNodeWithValue : public TrieNode {
- public:
-  // Create a trie node with no children and a value.
-  explicit TrieNodeWithValue(std::shared_ptr<T> value) : value_(std::move(value)) { this->is_value_node_ = true; }
+  // The value of the key that ends at this node, or nullptr if no key does.
+  auto Value() const -> const std::shared_ptr<const TrieValue> & { return value_; }
 
-  // Create a trie node with children and a value.
-  TrieNodeWithValue(std::map<char, std::shared_ptr<const TrieNode>> children, std::shared_ptr<T> value)
-      : TrieNode(std::move(children)), value_(std::move(value)) {
-    this->is_value_node_ = true;
-  }
+  auto NumChildren() const -> uint32_t { return num_children_; }
+
+  // The child whose edge starts with `c`, or nullptr if there is none.
+  auto FindChild(char c) const -> const TrieNode *;
+
+  // The children with their first bytes, sorted.
+  auto GetChildren() const -> std::vector<Child>;
+
+  // The bytes taken by this node and the nodes below it, not counting the values.
+  auto MemoryUsage() const -> size_t;
 
-  // Override the Clone method to also clone the value.
-  //
-  // Note: if you want to convert `unique_ptr` into `shared_ptr`, you can use `std::shared_ptr<T>(std::move(ptr))`.
-  auto Clone() const -> std::unique_ptr<TrieNode> override {
-    return std::make_unique<TrieNodeWithValue<T>>(children_, value_);
+ private:
+  TrieNode(std::shared_ptr<const TrieValue> value, uint32_t edge_len, uint32_t num_children)
+      : edge_len_(edge_len), num_children_(num_children), value_(std::move(value)) {}
+  ~TrieNode() = default;
+
+  static auto AllocationSize(uint32_t edge_len, uint32_t num_children) -> size_t;
+
+  // The arrays that follow the header.
+  auto ChildData() const -> const TrieNode ** {
+    return reinterpret_cast<const TrieNode **>(const_cast<TrieNode *>(this) + 1);
   }
+  auto KeyData() const -> char * { return reinterpret_cast<char *>(ChildData() + num_children_); }
+  auto EdgeData() const -> char * { return KeyData() + num_children_; }
 
-  // The value associated with this trie node.
-  std::shared_ptr<T> value_;
+  mutable std::atomic<uint32_t> refs_{1};
+  uint32_t edge_len_;
+  uint32_t num_children_;
+  std::shared_ptr<const TrieValue> value_;
 };
 
 // A Trie is a data structure that maps strings to values of type T. All operations on a Trie should not
@@ -99,16 +129,37 @@ class TrieNodeWithValue : public TrieNode {
 // represent the new trie.
 class Trie {
  private:
-  // The root of the trie.
-  std::shared_ptr<const TrieNode> root_{nullptr};
+  // The root of the trie, whose reference this trie owns.
+  const TrieNode *root_{nullptr};
 
-  // Create a new trie with the given root.
-  explicit Trie(std::shared_ptr<const TrieNode> root) : root_(std::move(root)) {}
+  // Create a new trie taking over the reference to the given root.
+  explicit Trie(const TrieNode *root) : root_(root) {}
 
  public:
   // Create an empty trie.
   Trie() = default;
 
+  Trie(const Trie &that) : root_(that.root_) {
+    if (root_ != nullptr) {
+      root_->AddRef();
+    }
+  }
+  Trie(Trie &&that) noexcept : root_(std::exchange(that.root_, nullptr)) {}
+  auto operator=(const Trie &that) -> Trie & {
+    Trie copy(that);
+    std::swap(root_, copy.root_);
+    return *this;
+  }
+  auto operator=(Trie &&that) noexcept -> Trie & {
+    std::swap(root_, that.root_);
+    return *this;
+  }
+  ~Trie() {
+    if (root_ != nullptr) {
+      TrieNode::Release(root_);
+    }
+  }
+
   // Get the value associated with the given key.
   // 1. If the key is not in the trie, return nullptr.
   // 2. If the key is in the trie but the type is mismatched, return nullptr.
@@ -124,6 +175,13 @@ class Trie {
   // Remove the key from the trie. If the key does not exist, return the original trie.
   // Otherwise, returns the new trie.
   auto Remove(std::string_view key) const -> Trie;
+
+  // Returns the bytes taken by the nodes of the trie, including those shared with other versions.
+  auto MemoryUsage() const -> size_t { return root_ == nullptr ? 0 : root_->MemoryUsage(); }
+
+ private:
+  // Put a value of any type, returning the new trie.
+  auto PutValue(std::string_view key, std::shared_ptr<const TrieValue> value) const -> Trie;
 };
 
 }  // namespace bustub
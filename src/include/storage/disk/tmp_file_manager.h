@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_file_manager.h
+//
+// Identification: src/include/storage/disk/tmp_file_manager.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/**
+ * TmpFileManager keeps temporary pages, such as the partitions that a hash join spills, in a file of its own under the
+ * system temporary directory rather than in the database file.
+ *
+ * Its pages are numbered apart from the pages of the database, and a deallocated page is reused by the next one
+ * allocated, so the file only grows as far as the most pages held at once. The pages are written and read directly,
+ * from the caller's own buffers, so spilling evicts no page of the buffer pool. The file is deleted with the manager.
+ *
+ * A manager is owned by a single executor and is not thread-safe.
+ */
+class TmpFileManager {
+ public:
+  TmpFileManager();
+
+  ~TmpFileManager();
+
+  DISALLOW_COPY_AND_MOVE(TmpFileManager);
+
+  /** @return a page of the file, which must be written before it is read */
+  auto AllocatePage() -> page_id_t;
+
+  /** Give a page back, to be reused by the next AllocatePage. */
+  void DeallocatePage(page_id_t page_id);
+
+  void WritePage(page_id_t page_id, const char *page_data) { disk_manager_->WritePage(page_id, page_data); }
+
+  void ReadPage(page_id_t page_id, char *page_data) { disk_manager_->ReadPage(page_id, page_data); }
+
+  /** @return the number of pages the file has grown to, allocated or not */
+  auto GetPageCount() const -> size_t { return next_page_id_; }
+
+  /** @return the path of the file */
+  auto GetFileName() const -> const std::string & { return file_name_; }
+
+ private:
+  std::string file_name_;
+  std::unique_ptr<DiskManager> disk_manager_;
+  page_id_t next_page_id_{0};
+  std::vector<page_id_t> free_pages_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// adaptive_hash_index.h
+//
+// Identification: src/include/storage/index/adaptive_hash_index.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "common/config.h"
+#include "common/util/hash_util.h"
+
+namespace bustub {
+
+/** Default number of keys an adaptive hash index caches. */
+static constexpr size_t ADAPTIVE_HASH_INDEX_CAPACITY = 4096;
+/** Default number of tree descents for a key before it is cached. */
+static constexpr uint32_t ADAPTIVE_HASH_INDEX_BUILD_THRESHOLD = 3;
+
+/** Counters of an adaptive hash index. */
+struct AdaptiveHashIndexStats {
+  /** Point lookups that found an entry for their key */
+  uint64_t lookups_{0};
+  /** Lookups answered from the cached leaf without descending the tree */
+  uint64_t hits_{0};
+  /** Lookups whose entry was dropped because its leaf had been written since it was built */
+  uint64_t stale_{0};
+  /** Entries built for hot keys */
+  uint64_t builds_{0};
+  /** Entries currently cached */
+  uint64_t entries_{0};
+};
+
+/**
+ * AdaptiveHashIndex remembers, for the keys that are looked up often, the leaf of a B+ tree that holds them and
+ * their slot in it, so that later lookups can read that leaf directly instead of descending from the root.
+ *
+ * An entry records the version of the page of its leaf (see Page::GetVersion) when the key was found in it, and is
+ * only trusted while the leaf is at that version: the leaf has not been written since, so it is still the only place
+ * the key can be. Any write to the leaf makes its entries stale, and they are dropped when next looked up.
+ *
+ * The entries are spread over shards by the hash of their key, each with its own latch, so that lookups of different
+ * keys do not contend; looking up an entry only takes its shard latch in shared mode.
+ */
+template <typename KeyType>
+class AdaptiveHashIndex {
+ public:
+  /** Where a key was found. */
+  struct Entry {
+    page_id_t leaf_page_id_;
+    /** A hint, only checked against the key found in the slot */
+    int slot_;
+    /** The version of the page of the leaf when the key was found in it */
+    uint64_t version_;
+  };
+
+  explicit AdaptiveHashIndex(size_t capacity = ADAPTIVE_HASH_INDEX_CAPACITY,
+                             uint32_t build_threshold = ADAPTIVE_HASH_INDEX_BUILD_THRESHOLD)
+      : shard_capacity_(std::max<size_t>(capacity / SHARD_COUNT, 1)), build_threshold_(build_threshold) {}
+
+  /** Turn the index on or off, turning it off drops every entry. */
+  void SetEnabled(bool enabled);
+
+  auto IsEnabled() const -> bool { return enabled_.load(std::memory_order_relaxed); }
+
+  /** @return the entry of the key, if it has one, to be checked against the version of its leaf */
+  auto Lookup(const KeyType &key) -> std::optional<Entry>;
+
+  /** Count a lookup answered from the entry of the key. */
+  void RecordHit(const KeyType &key);
+
+  /** Drop the entry of a key, returned by Lookup, whose leaf was written since the entry was built. */
+  void Invalidate(const KeyType &key, const Entry &entry);
+
+  /**
+   * Count a lookup that descended the tree and found the key, caching its position once the key is hot. Called once
+   * the leaf is released, with the version the leaf had while it was latched: if the leaf was written in between,
+   * the entry is stale from the start.
+   */
+  void RecordProbe(const KeyType &key, page_id_t leaf_page_id, int slot, uint64_t version);
+
+  auto GetStats() const -> AdaptiveHashIndexStats;
+
+ private:
+  /** The number of shards the entries are spread over */
+  static constexpr size_t SHARD_COUNT = 16;
+
+  struct KeyHash {
+    auto operator()(const KeyType &key) const -> size_t {
+      return HashUtil::HashBytes(reinterpret_cast<const char *>(&key), sizeof(KeyType));
+    }
+  };
+  /** Keys are binary-comparable, equal keys have equal bytes. */
+  struct KeyEqual {
+    auto operator()(const KeyType &a, const KeyType &b) const -> bool { return memcmp(&a, &b, sizeof(KeyType)) == 0; }
+  };
+
+  /** A part of the entries, on cache lines of its own so that the shards are latched and counted independently. */
+  struct alignas(64) Shard {
+    /** Protects the maps */
+    mutable std::shared_mutex latch_;
+    std::unordered_map<KeyType, Entry, KeyHash, KeyEqual> entries_;
+    /** Descents per key not cached yet, cleared when it grows to the capacity so that only recent lookups count */
+    std::unordered_map<KeyType, uint32_t, KeyHash, KeyEqual> probe_counts_;
+    std::atomic<uint64_t> lookups_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> stale_{0};
+    std::atomic<uint64_t> builds_{0};
+  };
+
+  auto ShardOf(const KeyType &key) -> Shard & {
+    // the low bits of the hash pick the bucket within the shard, take the shard from the high ones
+    return shards_[(KeyHash{}(key) >> 32) % SHARD_COUNT];
+  }
+
+  std::atomic<bool> enabled_{true};
+  /** The number of entries, and of keys counted, per shard */
+  size_t shard_capacity_;
+  uint32_t build_threshold_;
+  std::array<Shard, SHARD_COUNT> shards_;
+};
+
+}  // namespace bustub
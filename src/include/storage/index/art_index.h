@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// art_index.h
+//
+// Identification: src/include/storage/index/art_index.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "container/art/adaptive_radix_tree.h"
+#include "storage/index/index.h"
+
+namespace bustub {
+
+#define ART_INDEX_TYPE ArtIndex<KeyType, ValueType, KeyComparator>
+
+/**
+ * An index held in memory by an adaptive radix tree, outside of the buffer pool, so it is lost with the process like
+ * the rest of the catalog. The binary-comparable keys are the bytes of the tree. It only serves point operations.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+class ArtIndex : public Index {
+ public:
+  explicit ArtIndex(std::unique_ptr<IndexMetadata> &&metadata);
+
+  auto InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool override;
+
+  void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
+
+  /** Only the range of a single key, `lower == upper`, can be scanned. */
+  void ScanRange(const Tuple *lower, const Tuple *upper, std::vector<RID> *result, Transaction *transaction) override;
+
+ protected:
+  // comparator for key
+  KeyComparator comparator_;
+  // container
+  AdaptiveRadixTree<ValueType> container_;
+};
+
+}  // namespace bustub
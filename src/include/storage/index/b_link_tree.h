@@ -0,0 +1,95 @@
+/**
+ * b_link_tree.h
+ *
+ * Implementation of a Lehman-Yao B-link tree, an alternative to BPlusTree for
+ * highly concurrent point operations.
+ * (1) We only support unique key
+ * (2) Every node carries a right link and a high key, so a reader that races
+ *     with a split simply moves right instead of holding latches on the parent
+ * (3) Readers hold at most one read latch at a time; writers latch at most one
+ *     node per level, plus its parent while a split is being propagated
+ * (4) Removal only deletes from the leaf, nodes are never merged or freed
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "concurrency/transaction.h"
+#include "storage/page/b_link_tree_page.h"
+#include "storage/page/b_plus_tree_header_page.h"
+#include "storage/page/page_guard.h"
+
+namespace bustub {
+
+#define BLINKTREE_TYPE BLinkTree<KeyType, ValueType, KeyComparator>
+
+INDEX_TEMPLATE_ARGUMENTS
+class BLinkTree {
+  using InternalPage = BLinkTreePage<KeyType, page_id_t, KeyComparator>;
+  using LeafPage = BLinkTreePage<KeyType, ValueType, KeyComparator>;
+
+ public:
+  explicit BLinkTree(std::string name, page_id_t header_page_id, BufferPoolManager *buffer_pool_manager,
+                     const KeyComparator &comparator, int leaf_max_size = B_LINK_PAGE_SIZE,
+                     int internal_max_size = B_LINK_INTERNAL_PAGE_SIZE);
+
+  // Returns true if this B-link tree has no keys and values.
+  auto IsEmpty() const -> bool;
+
+  // Insert a key-value pair into this B-link tree.
+  auto Insert(const KeyType &key, const ValueType &value, Transaction *txn = nullptr) -> bool;
+
+  // Remove a key and its value from this B-link tree.
+  void Remove(const KeyType &key, Transaction *txn = nullptr);
+
+  // Return the value associated with a given key
+  auto GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn = nullptr) -> bool;
+
+  // Return the page id of the root node
+  auto GetRootPageId() -> page_id_t;
+
+ private:
+  /**
+   * @brief Descend from the root to the leaf covering the key, holding one read latch at a time.
+   *
+   * @param key the key to search for
+   * @param stack if not null, receives the internal page visited on each level, from the root down
+   * @return page id of the leaf, or INVALID_PAGE_ID if the tree is empty. The leaf may have split since.
+   */
+  auto FindLeaf(const KeyType &key, std::vector<page_id_t> *stack) -> page_id_t;
+
+  /** @return page id of a node on `level` whose key range contained the key when it was visited */
+  auto FindNodeOnLevel(const KeyType &key, int level) -> page_id_t;
+
+  /** Follow right links under write latches until the node held by `guard` covers the key. */
+  void MoveRight(const KeyType &key, WritePageGuard &guard);
+
+  /**
+   * Split the full node held by `guard` in two. The new right sibling is linked in before the latch is released,
+   * so it is reachable through the right link even before the separator reaches the parent.
+   * @param[out] separator the first key of the new right sibling
+   * @return page id of the new right sibling
+   */
+  template <typename PageType>
+  auto Split(WritePageGuard &guard, int max_size, KeyType *separator) -> page_id_t;
+
+  /**
+   * Insert the separator of a split into the parent level, splitting upwards as long as needed.
+   * @param guard write guard of the node that was split, released once the parent is latched
+   * @param stack the internal pages visited on the way down
+   */
+  void InsertIntoParent(WritePageGuard guard, KeyType separator, page_id_t right_page_id,
+                        std::vector<page_id_t> *stack);
+
+  // member variable
+  std::string index_name_;
+  BufferPoolManager *bpm_;
+  KeyComparator comparator_;
+  int leaf_max_size_;
+  int internal_max_size_;
+  page_id_t header_page_id_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_link_tree_index.h
+//
+// Identification: src/include/storage/index/b_link_tree_index.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/index/b_link_tree.h"
+#include "storage/index/index.h"
+
+namespace bustub {
+
+#define BLINKTREE_INDEX_TYPE BLinkTreeIndex<KeyType, ValueType, KeyComparator>
+
+/**
+ * An index backed by a B-link tree. It only serves point operations, range scans keep using BPlusTreeIndex.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BLinkTreeIndex : public Index {
+ public:
+  BLinkTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager);
+
+  auto InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool override;
+
+  void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
+
+ protected:
+  // comparator for key
+  KeyComparator comparator_;
+  // container
+  std::shared_ptr<BLinkTree<KeyType, ValueType, KeyComparator>> container_;
+};
+
+}  // namespace bustub
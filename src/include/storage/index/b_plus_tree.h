@@ -11,18 +11,21 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <iostream>
 #include <optional>
 #include <queue>
 #include <shared_mutex>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
 #include "common/config.h"
 #include "common/macros.h"
 #include "concurrency/transaction.h"
+#include "storage/index/adaptive_hash_index.h"
 #include "storage/index/index_iterator.h"
 #include "storage/page/b_plus_tree_header_page.h"
 #include "storage/page/b_plus_tree_internal_page.h"
@@ -33,6 +36,15 @@ namespace bustub {
 
 struct PrintableBPlusTree;
 
+/**
+ * A delete rebalances a node once it is less than this full, the classic B+ tree rule. Lower thresholds leave more
+ * sparse nodes behind but keep most deletes from touching anything but their leaf; 0 only rebalances empty nodes.
+ */
+static constexpr double EAGER_MERGE_THRESHOLD = 0.5;
+
+/** Optimistic descents a read tries before it falls back to latching its path, see FindLeafRead. */
+static constexpr int OPTIMISTIC_DESCENT_ATTEMPTS = 4;
+
 /**
  * @brief Definition of the Context class.
  *
@@ -43,6 +55,7 @@ class Context {
  public:
   // When you insert into / remove from the B+ tree, store the write guard of header page here.
   // Remember to drop the header page guard and set it to nullopt when you want to unlock all.
+  // Writers that only change their leaf never latch it.
   std::optional<WritePageGuard> header_page_{std::nullopt};
 
   // Save the root page id here so that it's easier to know if the current page is the root page.
@@ -54,6 +67,9 @@ class Context {
   // You may want to use this when getting value, but not necessary.
   std::deque<ReadPageGuard> read_set_;
 
+  // How full a node must stay before removing from it rebalances it, see EAGER_MERGE_THRESHOLD.
+  double merge_threshold_{EAGER_MERGE_THRESHOLD};
+
   auto IsRootPage(page_id_t page_id) -> bool { return page_id == root_page_id_; }
 };
 
@@ -62,6 +78,7 @@ class Context {
 // Main class providing the API for the Interactive B+ Tree.
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTree {
+  friend class INDEXITERATOR_TYPE;
   using InternalPage = BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator>;
   using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
   using InternalType = std::pair<KeyType, page_id_t>;
@@ -71,15 +88,22 @@ class BPlusTree {
                      const KeyComparator &comparator, int leaf_max_size = LEAF_PAGE_SIZE,
                      int internal_max_size = INTERNAL_PAGE_SIZE);
 
+  ~BPlusTree();
+
   // Returns true if this B+ tree has no keys and values.
   auto IsEmpty() const -> bool;
 
   // Insert a key-value pair into this B+ tree.
   auto Insert(const KeyType &key, const ValueType &value, Transaction *txn = nullptr) -> bool;
 
+  // Insert key-value pairs sorted by key, sharing the descent between keys of the same leaf.
+  auto InsertBatch(const std::vector<MappingType> &entries, Transaction *txn = nullptr) -> size_t;
+
   void InsertParent(const KeyType &key, page_id_t page_id, Context &ctx, page_id_t page_id_1);
+  void SplitLeaf(Context &ctx, WritePageGuard &leaf_guard);
   void Merge(Context &ctx, const KeyType &key, WritePageGuard &write_guard);
   void DeleteParent(WritePageGuard &write_guard, Context &ctx, int index, const KeyType &key);
+  auto RebalanceLeaf(Context &ctx, const KeyType &key, WritePageGuard &write_guard) -> bool;
 
   // Remove a key and its value from this B+ tree.
   void Remove(const KeyType &key, Transaction *txn);
@@ -87,9 +111,30 @@ class BPlusTree {
   // Return the value associated with a given key
   auto GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn = nullptr) -> bool;
 
+  // Return the values associated with each of the given keys, which must be sorted in ascending order
+  void GetValues(const std::vector<KeyType> &keys, std::vector<std::vector<ValueType>> *result,
+                 Transaction *txn = nullptr);
+
   // Return the page id of the root node
   auto GetRootPageId() -> page_id_t;
 
+  // Set how full a node must stay before a delete rebalances it, between 0 (only when empty) and 0.5 (the default)
+  void SetMergeThreshold(double threshold);
+
+  // Merge the leaves left sparse by deletes under a low merge threshold, return the number of leaves merged away
+  auto Compact(Transaction *txn = nullptr) -> size_t;
+
+  // Run Compact every b_plus_tree_compaction_interval on a background thread, until stopped or destroyed
+  void StartBackgroundCompaction();
+
+  void StopBackgroundCompaction();
+
+  // Turn the adaptive hash index over hot keys on or off, it is on by default
+  void SetAdaptiveHashIndexEnabled(bool enabled) { adaptive_hash_index_.SetEnabled(enabled); }
+
+  // Return the hit counters of the adaptive hash index
+  auto GetAdaptiveHashIndexStats() const -> AdaptiveHashIndexStats { return adaptive_hash_index_.GetStats(); }
+
   // Index iterator
   auto Begin() -> INDEXITERATOR_TYPE;
 
@@ -97,6 +142,18 @@ class BPlusTree {
 
   auto Begin(const KeyType &key) -> INDEXITERATOR_TYPE;
 
+  // Index iterator positioned at the first key strictly greater than the given key
+  auto BeginAfter(const KeyType &key) -> INDEXITERATOR_TYPE;
+
+  // Reverse index iterator, walking from the largest key towards the smallest one
+  auto RBegin() -> INDEXITERATOR_TYPE;
+
+  // Reverse index iterator positioned at the last key less than or equal to the given key
+  auto RBegin(const KeyType &key) -> INDEXITERATOR_TYPE;
+
+  // Reverse index iterator positioned at the last key strictly less than the given key
+  auto RBeginBefore(const KeyType &key) -> INDEXITERATOR_TYPE;
+
   // Print the B+ tree
   void Print(BufferPoolManager *bpm);
 
@@ -136,6 +193,68 @@ class BPlusTree {
    */
   auto ToPrintableBPlusTree(page_id_t root_id) -> PrintableBPlusTree;
 
+  /**
+   * @brief Descend to a leaf and read-latch it. The internal pages are read optimistically, without latching them,
+   * and only if writers keep getting in the way does the descent fall back to read latch coupling.
+   *
+   * @param key the key to search for, or nullptr for the leftmost (rightmost) leaf
+   * @param rightmost when key is nullptr, descend to the rightmost leaf instead of the leftmost one
+   * @return read guard of the leaf, or nullopt if the tree is empty
+   */
+  auto FindLeafRead(const KeyType *key, bool rightmost = false) -> std::optional<ReadPageGuard>;
+
+  /**
+   * @brief One optimistic descent of FindLeafRead.
+   *
+   * @param[out] leaf read guard of the leaf, or nullopt if the tree is empty
+   * @return false if a writer changed a page on the way, and the descent has to be tried again
+   */
+  auto FindLeafOptimistic(const KeyType *key, bool rightmost, std::optional<ReadPageGuard> *leaf) -> bool;
+
+  // Read-latch the root, or return nullopt if the tree is empty
+  auto FetchRootRead() -> std::optional<ReadPageGuard>;
+
+  /**
+   * @brief Prefetch the children of an internal page that GetValues descends to after the one of keys[from].
+   *
+   * @param keys the sorted keys of GetValues
+   * @param upper_bound exclusive upper bound of the keys reachable through the page, nullopt if there is none
+   */
+  void PrefetchChildren(const InternalPage *internal, const std::vector<KeyType> &keys, size_t from,
+                        const std::optional<KeyType> &upper_bound);
+
+  /**
+   * @brief Descend to a leaf to change it, keeping latched in ctx only the pages the operation may change as well.
+   *
+   * @param is_insert whether the leaf is descended to for an insert or for a remove
+   * @return write guard of the leaf, or nullopt if the tree is empty, with the header page latched in ctx
+   */
+  auto FindLeafWrite(const KeyType &key, Context &ctx, bool is_insert) -> std::optional<WritePageGuard>;
+
+  // Whether an insert (or remove) in the subtree of the page cannot split (or rebalance) the page
+  static auto IsSafe(const BPlusTreePage *page, bool is_root, bool is_insert, double merge_threshold) -> bool;
+
+  // Make root_page_id the root in the header page, which must be latched in ctx, and in the cached root page id
+  void SetRootPageId(Context &ctx, page_id_t root_page_id);
+
+  // Point the previous-leaf link of a leaf at pre_page_id, ignoring INVALID_PAGE_ID
+  void SetPrePageIdOf(page_id_t page_id, page_id_t pre_page_id);
+
+  /**
+   * @brief Answer a point lookup from the leaf cached in the adaptive hash index, without descending the tree.
+   *
+   * @return whether the key was found, or nullopt if the key has no valid entry and the tree must be descended
+   */
+  auto GetValueFromHashIndex(const KeyType &key, std::vector<ValueType> *result) -> std::optional<bool>;
+
+  // Smallest size a non-root leaf keeps without being rebalanced
+  static auto LeafMinSize(int max_size, double threshold) -> int;
+
+  // Smallest number of keys a non-root internal page keeps without being rebalanced
+  static auto InternalMinSize(int max_size, double threshold) -> int;
+
+  void RunCompaction();
+
   // member variable
   std::string index_name_;
   BufferPoolManager *bpm_;
@@ -144,6 +263,12 @@ class BPlusTree {
   int leaf_max_size_;
   int internal_max_size_;
   page_id_t header_page_id_;
+  // The root page id of the header page, read without latching the header page
+  std::atomic<page_id_t> root_page_id_{INVALID_PAGE_ID};
+  AdaptiveHashIndex<KeyType> adaptive_hash_index_;
+  std::atomic<double> merge_threshold_{EAGER_MERGE_THRESHOLD};
+  std::atomic<bool> enable_compaction_{false};
+  std::thread *compaction_thread_{nullptr};
 };
 
 /**
@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "container/hash/hash_function.h"
@@ -35,12 +36,39 @@ class BPlusTreeIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  void ScanRange(const Tuple *lower, const Tuple *upper, std::vector<RID> *result, Transaction *transaction) override;
+
+  /** ScanRange(), also returning the entry of each RID, e.g. to read the columns it stores without the table heap. */
+  void ScanRange(const Tuple *lower, const Tuple *upper, std::vector<RID> *result, std::vector<KeyType> *entries,
+                 Transaction *transaction);
+
+  auto InsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) -> size_t override;
+
+  void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *result,
+                Transaction *transaction) override;
+
+  /** Set how full a node of the tree must stay before a delete rebalances it, see BPlusTree::SetMergeThreshold. */
+  void SetMergeThreshold(double threshold) { container_->SetMergeThreshold(threshold); }
+
+  /** Merge the sparse leaves of the tree in the background, see BPlusTree::StartBackgroundCompaction. */
+  void StartBackgroundCompaction() { container_->StartBackgroundCompaction(); }
+
+  /** Turn the adaptive hash index of the tree on or off, it is on by default. */
+  void SetAdaptiveHashIndexEnabled(bool enabled) { container_->SetAdaptiveHashIndexEnabled(enabled); }
+
+  /** @return the hit counters of the adaptive hash index of the tree */
+  auto GetAdaptiveHashIndexStats() const -> AdaptiveHashIndexStats { return container_->GetAdaptiveHashIndexStats(); }
+
   auto GetBeginIterator() -> INDEXITERATOR_TYPE;
 
   auto GetBeginIterator(const KeyType &key) -> INDEXITERATOR_TYPE;
 
   auto GetEndIterator() -> INDEXITERATOR_TYPE;
 
+  auto GetReverseBeginIterator() -> INDEXITERATOR_TYPE;
+
+  auto GetReverseBeginIterator(const KeyType &key) -> INDEXITERATOR_TYPE;
+
  protected:
   // comparator for key
   KeyComparator comparator_;
@@ -48,7 +76,10 @@ class BPlusTreeIndex : public Index {
   std::shared_ptr<BPlusTree<KeyType, ValueType, KeyComparator>> container_;
 };
 
-/** We only support index table with one integer key for now in BusTub. Hardcode everything here. */
+/**
+ * Index types for keys of up to two INTEGER columns. CREATE INDEX picks the key width from the key schema, these
+ * are kept for callers that build such indexes directly.
+ */
 
 constexpr static const auto TWO_INTEGER_SIZE = 8;
 using IntegerKeyType = GenericKey<TWO_INTEGER_SIZE>;
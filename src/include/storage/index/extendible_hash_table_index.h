@@ -39,6 +39,9 @@ class ExtendibleHashTableIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  /** Only the range of a single key, `lower == upper`, can be scanned. */
+  void ScanRange(const Tuple *lower, const Tuple *upper, std::vector<RID> *result, Transaction *transaction) override;
+
  protected:
   // comparator for key
   KeyComparator comparator_;
@@ -14,8 +14,8 @@
 
 #include <cstring>
 
+#include "storage/index/key_encoder.h"
 #include "storage/table/tuple.h"
-#include "type/value.h"
 
 namespace bustub {
 
@@ -24,43 +24,26 @@ namespace bustub {
  *
  * This key type uses an fixed length array to hold data for indexing
  * purposes, the actual size of which is specified and instantiated
- * with a template argument.
+ * with a template argument. The key tuple is stored in the binary-comparable
+ * form produced by KeyEncoder, so two keys compare with a single memcmp.
  */
 template <size_t KeySize>
 class GenericKey {
  public:
-  inline void SetFromKey(const Tuple &tuple) {
-    // intialize to 0
-    memset(data_, 0, KeySize);
-    memcpy(data_, tuple.GetData(), tuple.GetLength());
+  /** @return the number of bytes used by the encoded key, the rest is zero-filled */
+  inline auto SetFromKey(const Tuple &tuple, const Schema &key_schema) -> size_t {
+    return KeyEncoder::Encode(tuple, key_schema, data_, KeySize);
   }
 
   // NOTE: for test purpose only
-  inline void SetFromInteger(int64_t key) {
-    memset(data_, 0, KeySize);
-    memcpy(data_, &key, sizeof(int64_t));
-  }
-
-  inline auto ToValue(Schema *schema, uint32_t column_idx) const -> Value {
-    const char *data_ptr;
-    const auto &col = schema->GetColumn(column_idx);
-    const TypeId column_type = col.GetType();
-    const bool is_inlined = col.IsInlined();
-    if (is_inlined) {
-      data_ptr = (data_ + col.GetOffset());
-    } else {
-      int32_t offset = *reinterpret_cast<int32_t *>(const_cast<char *>(data_ + col.GetOffset()));
-      data_ptr = (data_ + offset);
-    }
-    return Value::DeserializeFrom(data_ptr, column_type);
-  }
+  inline void SetFromInteger(int64_t key) { KeyEncoder::EncodeInteger(key, data_, KeySize); }
 
   // NOTE: for test purpose only
-  // interpret the first 8 bytes as int64_t from data vector
-  inline auto ToString() const -> int64_t { return *reinterpret_cast<int64_t *>(const_cast<char *>(data_)); }
+  // decode the first 8 bytes as an int64_t written by SetFromInteger
+  inline auto ToString() const -> int64_t { return KeyEncoder::DecodeInteger(data_); }
 
   // NOTE: for test purpose only
-  // interpret the first 8 bytes as int64_t from data vector
+  // decode the first 8 bytes as an int64_t written by SetFromInteger
   friend auto operator<<(std::ostream &os, const GenericKey &key) -> std::ostream & {
     os << key.ToString();
     return os;
@@ -77,21 +60,7 @@ template <size_t KeySize>
 class GenericComparator {
  public:
   inline auto operator()(const GenericKey<KeySize> &lhs, const GenericKey<KeySize> &rhs) const -> int {
-    uint32_t column_count = key_schema_->GetColumnCount();
-
-    for (uint32_t i = 0; i < column_count; i++) {
-      Value lhs_value = (lhs.ToValue(key_schema_, i));
-      Value rhs_value = (rhs.ToValue(key_schema_, i));
-
-      if (lhs_value.CompareLessThan(rhs_value) == CmpBool::CmpTrue) {
-        return -1;
-      }
-      if (lhs_value.CompareGreaterThan(rhs_value) == CmpBool::CmpTrue) {
-        return 1;
-      }
-    }
-    // equals
-    return 0;
+    return memcmp(lhs.data_, rhs.data_, KeySize);
   }
 
   GenericComparator(const GenericComparator &other) : key_schema_{other.key_schema_} {}
@@ -99,6 +68,9 @@ class GenericComparator {
   // constructor
   explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {}
 
+  /** @return the schema of the keys, the comparison itself does not need it */
+  inline auto GetKeySchema() const -> Schema * { return key_schema_; }
+
  private:
   Schema *key_schema_;
 };
@@ -18,6 +18,8 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/exception.h"
+#include "fmt/format.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
@@ -43,11 +45,15 @@ class IndexMetadata {
    * @param table_name The name of the table on which the index is created
    * @param tuple_schema The schema of the indexed key
    * @param key_attrs The mapping from indexed columns to base table columns
+   * @param include_attrs The base table columns stored in the index entries in addition to the key
    */
   IndexMetadata(std::string index_name, std::string table_name, const Schema *tuple_schema,
-                std::vector<uint32_t> key_attrs)
+                std::vector<uint32_t> key_attrs, const std::vector<uint32_t> &include_attrs = {})
       : name_(std::move(index_name)), table_name_(std::move(table_name)), key_attrs_(std::move(key_attrs)) {
     key_schema_ = std::make_shared<Schema>(Schema::CopySchema(tuple_schema, key_attrs_));
+    entry_attrs_ = key_attrs_;
+    entry_attrs_.insert(entry_attrs_.end(), include_attrs.begin(), include_attrs.end());
+    entry_schema_ = std::make_shared<Schema>(Schema::CopySchema(tuple_schema, entry_attrs_));
   }
 
   ~IndexMetadata() = default;
@@ -72,6 +78,15 @@ class IndexMetadata {
   /** @return The mapping relation between indexed columns and base table columns */
   inline auto GetKeyAttrs() const -> const std::vector<uint32_t> & { return key_attrs_; }
 
+  /** @return The schema of an index entry: the key columns followed by the included columns */
+  inline auto GetEntrySchema() const -> Schema * { return entry_schema_.get(); }
+
+  /** @return The mapping relation between index entry columns and base table columns */
+  inline auto GetEntryAttrs() const -> const std::vector<uint32_t> & { return entry_attrs_; }
+
+  /** @return true if the index stores columns in addition to the key */
+  inline auto HasIncludedColumns() const -> bool { return entry_attrs_.size() > key_attrs_.size(); }
+
   /** @return A string representation for debugging */
   auto ToString() const -> std::string {
     std::stringstream os;
@@ -94,6 +109,10 @@ class IndexMetadata {
   const std::vector<uint32_t> key_attrs_;
   /** The schema of the indexed key */
   std::shared_ptr<Schema> key_schema_;
+  /** The mapping relation between entry schema and tuple schema */
+  std::vector<uint32_t> entry_attrs_;
+  /** The schema of the index entries */
+  std::shared_ptr<Schema> entry_schema_;
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -139,6 +158,12 @@ class Index {
   /** @return The index key attributes */
   auto GetKeyAttrs() const -> const std::vector<uint32_t> & { return metadata_->GetKeyAttrs(); }
 
+  /** @return The schema of the index entries, the key columns followed by the included columns */
+  auto GetEntrySchema() const -> Schema * { return metadata_->GetEntrySchema(); }
+
+  /** @return The index entry attributes */
+  auto GetEntryAttrs() const -> const std::vector<uint32_t> & { return metadata_->GetEntryAttrs(); }
+
   /** @return A string representation for debugging */
   auto ToString() const -> std::string {
     std::stringstream os;
@@ -153,7 +178,7 @@ class Index {
 
   /**
    * Insert an entry into the index.
-   * @param key The index key
+   * @param key The index entry, laid out by the entry schema
    * @param rid The RID associated with the key
    * @param transaction The transaction context
    * @returns whether insertion is successful
@@ -162,7 +187,7 @@ class Index {
 
   /**
    * Delete an index entry by key.
-   * @param key The index key
+   * @param key The index entry, laid out by the entry schema
    * @param rid The RID associated with the key (unused)
    * @param transaction The transaction context
    */
@@ -176,6 +201,52 @@ class Index {
    */
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  /**
+   * Search the index for the keys between two bounds, both inclusive. Only ordered indexes support this.
+   * @param lower The smallest key to return, or nullptr to start at the smallest key of the index
+   * @param upper The largest key to return, or nullptr to stop at the largest key of the index
+   * @param result The collection of RIDs that is populated with results of the search, in key order
+   * @param transaction The transaction context
+   */
+  virtual void ScanRange(const Tuple *lower, const Tuple *upper, std::vector<RID> *result, Transaction *transaction) {
+    throw NotImplementedException(fmt::format("index {} does not support range scans", GetName()));
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Batch Operations
+  ///////////////////////////////////////////////////////////////////
+
+  /**
+   * Insert a batch of entries into the index. Indexes that can share work between
+   * keys should override this, the default inserts the entries one by one.
+   * @param entries The index entries and the RIDs associated with them
+   * @param transaction The transaction context
+   * @returns the number of entries inserted
+   */
+  virtual auto InsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) -> size_t {
+    size_t inserted = 0;
+    for (const auto &[key, rid] : entries) {
+      if (InsertEntry(key, rid, transaction)) {
+        inserted++;
+      }
+    }
+    return inserted;
+  }
+
+  /**
+   * Search the index for a batch of keys. The default probes the keys one by one.
+   * @param keys The index keys, in any order
+   * @param result result[i] is populated with the RIDs matching keys[i]
+   * @param transaction The transaction context
+   */
+  virtual void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *result,
+                        Transaction *transaction) {
+    result->assign(keys.size(), std::vector<RID>{});
+    for (size_t i = 0; i < keys.size(); i++) {
+      ScanKey(keys[i], &(*result)[i], transaction);
+    }
+  }
+
  private:
   /** The Index structure owns its metadata */
   std::unique_ptr<IndexMetadata> metadata_;
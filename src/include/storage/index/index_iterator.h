@@ -13,19 +13,44 @@
  * For range scan of b+ tree
  */
 #pragma once
+#include <utility>
+#include <vector>
+
 #include "storage/page/b_plus_tree_leaf_page.h"
+#include "storage/page/page_guard.h"
 
 namespace bustub {
 
 #define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator>
 
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTree;
+
+/**
+ * The iterator works on a snapshot of one leaf at a time: when it lands on a leaf it copies all entries
+ * out under a single ReadPageGuard and releases the latch right away, so dereferencing and advancing
+ * inside a leaf never touch the buffer pool. The next leaf is fetched only at the page boundary. If the
+ * leaf chain changed in the meantime (a split, merge or redistribution touched the current leaf, or the
+ * next leaf was freed), the iterator re-seeks from the root by the last returned key.
+ *
+ * A reverse iterator walks the same way from the largest key towards the smallest one, following the
+ * previous-leaf links instead.
+ */
 INDEX_TEMPLATE_ARGUMENTS
 class IndexIterator {
   using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
 
  public:
-  // you may de       fine your own constructor based on your member variables
-  explicit IndexIterator(page_id_t page_id = INVALID_PAGE_ID, int num = -1, BufferPoolManager *bpm = nullptr);
+  /** Construct an end iterator. */
+  IndexIterator() = default;
+
+  /**
+   * Construct an iterator positioned at entry `num` of the leaf held by `guard`.
+   * The guard is released once the leaf has been copied out.
+   * @param reverse if true, operator++ moves towards smaller keys
+   */
+  IndexIterator(BPlusTree<KeyType, ValueType, KeyComparator> *tree, BufferPoolManager *bpm, ReadPageGuard guard,
+                int num, bool reverse = false);
   ~IndexIterator();  // NOLINT
 
   auto IsEnd() -> bool;
@@ -43,10 +68,32 @@ class IndexIterator {
   }
 
  private:
-  // add your own private member variables here
-  BufferPoolManager *bpm_;
-  page_id_t page_id_;
-  int num_;
+  /** Copy the leaf held by `guard` into entries_ and drop the guard. */
+  void LoadLeaf(ReadPageGuard &guard);
+
+  /**
+   * Move to the first entry of the next leaf (the last entry of the previous leaf for a reverse iterator),
+   * re-seeking from the root if the leaf chain changed under us.
+   */
+  void NextLeaf();
+
+  /** @return true if the current leaf still looks exactly like the copy in entries_ */
+  auto LeafUnchanged() -> bool;
+
+  /** Turn this iterator into the end iterator. */
+  void SetEnd();
+
+  BPlusTree<KeyType, ValueType, KeyComparator> *tree_{nullptr};
+  BufferPoolManager *bpm_{nullptr};
+  page_id_t page_id_{INVALID_PAGE_ID};
+  int num_{-1};
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  page_id_t pre_page_id_{INVALID_PAGE_ID};
+  // page version of the current leaf when it was copied, see Page::GetVersion
+  uint64_t leaf_version_{0};
+  bool reverse_{false};
+  // entries of the current leaf, copied out under its read latch
+  std::vector<MappingType> entries_;
 };
 
 }  // namespace bustub
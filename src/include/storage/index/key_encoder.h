@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// key_encoder.h
+//
+// Identification: src/include/storage/index/key_encoder.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * KeyEncoder turns an index key tuple into a binary-comparable byte string: comparing two encoded keys with
+ * memcmp gives the same order as comparing their columns one by one.
+ *
+ * Every column starts with a one-byte marker, 0x00 for NULL (so NULLs sort first, and nothing else follows)
+ * or 0x01 otherwise, followed by:
+ *  - integers (BOOLEAN, TINYINT, SMALLINT, INTEGER, BIGINT): big-endian with the sign bit flipped
+ *  - DECIMAL: the IEEE-754 bits big-endian, all bits flipped for negative values, only the sign bit otherwise
+ *  - TIMESTAMP: big-endian
+ *  - VARCHAR: the bytes of the string with 0x00 escaped as 0x00 0xFF, terminated by 0x00 0x00
+ * The rest of the key is zero-filled.
+ */
+class KeyEncoder {
+ public:
+  /**
+   * @return the number of bytes needed to encode any key of the schema, assuming VARCHARs stay within their
+   * declared length and hold no NUL byte (neither can come from SQL)
+   */
+  static auto EncodedSize(const Schema &key_schema) -> size_t;
+
+  /**
+   * Encode the key tuple into `data`.
+   * @return the number of bytes used, the encoding of a key is a prefix of the encoding of any longer key that
+   * starts with the same columns
+   * @throw Exception if the encoded key does not fit in `size` bytes
+   */
+  static auto Encode(const Tuple &key, const Schema &key_schema, char *data, size_t size) -> size_t;
+
+  /** @return the values of the columns of `key_schema` decoded from a key written by Encode */
+  static auto Decode(const char *data, const Schema &key_schema) -> std::vector<Value>;
+
+  /** Encode a BIGINT without a NULL marker, for keys built directly from integers in tests. */
+  static void EncodeInteger(int64_t key, char *data, size_t size);
+
+  /** Decode a key written by EncodeInteger. */
+  static auto DecodeInteger(const char *data) -> int64_t;
+};
+
+}  // namespace bustub
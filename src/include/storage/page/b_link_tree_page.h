@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_link_tree_page.h
+//
+// Identification: src/include/storage/page/b_link_tree_page.h
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "storage/page/b_plus_tree_page.h"
+
+namespace bustub {
+
+#define B_LINK_TREE_PAGE_TYPE BLinkTreePage<KeyType, ValueType, KeyComparator>
+#define B_LINK_PAGE_HEADER_SIZE (24 + sizeof(KeyType))
+#define B_LINK_PAGE_SIZE ((BUSTUB_PAGE_SIZE - B_LINK_PAGE_HEADER_SIZE) / sizeof(MappingType))
+#define B_LINK_INTERNAL_PAGE_SIZE ((BUSTUB_PAGE_SIZE - B_LINK_PAGE_HEADER_SIZE) / sizeof(std::pair<KeyType, page_id_t>))
+
+/**
+ * A node of a Lehman-Yao B-link tree. Leaves store key + RID pairs (ValueType = RID), internal nodes store
+ * key + child page id pairs (ValueType = page_id_t) and, like BPlusTreeInternalPage, ignore the first key.
+ *
+ * Every node has a link to its right sibling on the same level and a high key: an upper bound (exclusive)
+ * of the keys that may be found in its subtree. The rightmost node of each level has no high key. A key
+ * greater than or equal to the high key has moved to the right during a split, so the search continues on
+ * the right sibling instead of failing.
+ *
+ * Page format:
+ *  ----------------------------------------------------------------------------
+ * | HEADER | KEY(1) + VALUE(1) | KEY(2) + VALUE(2) | ... | KEY(n) + VALUE(n)
+ *  ----------------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 24 + sizeof(KeyType) bytes in total):
+ *  ----------------------------------------------------------------------------
+ * | PageType (4) | CurrentSize (4) | MaxSize (4) | RightPageId (4) | Level (4) |
+ *  ----------------------------------------------------------------------------
+ *  ------------------------------------
+ * | HasHighKey (4) | HighKey (KeySize)
+ *  ------------------------------------
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BLinkTreePage : public BPlusTreePage {
+ public:
+  // Delete all constructor / destructor to ensure memory safety
+  BLinkTreePage() = delete;
+  BLinkTreePage(const BLinkTreePage &other) = delete;
+
+  /**
+   * After creating a new page from buffer pool, must call initialize method to set default values
+   * @param max_size Max size of the node
+   * @param level Level of the node, leaves are on level 0
+   */
+  void Init(int max_size = B_LINK_PAGE_SIZE, int level = 0);
+
+  auto GetRightPageId() const -> page_id_t;
+  void SetRightPageId(page_id_t right_page_id);
+  auto GetLevel() const -> int;
+
+  auto HasHighKey() const -> bool;
+  auto GetHighKey() const -> KeyType;
+  void SetHighKey(const KeyType &high_key);
+
+  /** @return true if the key is not covered by this node and the search has to move to the right sibling */
+  auto ShouldMoveRight(const KeyType &key, const KeyComparator &comparator) const -> bool;
+
+  auto KeyAt(int index) const -> KeyType;
+  auto ValueAt(int index) const -> ValueType;
+
+  /** @return the index of the first key >= key, or GetSize() if there is none (leaf only) */
+  auto LowerBound(const KeyType &key, const KeyComparator &comparator) const -> int;
+
+  /** @return the index of the child whose subtree covers the key (internal only) */
+  auto ChildIndex(const KeyType &key, const KeyComparator &comparator) const -> int;
+
+  void InsertAt(int index, const KeyType &key, const ValueType &value);
+  void RemoveAt(int index);
+
+  /** Move the upper half of the entries to the freshly initialized right sibling `recipient`. */
+  void MoveHalfTo(B_LINK_TREE_PAGE_TYPE *recipient);
+
+ private:
+  page_id_t right_page_id_;
+  int level_;
+  int has_high_key_;
+  KeyType high_key_;
+  // Flexible array member for page data.
+  MappingType array_[0];
+};
+
+}  // namespace bustub
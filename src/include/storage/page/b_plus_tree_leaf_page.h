@@ -20,7 +20,7 @@
 namespace bustub {
 
 #define B_PLUS_TREE_LEAF_PAGE_TYPE BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>
-#define LEAF_PAGE_HEADER_SIZE 16
+#define LEAF_PAGE_HEADER_SIZE 20
 #define LEAF_PAGE_SIZE ((BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / sizeof(MappingType))
 
 /**
@@ -33,12 +33,12 @@ namespace bustub {
  * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
  *  ----------------------------------------------------------------------
  *
- *  Header format (size in byte, 16 bytes in total):
+ *  Header format (size in byte, 20 bytes in total):
  *  ---------------------------------------------------------------------
  * | PageType (4) | CurrentSize (4) | MaxSize (4) |
  *  ---------------------------------------------------------------------
  *  -----------------------------------------------
- * |  NextPageId (4)
+ * |  NextPageId (4) | PrePageId (4)
  *  -----------------------------------------------
  */
 INDEX_TEMPLATE_ARGUMENTS
@@ -58,8 +58,8 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   // helper methods
   auto GetNextPageId() const -> page_id_t;
   void SetNextPageId(page_id_t next_page_id);
-  // auto GetPrePageId() const -> page_id_t;
-  // void SetPrePageId(page_id_t next_page_id);
+  auto GetPrePageId() const -> page_id_t;
+  void SetPrePageId(page_id_t pre_page_id);
   auto KeyAt(int index) const -> KeyType;
   auto ValueAt(int index) const -> ValueType;
   auto FindValue(const KeyType &key, const KeyComparator &comparator, std::vector<ValueType> *result) const -> bool;
@@ -69,6 +69,7 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   void CopyIn(std::shared_ptr<MappingType[]> &tmp);
   void Copy(B_PLUS_TREE_LEAF_PAGE_TYPE *page_p);
   auto KeyIndex(const KeyType &key, const KeyComparator &comparator) const -> int;
+  auto LowerBound(const KeyType &key, const KeyComparator &comparator) const -> int;
   auto PairAt(int index) const -> const MappingType &;
   void Remove(const KeyType &key, const KeyComparator &comparator);
   void Remove(int index);
@@ -100,7 +101,7 @@ class BPlusTreeLeafPage : public BPlusTreePage {
 
  private:
   page_id_t next_page_id_;
-  // page_id_t pre_page_id_;
+  page_id_t pre_page_id_;
   //  Flexible array member for page data.
   MappingType array_[0];
 };
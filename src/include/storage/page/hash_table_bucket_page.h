@@ -30,9 +30,13 @@ namespace bustub {
  *  ----------------------------------------------------------------
  *
  *  Here '+' means concatenation.
- *  The above format omits the space required for the occupied_ and
- *  readable_ arrays. More information is in storage/page/hash_table_page_defs.h.
+ *  The above format omits the space required for the next page id and the
+ *  occupied_ and readable_ arrays. More information is in
+ *  storage/page/hash_table_page_defs.h.
  *
+ *  A bucket that cannot be split any more, because the directory is as large
+ *  as it gets, goes on in overflow pages of the same format, chained through
+ *  the next page id.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class HashTableBucketPage {
@@ -132,12 +136,25 @@ class HashTableBucketPage {
    */
   auto IsEmpty() -> bool;
 
+  /**
+   * @return the page id of the next overflow page of the bucket, INVALID_PAGE_ID if there is none
+   */
+  auto GetNextPageId() const -> page_id_t;
+
+  /**
+   * Sets the page id of the next overflow page of the bucket.
+   *
+   * @param next_page_id the overflow page to chain after this page
+   */
+  void SetNextPageId(page_id_t next_page_id);
+
   /**
    * Prints the bucket's occupancy information
    */
   void PrintBucket();
 
  private:
+  page_id_t next_page_id_;
   //  For more on BUCKET_ARRAY_SIZE see storage/page/hash_table_page_defs.h
   char occupied_[(BUCKET_ARRAY_SIZE - 1) / 8 + 1];
   // 0 if tombstone/brand new (never occupied), 1 otherwise.
@@ -12,14 +12,23 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstring>
 #include <iostream>
 
 #include "common/config.h"
+#include "common/reader_biased_latch.h"
 #include "common/rwlatch.h"
 
 namespace bustub {
 
+#ifdef BUSTUB_READER_BIASED_PAGE_LATCH
+/** Page latches keep their readers apart, see ReaderBiasedLatch. */
+using PageLatch = ReaderBiasedLatch<>;
+#else
+using PageLatch = ReaderWriterLatch;
+#endif
+
 /**
  * Page is the basic unit of storage within the database system. Page provides a wrapper for actual data pages being
  * held in main memory. Page also contains book-keeping information that is used by the buffer pool manager, e.g.
@@ -52,10 +61,18 @@ class Page {
   inline auto IsDirty() -> bool { return is_dirty_; }
 
   /** Acquire the page write latch. */
-  inline void WLatch() { rwlatch_.WLock(); }
+  inline void WLatch() {
+    rwlatch_.WLock();
+    version_.fetch_add(1);
+    // the writes to the page must not be seen before the version turns odd
+    std::atomic_thread_fence(std::memory_order_release);
+  }
 
   /** Release the page write latch. */
-  inline void WUnlatch() { rwlatch_.WUnlock(); }
+  inline void WUnlatch() {
+    version_.fetch_add(1, std::memory_order_release);
+    rwlatch_.WUnlock();
+  }
 
   /** Acquire the page read latch. */
   inline void RLatch() { rwlatch_.RLock(); }
@@ -63,6 +80,14 @@ class Page {
   /** Release the page read latch. */
   inline void RUnlatch() { rwlatch_.RUnlock(); }
 
+  /**
+   * @return the version of the page, odd while the page is write-latched. Every write latch moves it forward, so
+   * a page read without a latch was not written in the meantime if its version is the same, and even, before and
+   * after the read. The buffer pool gives the frame a version never used before whenever it puts a page in it, so
+   * the same page at the same version is the same unwritten page, even if it was evicted and fetched again.
+   */
+  inline auto GetVersion() const -> uint64_t { return version_.load(std::memory_order_acquire); }
+
   /** @return the page LSN. */
   inline auto GetLSN() -> lsn_t { return *reinterpret_cast<lsn_t *>(GetData() + OFFSET_LSN); }
 
@@ -92,7 +117,9 @@ class Page {
   /** True if the page is dirty, i.e. it is different from its corresponding page on disk. */
   bool is_dirty_ = false;
   /** Page latch. */
-  ReaderWriterLatch rwlatch_;
+  PageLatch rwlatch_;
+  /** Bumped when the write latch is taken and when it is released, see GetVersion. */
+  std::atomic<uint64_t> version_{0};
 };
 
 }  // namespace bustub
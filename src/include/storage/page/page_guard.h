@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "storage/page/page.h"
 
 namespace bustub {
@@ -81,6 +83,7 @@ class BasicPageGuard {
  private:
   friend class ReadPageGuard;
   friend class WritePageGuard;
+  friend class OptimisticPageGuard;
 
   [[maybe_unused]] BufferPoolManager *bpm_{nullptr};
   Page *page_{nullptr};
@@ -142,6 +145,9 @@ class ReadPageGuard {
     return guard_.As<T>();
   }
 
+  /** @return the version of the page, which does not move while the read latch is held, see Page::GetVersion */
+  auto GetVersion() const -> uint64_t { return guard_.page_->GetVersion(); }
+
  private:
   // You may choose to get rid of this and add your own private variables.
   BasicPageGuard guard_;
@@ -216,4 +222,62 @@ class WritePageGuard {
   bool already_unlock_{false};
 };
 
+/**
+ * OptimisticPageGuard pins a page without latching it. The page may be written while it is read, so what is read
+ * through the guard is only known to be consistent once Validate returns true after the reads: the page was not
+ * write-latched from the moment the guard was made until then. Reading a page this way writes nothing to it, unlike
+ * a read latch, which every reader of a hot page would take turns to modify.
+ */
+class OptimisticPageGuard {
+ public:
+  OptimisticPageGuard() = default;
+
+  OptimisticPageGuard(BufferPoolManager *bpm, Page *page);
+
+  OptimisticPageGuard(const OptimisticPageGuard &) = delete;
+  auto operator=(const OptimisticPageGuard &) -> OptimisticPageGuard & = delete;
+
+  OptimisticPageGuard(OptimisticPageGuard &&that) noexcept = default;
+
+  auto operator=(OptimisticPageGuard &&that) noexcept -> OptimisticPageGuard & = default;
+
+  /** Unpin the page. */
+  void Drop() { guard_.Drop(); }
+
+  ~OptimisticPageGuard() = default;
+
+  /** @return false if the page could not be fetched, or was write-latched when the guard was made */
+  auto IsValid() const -> bool { return guard_.page_ != nullptr && version_ % 2 == 0; }
+
+  /** @return true if the page was not written since the guard was made, i.e. what was read so far is consistent */
+  auto Validate() const -> bool;
+
+  /**
+   * Copy the page and check that the copy is consistent.
+   * @return false if the page was written since the guard was made, in which case the copy must not be used
+   */
+  auto CopyData(char *data) const -> bool;
+
+  /**
+   * Read-latch the page, keeping the pin.
+   * @return the read guard of the page, or nullopt if the page was written since the guard was made
+   */
+  auto UpgradeRead() -> std::optional<ReadPageGuard>;
+
+  auto PageId() -> page_id_t { return guard_.PageId(); }
+
+  /** Only consistent once validated. */
+  auto GetData() -> const char * { return guard_.GetData(); }
+
+  template <class T>
+  auto As() -> const T * {
+    return guard_.As<T>();
+  }
+
+ private:
+  BasicPageGuard guard_;
+  /** The version of the page when the guard was made */
+  uint64_t version_{0};
+};
+
 }  // namespace bustub
@@ -1,15 +1,13 @@
 #pragma once
 
+#include <cstring>
+
 #include "storage/page/page.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
-// To pass the test cases for this class, you must follow the existing TmpTuplePage format and implement the
-// existing functions exactly as they are! It may be helpful to look at TablePage.
-// Remember that this task is optional, you get full credit if you finish the next task.
-
 /**
  * TmpTuplePage format:
  *
@@ -17,20 +15,52 @@ namespace bustub {
  * | PageId (4) | LSN (4) | FreeSpace (4) | (free space) | TupleSize2 | TupleData2 | TupleSize1 | TupleData1 |
  *
  * We choose this format because DeserializeExpression expects to read Size followed by Data.
+ *
+ * FreeSpace is the offset of the end of the free space, i.e. of the tuple inserted last. The tuples grow from the end
+ * of the page towards the header, so that reading from FreeSpace to the end of the page visits them in the reverse
+ * order of their insertion.
  */
 class TmpTuplePage : public Page {
  public:
   void Init(page_id_t page_id, uint32_t page_size) {
     memcpy(GetData(), &page_id, sizeof(page_id_t));
-    memcpy(GetData() + sizeof(page_id_t), &page_size, sizeof(uint32_t));
+    memcpy(GetData() + OFFSET_FREE_SPACE, &page_size, sizeof(uint32_t));
   }
 
-  auto GetTablePageId() -> page_id_t { return INVALID_PAGE_ID; }
+  auto GetTablePageId() -> page_id_t { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  /** @return the offset of the tuple inserted last, or the size of the page if there is none */
+  auto GetFreeSpacePointer() -> uint32_t { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
 
-  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool { return false; }
+  /**
+   * Insert a tuple into the page.
+   * @param tuple the tuple to insert
+   * @param[out] out the location of the inserted tuple
+   * @return false if the page has no room for the tuple
+   */
+  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool {
+    uint32_t free_space = GetFreeSpacePointer();
+    uint32_t size = sizeof(uint32_t) + tuple.GetLength();
+    if (free_space < SIZE_HEADER + size) {
+      return false;
+    }
+    free_space -= size;
+    tuple.SerializeTo(GetData() + free_space);
+    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space, sizeof(uint32_t));
+    *out = TmpTuple(GetTablePageId(), free_space);
+    return true;
+  }
+
+  /** Read the tuple at `offset` into `tuple`. @return the offset of the tuple after it, inserted before it */
+  auto Get(size_t offset, Tuple *tuple) -> size_t {
+    tuple->DeserializeFrom(GetData() + offset);
+    return offset + sizeof(uint32_t) + tuple->GetLength();
+  }
 
  private:
   static_assert(sizeof(page_id_t) == 4);
+  static constexpr size_t OFFSET_FREE_SPACE = sizeof(page_id_t) + sizeof(lsn_t);
+  static constexpr size_t SIZE_HEADER = OFFSET_FREE_SPACE + sizeof(uint32_t);
 };
 
 }  // namespace bustub
@@ -15,6 +15,7 @@
 #include <mutex>  // NOLINT
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "common/config.h"
@@ -67,6 +68,14 @@ class TableHeap {
    */
   auto GetTuple(RID rid) -> std::pair<TupleMeta, Tuple>;
 
+  /**
+   * Read many tuples from the table, fetching and latching each page once however many of the rids it holds. The
+   * pages are prefetched, so that reading the ones not in the buffer pool overlaps with copying from the others.
+   * @param rids rids of the tuples to read, in any order
+   * @return the meta and tuple of each rid, in the order of `rids`
+   */
+  auto GetTuples(const std::vector<RID> &rids) -> std::vector<std::pair<TupleMeta, Tuple>>;
+
   /**
    * Read a tuple meta from the table. Note: if you want to get tuple and meta together, use `GetTuple` insead
    * to ensure atomicity.
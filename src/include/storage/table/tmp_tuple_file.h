@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.h
+//
+// Identification: src/include/storage/table/tmp_tuple_file.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "storage/disk/tmp_file_manager.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TmpTupleFile is a temporary, append-only file of tuples, such as a partition that an operator spills to disk.
+ *
+ * Tuples are appended to a TmpTuplePage that the file owns outside the buffer pool. When it is full, it is written to
+ * a new page of a TmpFileManager, and read back into the same TmpTuplePage; so a file neither takes a frame of the
+ * buffer pool nor grows the database file, however many files there are. The pages are given back to the manager with
+ * the file.
+ *
+ * The tuples are read back with Next(), a page at a time, in the order of the pages but in the reverse order of their
+ * insertion within each page.
+ */
+class TmpTupleFile {
+ public:
+  explicit TmpTupleFile(TmpFileManager *tmp_files);
+
+  ~TmpTupleFile();
+
+  DISALLOW_COPY_AND_MOVE(TmpTupleFile);
+
+  /** Append a tuple, which must fit in a page. */
+  void Append(const Tuple &tuple);
+
+  /** Start reading the tuples from the first, after which no tuple can be appended. */
+  void Rewind();
+
+  /** Read the next tuple. @return false if all the tuples were read */
+  auto Next(Tuple *tuple) -> bool;
+
+  /** @return the number of tuples appended */
+  auto GetTupleCount() const -> size_t { return tuple_count_; }
+
+  /** @return the number of bytes of the pages written to the temporary file */
+  auto GetSpilledBytes() const -> size_t { return pages_.size() * BUSTUB_PAGE_SIZE; }
+
+ private:
+  /** Write the page being written, if it holds any tuple, to a new page of the temporary file. */
+  void Flush();
+
+  TmpFileManager *tmp_files_;
+  /** The pages of the file in the temporary file, in the order they were written */
+  std::vector<page_id_t> pages_;
+  /** The page being written, or the page being read */
+  TmpTuplePage page_;
+  size_t tuple_count_{0};
+  /** False once the file is being read */
+  bool writing_{true};
+
+  /** The read cursor: the next page to read and the offset of the next tuple in `page_` */
+  size_t next_page_{0};
+  size_t offset_{BUSTUB_PAGE_SIZE};
+};
+
+}  // namespace bustub
@@ -0,0 +1,197 @@
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "common/exception.h"
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/bitmap_heap_scan_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** BusTub keeps no statistics, so these are the usual textbook guesses for the share of rows a predicate keeps. */
+constexpr double EQUALITY_SELECTIVITY = 0.005;
+constexpr double RANGE_SELECTIVITY = 1.0 / 3;
+
+/**
+ * Above this selectivity enough rows match that fetching them in key order would visit the same table pages over
+ * and over, so the RIDs are sorted by page first.
+ */
+constexpr double BITMAP_SCAN_SELECTIVITY = 0.01;
+
+/** The bounds that a filter puts on the key of an index, both inclusive. */
+struct KeyRange {
+  AbstractExpressionRef lower_;
+  AbstractExpressionRef upper_;
+  double selectivity_{1};
+};
+
+void CollectConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts) {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    CollectConjuncts(logic_expr->GetChildAt(0), conjuncts);
+    CollectConjuncts(logic_expr->GetChildAt(1), conjuncts);
+    return;
+  }
+  conjuncts->push_back(expr);
+}
+
+auto IsIntegral(TypeId type) -> bool {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+/** @return the constant as a key of the index column, or nullopt if it cannot bound the column */
+auto CastToKey(const Value &value, TypeId key_type) -> std::optional<Value> {
+  if (value.IsNull()) {
+    return std::nullopt;
+  }
+  if (value.GetTypeId() == key_type) {
+    return value;
+  }
+  if (!IsIntegral(value.GetTypeId()) || !IsIntegral(key_type)) {
+    return std::nullopt;
+  }
+  try {
+    return value.CastAs(key_type);
+  } catch (const Exception &) {
+    // out of the range of the column, leave this side of the range open
+    return std::nullopt;
+  }
+}
+
+/** @return the bounds that the conjuncts of the form `column <op> constant` or `constant <op> column` put on a key */
+auto MatchKeyRange(const std::vector<AbstractExpressionRef> &conjuncts, uint32_t key_col_idx, TypeId key_type)
+    -> KeyRange {
+  KeyRange range;
+  for (const auto &conjunct : conjuncts) {
+    const auto *comparison = dynamic_cast<const ComparisonExpression *>(conjunct.get());
+    if (comparison == nullptr) {
+      continue;
+    }
+    auto comp_type = comparison->comp_type_;
+    const auto *column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0).get());
+    const auto *constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(1).get());
+    if (column == nullptr || constant == nullptr) {
+      // the constant is on the left, look at it from the side of the column
+      column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1).get());
+      constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(0).get());
+      switch (comp_type) {
+        case ComparisonType::LessThan:
+          comp_type = ComparisonType::GreaterThan;
+          break;
+        case ComparisonType::LessThanOrEqual:
+          comp_type = ComparisonType::GreaterThanOrEqual;
+          break;
+        case ComparisonType::GreaterThan:
+          comp_type = ComparisonType::LessThan;
+          break;
+        case ComparisonType::GreaterThanOrEqual:
+          comp_type = ComparisonType::LessThanOrEqual;
+          break;
+        default:
+          break;
+      }
+    }
+    if (column == nullptr || constant == nullptr || column->GetTupleIdx() != 0 ||
+        column->GetColIdx() != key_col_idx) {
+      continue;
+    }
+    auto key = CastToKey(constant->val_, key_type);
+    if (!key.has_value()) {
+      continue;
+    }
+
+    // a strict comparison still scans its bound, the filter above the scan drops it
+    bool is_lower = comp_type == ComparisonType::Equal || comp_type == ComparisonType::GreaterThan ||
+                    comp_type == ComparisonType::GreaterThanOrEqual;
+    bool is_upper = comp_type == ComparisonType::Equal || comp_type == ComparisonType::LessThan ||
+                    comp_type == ComparisonType::LessThanOrEqual;
+    if (comp_type == ComparisonType::Equal && (range.lower_ == nullptr || range.upper_ == nullptr)) {
+      range.lower_ = std::make_shared<ConstantValueExpression>(*key);
+      range.upper_ = range.lower_;
+      range.selectivity_ = EQUALITY_SELECTIVITY;
+    } else if (is_lower && !is_upper && range.lower_ == nullptr) {
+      range.lower_ = std::make_shared<ConstantValueExpression>(*key);
+      range.selectivity_ *= RANGE_SELECTIVITY;
+    } else if (is_upper && !is_lower && range.upper_ == nullptr) {
+      range.upper_ = std::make_shared<ConstantValueExpression>(*key);
+      range.selectivity_ *= RANGE_SELECTIVITY;
+    }
+  }
+  return range;
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeFilterAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeFilterAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Filter) {
+    return optimized_plan;
+  }
+  const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*optimized_plan);
+  BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Filter with multiple children?? Impossible!");
+  const auto &child_plan = optimized_plan->children_[0];
+  if (child_plan->GetType() != PlanType::SeqScan) {
+    return optimized_plan;
+  }
+  const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child_plan);
+  if (seq_scan.filter_predicate_ != nullptr) {
+    return optimized_plan;
+  }
+
+  std::vector<AbstractExpressionRef> conjuncts;
+  CollectConjuncts(filter_plan.GetPredicate(), &conjuncts);
+  const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
+  const IndexInfo *best_index = nullptr;
+  KeyRange best_range;
+  for (const auto *index : catalog_.GetTableIndexes(table_info->name_)) {
+    const auto &key_attrs = index->index_->GetKeyAttrs();
+    bool is_point = IsPointIndex(index->index_type_);
+    if ((index->index_type_ != IndexType::BPlusTreeIndex && !is_point) || key_attrs.size() != 1) {
+      // only the B+ tree can scan a range, and the bounds are only known for the first key column
+      continue;
+    }
+    auto range = MatchKeyRange(conjuncts, key_attrs[0], table_info->schema_.GetColumn(key_attrs[0]).GetType());
+    if (is_point && (range.lower_ == nullptr || range.lower_ != range.upper_)) {
+      // a point index only finds equal keys
+      continue;
+    }
+    // of two equally selective ranges, the point index is the cheaper lookup
+    if ((range.lower_ != nullptr || range.upper_ != nullptr) &&
+        (range.selectivity_ < best_range.selectivity_ || (is_point && range.selectivity_ == best_range.selectivity_))) {
+      best_index = index;
+      best_range = std::move(range);
+    }
+  }
+  if (best_index == nullptr) {
+    return optimized_plan;
+  }
+
+  // the filter stays on top, the range may let through keys that it rejects
+  if (best_range.selectivity_ >= BITMAP_SCAN_SELECTIVITY) {
+    return optimized_plan->CloneWithChildren({std::make_shared<BitmapHeapScanPlanNode>(
+        seq_scan.output_schema_, seq_scan.GetTableOid(), seq_scan.table_name_, best_index->index_oid_,
+        std::move(best_range.lower_), std::move(best_range.upper_))});
+  }
+  return optimized_plan->CloneWithChildren(
+      {std::make_shared<IndexScanPlanNode>(seq_scan.output_schema_, best_index->index_oid_, false, false,
+                                           std::move(best_range.lower_), std::move(best_range.upper_))});
+}
+
+}  // namespace bustub
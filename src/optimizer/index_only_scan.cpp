@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** Collect the columns read by `expr`, return false if it reads something other than the columns of its child. */
+auto CollectColumns(const AbstractExpressionRef &expr, std::vector<uint32_t> *columns) -> bool {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      column_value_expr != nullptr) {
+    if (column_value_expr->GetTupleIdx() != 0) {
+      return false;
+    }
+    columns->push_back(column_value_expr->GetColIdx());
+    return true;
+  }
+  return std::all_of(expr->GetChildren().begin(), expr->GetChildren().end(),
+                     [&](const AbstractExpressionRef &child) { return CollectColumns(child, columns); });
+}
+
+/** @return true if every column is stored in the entries of the index */
+auto Covers(const IndexInfo &index_info, const std::vector<uint32_t> &columns) -> bool {
+  const auto &entry_attrs = index_info.index_->GetEntryAttrs();
+  return std::all_of(columns.begin(), columns.end(), [&](uint32_t column) {
+    return std::find(entry_attrs.begin(), entry_attrs.end(), column) != entry_attrs.end();
+  });
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeIndexOnlyScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeIndexOnlyScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Projection) {
+    return optimized_plan;
+  }
+  const auto &projection_plan = dynamic_cast<const ProjectionPlanNode &>(*optimized_plan);
+  BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Projection with multiple children?? Impossible!");
+  const auto &child_plan = optimized_plan->children_[0];
+
+  std::vector<uint32_t> columns;
+  for (const auto &expr : projection_plan.GetExpressions()) {
+    if (!CollectColumns(expr, &columns)) {
+      return optimized_plan;
+    }
+  }
+
+  if (child_plan->GetType() == PlanType::IndexScan) {
+    const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*child_plan);
+    const auto *index_info = catalog_.GetIndex(index_scan.GetIndexOid());
+    if (!index_scan.IsIndexOnly() && !index_scan.IsRangeScan() && Covers(*index_info, columns)) {
+      return optimized_plan->CloneWithChildren({std::make_shared<IndexScanPlanNode>(
+          child_plan->output_schema_, index_scan.GetIndexOid(), index_scan.IsReverse(), true)});
+    }
+  }
+
+  if (child_plan->GetType() == PlanType::SeqScan) {
+    const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child_plan);
+    if (seq_scan.filter_predicate_ != nullptr) {
+      return optimized_plan;
+    }
+    const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
+    for (const auto *index : catalog_.GetTableIndexes(table_info->name_)) {
+      // a full scan of the index only pays off over the heap when the index was built to carry extra columns
+      if (index->index_type_ == IndexType::BPlusTreeIndex && index->index_->GetMetadata()->HasIncludedColumns() &&
+          Covers(*index, columns)) {
+        return optimized_plan->CloneWithChildren(
+            {std::make_shared<IndexScanPlanNode>(child_plan->output_schema_, index->index_oid_, false, true)});
+      }
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
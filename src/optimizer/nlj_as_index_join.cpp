@@ -24,12 +24,19 @@ namespace bustub {
 auto Optimizer::MatchIndex(const std::string &table_name, uint32_t index_key_idx)
     -> std::optional<std::tuple<index_oid_t, std::string>> {
   const auto key_attrs = std::vector{index_key_idx};
+  const IndexInfo *match = nullptr;
   for (const auto *index_info : catalog_.GetTableIndexes(table_name)) {
     if (key_attrs == index_info->index_->GetKeyAttrs()) {
-      return std::make_optional(std::make_tuple(index_info->index_oid_, index_info->name_));
+      // the join only looks keys up, which a point index answers with less work
+      if (match == nullptr || IsPointIndex(index_info->index_type_)) {
+        match = index_info;
+      }
     }
   }
-  return std::nullopt;
+  if (match == nullptr) {
+    return std::nullopt;
+  }
+  return std::make_optional(std::make_tuple(match->index_oid_, match->name_));
 }
 
 auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
@@ -11,7 +11,10 @@ auto Optimizer::Optimize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef
     auto p = plan;
     p = OptimizeMergeProjection(p);
     p = OptimizeMergeFilterNLJ(p);
+    p = OptimizeNLJAsIndexJoin(p);
+    p = OptimizeFilterAsIndexScan(p);
     p = OptimizeOrderByAsIndexScan(p);
+    p = OptimizeIndexOnlyScan(p);
     p = OptimizeSortLimitAsTopN(p);
     return p;
   }
@@ -12,8 +12,11 @@ auto Optimizer::OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanN
   p = OptimizeMergeProjection(p);
   p = OptimizeMergeFilterNLJ(p);
   p = OptimizeNLJAsHashJoin(p);
+  p = OptimizeFilterAsIndexScan(p);
   p = OptimizeOrderByAsIndexScan(p);
+  p = OptimizeIndexOnlyScan(p);
   p = OptimizeSortLimitAsTopN(p);
+  p = OptimizeMergeFilterScan(p);
   return p;
 }
 
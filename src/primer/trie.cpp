@@ -1,33 +1,221 @@
 #include "primer/trie.h"
+#include <algorithm>
 #include <string_view>
 #include "common/exception.h"
 
 namespace bustub {
 
+namespace {
+
+// Owns one reference to a node, if any.
+class NodeRef {
+ public:
+  NodeRef() = default;
+  explicit NodeRef(const TrieNode *node) : node_(node) {}
+  NodeRef(const NodeRef &) = delete;
+  NodeRef(NodeRef &&that) noexcept : node_(std::exchange(that.node_, nullptr)) {}
+  auto operator=(const NodeRef &) -> NodeRef & = delete;
+  auto operator=(NodeRef &&that) noexcept -> NodeRef & {
+    std::swap(node_, that.node_);
+    return *this;
+  }
+  ~NodeRef() {
+    if (node_ != nullptr) {
+      TrieNode::Release(node_);
+    }
+  }
+
+  auto Get() const -> const TrieNode * { return node_; }
+  auto Take() -> const TrieNode * { return std::exchange(node_, nullptr); }
+
+ private:
+  const TrieNode *node_{nullptr};
+};
+
+auto FindSlot(std::vector<TrieNode::Child> *children, char c) -> std::vector<TrieNode::Child>::iterator {
+  return std::lower_bound(children->begin(), children->end(), c,
+                          [](const TrieNode::Child &child, char c) { return TrieNode::ChildLess(child.first, c); });
+}
+
+// Build a node, unless it would have no value and at most one child: then the node is left out, and its only child,
+// if any, takes over its edge.
+auto MakeCompact(std::string_view edge, std::shared_ptr<const TrieValue> value,
+                 const std::vector<TrieNode::Child> &children) -> NodeRef {
+  if (value != nullptr || children.size() > 1) {
+    return NodeRef(TrieNode::Make(edge, std::move(value), children));
+  }
+  if (children.empty()) {
+    return NodeRef();
+  }
+  const auto *only = children[0].second;
+  std::string merged(edge);
+  merged += only->Edge();
+  return NodeRef(TrieNode::Make(merged, only->Value(), only->GetChildren()));
+}
+
+// Put the value at `key` below `node`, which may be nullptr, where `key` starts at the edge of the node.
+auto PutNode(const TrieNode *node, std::string_view key, const std::shared_ptr<const TrieValue> &value) -> NodeRef {
+  if (node == nullptr) {
+    return NodeRef(TrieNode::Make(key, value, {}));
+  }
+  auto edge = node->Edge();
+  size_t common = 0;
+  while (common < edge.size() && common < key.size() && edge[common] == key[common]) {
+    common++;
+  }
+
+  if (common < edge.size()) {
+    // The key leaves the edge or ends halfway along it: split the edge there.
+    NodeRef lower(TrieNode::Make(edge.substr(common), node->Value(), node->GetChildren()));
+    std::vector<TrieNode::Child> children{{edge[common], lower.Get()}};
+    if (common == key.size()) {
+      return NodeRef(TrieNode::Make(key, value, children));
+    }
+    NodeRef leaf(TrieNode::Make(key.substr(common), value, {}));
+    children.insert(FindSlot(&children, key[common]), {key[common], leaf.Get()});
+    return NodeRef(TrieNode::Make(key.substr(0, common), nullptr, children));
+  }
+
+  key.remove_prefix(edge.size());
+  auto children = node->GetChildren();
+  if (key.empty()) {
+    return NodeRef(TrieNode::Make(edge, value, children));
+  }
+  auto slot = FindSlot(&children, key[0]);
+  NodeRef child;
+  if (slot != children.end() && slot->first == key[0]) {
+    child = PutNode(slot->second, key, value);
+    slot->second = child.Get();
+  } else {
+    child = NodeRef(TrieNode::Make(key, value, {}));
+    children.insert(slot, {key[0], child.Get()});
+  }
+  return NodeRef(TrieNode::Make(edge, node->Value(), children));
+}
+
+// Remove `key`, which starts at the edge of `node`, from below the node.
+// Returns false if the key is not there, otherwise sets `result` to the new node, or nullptr if nothing is left.
+auto RemoveNode(const TrieNode *node, std::string_view key, NodeRef *result) -> bool {
+  auto edge = node->Edge();
+  if (key.substr(0, edge.size()) != edge) {
+    return false;
+  }
+  key.remove_prefix(edge.size());
+  auto value = node->Value();
+  auto children = node->GetChildren();
+  NodeRef child;
+  if (key.empty()) {
+    if (value == nullptr) {
+      return false;
+    }
+    value = nullptr;
+  } else {
+    auto slot = FindSlot(&children, key[0]);
+    if (slot == children.end() || slot->first != key[0] || !RemoveNode(slot->second, key, &child)) {
+      return false;
+    }
+    if (child.Get() == nullptr) {
+      children.erase(slot);
+    } else {
+      slot->second = child.Get();
+    }
+  }
+  *result = MakeCompact(edge, std::move(value), children);
+  return true;
+}
+
+}  // namespace
+
+auto TrieNode::AllocationSize(uint32_t edge_len, uint32_t num_children) -> size_t {
+  return sizeof(TrieNode) + num_children * (sizeof(const TrieNode *) + sizeof(char)) + edge_len;
+}
+
+auto TrieNode::Make(std::string_view edge, std::shared_ptr<const TrieValue> value, const std::vector<Child> &children)
+    -> const TrieNode * {
+  auto num_children = static_cast<uint32_t>(children.size());
+  auto edge_len = static_cast<uint32_t>(edge.size());
+  void *memory = ::operator new(AllocationSize(edge_len, num_children));
+  auto *node = new (memory) TrieNode(std::move(value), edge_len, num_children);
+  for (uint32_t i = 0; i < num_children; i++) {
+    children[i].second->AddRef();
+    node->ChildData()[i] = children[i].second;
+    node->KeyData()[i] = children[i].first;
+  }
+  std::copy(edge.begin(), edge.end(), node->EdgeData());
+  return node;
+}
+
+void TrieNode::Release(const TrieNode *node) {
+  if (node->refs_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  for (uint32_t i = 0; i < node->num_children_; i++) {
+    Release(node->ChildData()[i]);
+  }
+  node->~TrieNode();
+  ::operator delete(const_cast<TrieNode *>(node));
+}
+
+auto TrieNode::FindChild(char c) const -> const TrieNode * {
+  const char *keys = KeyData();
+  const char *found = std::lower_bound(keys, keys + num_children_, c, ChildLess);
+  if (found == keys + num_children_ || *found != c) {
+    return nullptr;
+  }
+  return ChildData()[found - keys];
+}
+
+auto TrieNode::GetChildren() const -> std::vector<Child> {
+  std::vector<Child> children;
+  children.reserve(num_children_ + 1);
+  for (uint32_t i = 0; i < num_children_; i++) {
+    children.emplace_back(KeyData()[i], ChildData()[i]);
+  }
+  return children;
+}
+
+auto TrieNode::MemoryUsage() const -> size_t {
+  size_t bytes = AllocationSize(edge_len_, num_children_);
+  for (uint32_t i = 0; i < num_children_; i++) {
+    bytes += ChildData()[i]->MemoryUsage();
+  }
+  return bytes;
+}
+
 template <class T>
 auto Trie::Get(std::string_view key) const -> const T * {
-  throw NotImplementedException("Trie::Get is not implemented.");
-
-  // You should walk through the trie to find the node corresponding to the key. If the node doesn't exist, return
-  // nullptr. After you find the node, you should use `dynamic_cast` to cast it to `const TrieNodeWithValue<T> *`. If
-  // dynamic_cast returns `nullptr`, it means the type of the value is mismatched, and you should return nullptr.
-  // Otherwise, return the value.
+  const TrieNode *node = root_;
+  while (node != nullptr) {
+    auto edge = node->Edge();
+    if (key.substr(0, edge.size()) != edge) {
+      return nullptr;
+    }
+    key.remove_prefix(edge.size());
+    if (key.empty()) {
+      const auto *value = dynamic_cast<const TrieValueOf<T> *>(node->Value().get());
+      return value == nullptr ? nullptr : &value->value_;
+    }
+    node = node->FindChild(key[0]);
+  }
+  return nullptr;
 }
 
 template <class T>
 auto Trie::Put(std::string_view key, T value) const -> Trie {
   // Note that `T` might be a non-copyable type. Always use `std::move` when creating `shared_ptr` on that value.
-  throw NotImplementedException("Trie::Put is not implemented.");
+  return PutValue(key, std::make_shared<const TrieValueOf<T>>(std::move(value)));
+}
 
-  // You should walk through the trie and create new nodes if necessary. If the node corresponding to the key already
-  // exists, you should create a new `TrieNodeWithValue`.
+auto Trie::PutValue(std::string_view key, std::shared_ptr<const TrieValue> value) const -> Trie {
+  return Trie(PutNode(root_, key, value).Take());
 }
 
 auto Trie::Remove(std::string_view key) const -> Trie {
-  throw NotImplementedException("Trie::Remove is not implemented.");
-
-  // You should walk through the trie and remove nodes if necessary. If the node doesn't contain a value any more,
-  // you should convert it to `TrieNode`. If a node doesn't have children any more, you should remove it.
+  NodeRef root;
+  if (root_ == nullptr || !RemoveNode(root_, key, &root)) {
+    return *this;
+  }
+  return Trie(root.Take());
 }
 
 // Below are explicit instantiation of template functions.
@@ -1,30 +1,49 @@
 #include "primer/trie_store.h"
+#include <mutex>  // NOLINT
 #include "common/exception.h"
 
 namespace bustub {
 
 template <class T>
 auto TrieStore::Get(std::string_view key) -> std::optional<ValueGuard<T>> {
-  // Pseudo-code:
-  // (1) Take the root lock, get the root, and release the root lock. Don't lookup the value in the
-  //     trie while holding the root lock.
-  // (2) Lookup the value in the trie.
-  // (3) If the value is found, return a ValueGuard object that holds a reference to the value and the
-  //     root. Otherwise, return std::nullopt.
-  throw NotImplementedException("TrieStore::Get is not implemented.");
+  // Take a snapshot of the root, and look the key up without holding the root lock. The snapshot keeps the nodes and
+  // the value alive for as long as the guard lives.
+  Trie root;
+  {
+    std::lock_guard<std::mutex> lock(root_lock_);
+    root = root_;
+  }
+  const T *value = root.Get<T>(key);
+  if (value == nullptr) {
+    return std::nullopt;
+  }
+  return ValueGuard<T>(std::move(root), *value);
 }
 
 template <class T>
 void TrieStore::Put(std::string_view key, T value) {
-  // You will need to ensure there is only one writer at a time. Think of how you can achieve this.
-  // The logic should be somehow similar to `TrieStore::Get`.
-  throw NotImplementedException("TrieStore::Put is not implemented.");
+  // Writers are sequenced by the write lock, and build the new version off the root lock so that readers go on.
+  std::lock_guard<std::mutex> write_lock(write_lock_);
+  Trie root;
+  {
+    std::lock_guard<std::mutex> lock(root_lock_);
+    root = root_;
+  }
+  Trie new_root = root.Put<T>(key, std::move(value));
+  std::lock_guard<std::mutex> lock(root_lock_);
+  root_ = std::move(new_root);
 }
 
 void TrieStore::Remove(std::string_view key) {
-  // You will need to ensure there is only one writer at a time. Think of how you can achieve this.
-  // The logic should be somehow similar to `TrieStore::Get`.
-  throw NotImplementedException("TrieStore::Remove is not implemented.");
+  std::lock_guard<std::mutex> write_lock(write_lock_);
+  Trie root;
+  {
+    std::lock_guard<std::mutex> lock(root_lock_);
+    root = root_;
+  }
+  Trie new_root = root.Remove(key);
+  std::lock_guard<std::mutex> lock(root_lock_);
+  root_ = std::move(new_root);
 }
 
 // Below are explicit instantiation of template functions.
@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_file_manager.cpp
+//
+// Identification: src/storage/disk/tmp_file_manager.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/disk/tmp_file_manager.h"
+
+#include <unistd.h>
+#include <atomic>
+#include <filesystem>
+
+#include "fmt/format.h"
+
+namespace bustub {
+
+namespace {
+
+/** Tells apart the files of the managers of one process */
+std::atomic<uint64_t> next_file_id{0};
+
+}  // namespace
+
+TmpFileManager::TmpFileManager()
+    : file_name_((std::filesystem::temp_directory_path() /
+                  fmt::format("bustub-tmp-{}-{}.db", getpid(), next_file_id.fetch_add(1)))
+                     .string()),
+      disk_manager_(std::make_unique<DiskManager>(file_name_)) {}
+
+TmpFileManager::~TmpFileManager() {
+  disk_manager_->ShutDown();
+  // the disk manager opens a log file next to the file as well
+  std::error_code ec;
+  std::filesystem::remove(file_name_, ec);
+  std::filesystem::remove(std::filesystem::path(file_name_).replace_extension(".log"), ec);
+}
+
+auto TmpFileManager::AllocatePage() -> page_id_t {
+  if (!free_pages_.empty()) {
+    page_id_t page_id = free_pages_.back();
+    free_pages_.pop_back();
+    return page_id;
+  }
+  return next_page_id_++;
+}
+
+void TmpFileManager::DeallocatePage(page_id_t page_id) { free_pages_.push_back(page_id); }
+
+}  // namespace bustub
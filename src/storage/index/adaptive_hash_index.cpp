@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// adaptive_hash_index.cpp
+//
+// Identification: src/storage/index/adaptive_hash_index.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/adaptive_hash_index.h"
+#include "storage/index/generic_key.h"
+
+namespace bustub {
+
+template <typename KeyType>
+void AdaptiveHashIndex<KeyType>::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+  if (!enabled) {
+    for (auto &shard : shards_) {
+      std::unique_lock lock(shard.latch_);
+      shard.entries_.clear();
+      shard.probe_counts_.clear();
+    }
+  }
+}
+
+template <typename KeyType>
+auto AdaptiveHashIndex<KeyType>::Lookup(const KeyType &key) -> std::optional<Entry> {
+  if (!IsEnabled()) {
+    return std::nullopt;
+  }
+  auto &shard = ShardOf(key);
+  std::shared_lock lock(shard.latch_);
+  auto it = shard.entries_.find(key);
+  if (it == shard.entries_.end()) {
+    return std::nullopt;
+  }
+  shard.lookups_.fetch_add(1, std::memory_order_relaxed);
+  return it->second;
+}
+
+template <typename KeyType>
+void AdaptiveHashIndex<KeyType>::RecordHit(const KeyType &key) {
+  ShardOf(key).hits_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename KeyType>
+void AdaptiveHashIndex<KeyType>::Invalidate(const KeyType &key, const Entry &entry) {
+  auto &shard = ShardOf(key);
+  shard.stale_.fetch_add(1, std::memory_order_relaxed);
+  std::unique_lock lock(shard.latch_);
+  auto it = shard.entries_.find(key);
+  // another lookup may have rebuilt the entry in the meantime
+  if (it != shard.entries_.end() && it->second.leaf_page_id_ == entry.leaf_page_id_ &&
+      it->second.version_ == entry.version_) {
+    shard.entries_.erase(it);
+  }
+}
+
+template <typename KeyType>
+void AdaptiveHashIndex<KeyType>::RecordProbe(const KeyType &key, page_id_t leaf_page_id, int slot,
+                                             uint64_t version) {
+  if (!IsEnabled()) {
+    return;
+  }
+  auto &shard = ShardOf(key);
+  std::unique_lock lock(shard.latch_);
+  if (shard.probe_counts_.size() >= shard_capacity_) {
+    shard.probe_counts_.clear();
+  }
+  auto count = ++shard.probe_counts_[key];
+  if (count < build_threshold_) {
+    return;
+  }
+  shard.probe_counts_.erase(key);
+  if (shard.entries_.size() >= shard_capacity_) {
+    // no recency is kept for the entries, make room by dropping any of them
+    shard.entries_.erase(shard.entries_.begin());
+  }
+  shard.entries_[key] = Entry{leaf_page_id, slot, version};
+  shard.builds_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename KeyType>
+auto AdaptiveHashIndex<KeyType>::GetStats() const -> AdaptiveHashIndexStats {
+  AdaptiveHashIndexStats stats;
+  for (const auto &shard : shards_) {
+    stats.lookups_ += shard.lookups_.load(std::memory_order_relaxed);
+    stats.hits_ += shard.hits_.load(std::memory_order_relaxed);
+    stats.stale_ += shard.stale_.load(std::memory_order_relaxed);
+    stats.builds_ += shard.builds_.load(std::memory_order_relaxed);
+    std::shared_lock lock(shard.latch_);
+    stats.entries_ += shard.entries_.size();
+  }
+  return stats;
+}
+
+template class AdaptiveHashIndex<GenericKey<4>>;
+template class AdaptiveHashIndex<GenericKey<8>>;
+template class AdaptiveHashIndex<GenericKey<16>>;
+template class AdaptiveHashIndex<GenericKey<32>>;
+template class AdaptiveHashIndex<GenericKey<64>>;
+
+}  // namespace bustub
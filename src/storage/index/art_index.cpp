@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// art_index.cpp
+//
+// Identification: src/storage/index/art_index.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/art_index.h"
+#include "storage/index/generic_key.h"
+
+namespace bustub {
+
+namespace {
+
+template <typename KeyType>
+auto KeyBytes(const KeyType &key) -> std::string_view {
+  return {key.data_, sizeof(key.data_)};
+}
+
+}  // namespace
+
+/*
+ * Constructor
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+ART_INDEX_TYPE::ArtIndex(std::unique_ptr<IndexMetadata> &&metadata)
+    : Index(std::move(metadata)), comparator_(GetMetadata()->GetKeySchema()) {}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto ART_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool {
+  // construct insert index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  return container_.Insert(KeyBytes(index_key), rid);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void ART_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  // construct delete index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  container_.Remove(KeyBytes(index_key));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void ART_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  // construct scan index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  if (auto rid = container_.Get(KeyBytes(index_key)); rid.has_value()) {
+    result->push_back(*rid);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void ART_INDEX_TYPE::ScanRange(const Tuple *lower, const Tuple *upper, std::vector<RID> *result,
+                               Transaction *transaction) {
+  if (lower != nullptr && upper != nullptr) {
+    KeyType lower_key;
+    lower_key.SetFromKey(*lower, *GetKeySchema());
+    KeyType upper_key;
+    upper_key.SetFromKey(*upper, *GetKeySchema());
+    if (comparator_(lower_key, upper_key) == 0) {
+      if (auto rid = container_.Get(KeyBytes(lower_key)); rid.has_value()) {
+        result->push_back(*rid);
+      }
+      return;
+    }
+  }
+  throw NotImplementedException(fmt::format("ART index {} can only scan a single key", GetName()));
+}
+
+template class ArtIndex<GenericKey<4>, RID, GenericComparator<4>>;
+template class ArtIndex<GenericKey<8>, RID, GenericComparator<8>>;
+template class ArtIndex<GenericKey<16>, RID, GenericComparator<16>>;
+template class ArtIndex<GenericKey<32>, RID, GenericComparator<32>>;
+template class ArtIndex<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -0,0 +1,284 @@
+#include <string>
+#include <thread>  // NOLINT
+
+#include "common/rid.h"
+#include "storage/index/b_link_tree.h"
+
+namespace bustub {
+
+INDEX_TEMPLATE_ARGUMENTS
+BLINKTREE_TYPE::BLinkTree(std::string name, page_id_t header_page_id, BufferPoolManager *buffer_pool_manager,
+                          const KeyComparator &comparator, int leaf_max_size, int internal_max_size)
+    : index_name_(std::move(name)),
+      bpm_(buffer_pool_manager),
+      comparator_(comparator),
+      leaf_max_size_(leaf_max_size),
+      internal_max_size_(internal_max_size),
+      header_page_id_(header_page_id) {
+  WritePageGuard guard = bpm_->FetchPageWrite(header_page_id_);
+  auto root_page = guard.AsMut<BPlusTreeHeaderPage>();
+  root_page->root_page_id_ = INVALID_PAGE_ID;
+}
+
+/*
+ * Helper function to decide whether current b-link tree is empty
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BLINKTREE_TYPE::IsEmpty() const -> bool {
+  ReadPageGuard guard = bpm_->FetchPageRead(header_page_id_);
+  auto head_page = guard.As<BPlusTreeHeaderPage>();
+  return head_page->root_page_id_ == INVALID_PAGE_ID;
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+/*
+ * Return the only value that associated with input key
+ * This method is used for point query
+ * @return : true means key exists
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BLINKTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn) -> bool {
+  page_id_t leaf_page_id = FindLeaf(key, nullptr);
+  if (leaf_page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  ReadPageGuard guard = bpm_->FetchPageRead(leaf_page_id);
+  auto leaf = guard.As<LeafPage>();
+  while (leaf->ShouldMoveRight(key, comparator_)) {
+    // the leaf split after we left its parent, the key is further to the right
+    page_id_t right_page_id = leaf->GetRightPageId();
+    guard.Drop();
+    guard = bpm_->FetchPageRead(right_page_id);
+    leaf = guard.As<LeafPage>();
+  }
+  int index = leaf->LowerBound(key, comparator_);
+  if (index == leaf->GetSize() || comparator_(leaf->KeyAt(index), key) != 0) {
+    return false;
+  }
+  result->push_back(leaf->ValueAt(index));
+  return true;
+}
+
+/*
+ * Readers never hold two latches at once: the latch of a page is released before the next one is taken, so a
+ * writer that latches a parent while holding its child can never wait on a reader that goes the other way.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BLINKTREE_TYPE::FindLeaf(const KeyType &key, std::vector<page_id_t> *stack) -> page_id_t {
+  page_id_t page_id = GetRootPageId();
+  if (page_id == INVALID_PAGE_ID) {
+    return INVALID_PAGE_ID;
+  }
+  ReadPageGuard guard = bpm_->FetchPageRead(page_id);
+  while (true) {
+    auto node = guard.As<InternalPage>();
+    page_id_t next_page_id;
+    if (node->ShouldMoveRight(key, comparator_)) {
+      next_page_id = node->GetRightPageId();
+    } else if (node->IsLeafPage()) {
+      return page_id;
+    } else {
+      if (stack != nullptr) {
+        stack->push_back(page_id);
+      }
+      next_page_id = node->ValueAt(node->ChildIndex(key, comparator_));
+    }
+    guard.Drop();
+    page_id = next_page_id;
+    guard = bpm_->FetchPageRead(page_id);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BLINKTREE_TYPE::FindNodeOnLevel(const KeyType &key, int level) -> page_id_t {
+  while (true) {
+    page_id_t page_id = GetRootPageId();
+    ReadPageGuard guard = bpm_->FetchPageRead(page_id);
+    auto node = guard.As<InternalPage>();
+    if (node->GetLevel() < level) {
+      // the thread that split the old root has not installed the new one yet
+      guard.Drop();
+      std::this_thread::yield();
+      continue;
+    }
+    while (true) {
+      page_id_t next_page_id;
+      if (node->ShouldMoveRight(key, comparator_)) {
+        next_page_id = node->GetRightPageId();
+      } else if (node->GetLevel() == level) {
+        return page_id;
+      } else {
+        next_page_id = node->ValueAt(node->ChildIndex(key, comparator_));
+      }
+      guard.Drop();
+      page_id = next_page_id;
+      guard = bpm_->FetchPageRead(page_id);
+      node = guard.As<InternalPage>();
+    }
+  }
+}
+
+/*
+ * Latches are taken left to right on one level and bottom up across levels, the new latch is acquired before the
+ * old one is released.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BLINKTREE_TYPE::MoveRight(const KeyType &key, WritePageGuard &guard) {
+  while (guard.As<InternalPage>()->ShouldMoveRight(key, comparator_)) {
+    WritePageGuard right_guard = bpm_->FetchPageWrite(guard.As<InternalPage>()->GetRightPageId());
+    guard = std::move(right_guard);
+  }
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+/*
+ * Insert constant key & value pair into b-link tree
+ * @return: since we only support unique key, if user try to insert duplicate
+ * keys return false, otherwise return true.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BLINKTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *txn) -> bool {
+  std::vector<page_id_t> stack;
+  page_id_t leaf_page_id = FindLeaf(key, &stack);
+  while (leaf_page_id == INVALID_PAGE_ID) {
+    WritePageGuard header_guard = bpm_->FetchPageWrite(header_page_id_);
+    auto header = header_guard.AsMut<BPlusTreeHeaderPage>();
+    if (header->root_page_id_ == INVALID_PAGE_ID) {
+      page_id_t page_id;
+      BasicPageGuard guard = bpm_->NewPageGuarded(&page_id);
+      auto root_page = guard.AsMut<LeafPage>();
+      root_page->Init(leaf_max_size_);
+      root_page->InsertAt(0, key, value);
+      header->root_page_id_ = page_id;
+      return true;
+    }
+    // someone else created the root in the meantime
+    header_guard.Drop();
+    leaf_page_id = FindLeaf(key, &stack);
+  }
+
+  WritePageGuard guard = bpm_->FetchPageWrite(leaf_page_id);
+  MoveRight(key, guard);
+  auto leaf = guard.AsMut<LeafPage>();
+  int index = leaf->LowerBound(key, comparator_);
+  if (index < leaf->GetSize() && comparator_(leaf->KeyAt(index), key) == 0) {
+    return false;
+  }
+  leaf->InsertAt(index, key, value);
+  if (leaf->GetSize() < leaf->GetMaxSize()) {
+    return true;
+  }
+  KeyType separator;
+  page_id_t right_page_id = Split<LeafPage>(guard, leaf_max_size_, &separator);
+  InsertIntoParent(std::move(guard), separator, right_page_id, &stack);
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+template <typename PageType>
+auto BLINKTREE_TYPE::Split(WritePageGuard &guard, int max_size, KeyType *separator) -> page_id_t {
+  auto node = guard.AsMut<PageType>();
+  page_id_t new_page_id;
+  BasicPageGuard new_guard = bpm_->NewPageGuarded(&new_page_id);
+  auto new_node = new_guard.AsMut<PageType>();
+  new_node->Init(max_size, node->GetLevel());
+  node->MoveHalfTo(new_node);
+  new_node->SetRightPageId(node->GetRightPageId());
+  if (node->HasHighKey()) {
+    new_node->SetHighKey(node->GetHighKey());
+  }
+  // for an internal node the first key of the new sibling is not a real key any more, it stays as its low bound
+  *separator = new_node->KeyAt(0);
+  node->SetRightPageId(new_page_id);
+  node->SetHighKey(*separator);
+  return new_page_id;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BLINKTREE_TYPE::InsertIntoParent(WritePageGuard guard, KeyType separator, page_id_t right_page_id,
+                                      std::vector<page_id_t> *stack) {
+  while (true) {
+    // leaves and internal nodes share the header layout, so the level can be read through either type
+    int level = guard.As<InternalPage>()->GetLevel();
+    page_id_t parent_page_id;
+    if (stack->empty()) {
+      WritePageGuard header_guard = bpm_->FetchPageWrite(header_page_id_);
+      auto header = header_guard.AsMut<BPlusTreeHeaderPage>();
+      if (header->root_page_id_ == guard.PageId()) {
+        page_id_t root_page_id;
+        BasicPageGuard root_guard = bpm_->NewPageGuarded(&root_page_id);
+        auto root = root_guard.AsMut<InternalPage>();
+        root->Init(internal_max_size_, level + 1);
+        root->InsertAt(0, separator, guard.PageId());
+        root->InsertAt(1, separator, right_page_id);
+        header->root_page_id_ = root_page_id;
+        return;
+      }
+      // the tree grew since we descended, look up the parent level from the new root
+      header_guard.Drop();
+      parent_page_id = FindNodeOnLevel(separator, level + 1);
+    } else {
+      parent_page_id = stack->back();
+      stack->pop_back();
+    }
+
+    WritePageGuard parent_guard = bpm_->FetchPageWrite(parent_page_id);
+    MoveRight(separator, parent_guard);
+    guard.Drop();
+    auto parent = parent_guard.AsMut<InternalPage>();
+    parent->InsertAt(parent->ChildIndex(separator, comparator_) + 1, separator, right_page_id);
+    if (parent->GetSize() < parent->GetMaxSize()) {
+      return;
+    }
+    right_page_id = Split<InternalPage>(parent_guard, internal_max_size_, &separator);
+    guard = std::move(parent_guard);
+  }
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+/*
+ * Delete key & value pair associated with input key. Only the leaf is touched: nodes are never merged, so right
+ * links and high keys stay valid for concurrent readers without any extra protocol.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BLINKTREE_TYPE::Remove(const KeyType &key, Transaction *txn) {
+  page_id_t leaf_page_id = FindLeaf(key, nullptr);
+  if (leaf_page_id == INVALID_PAGE_ID) {
+    return;
+  }
+  WritePageGuard guard = bpm_->FetchPageWrite(leaf_page_id);
+  MoveRight(key, guard);
+  auto leaf = guard.AsMut<LeafPage>();
+  int index = leaf->LowerBound(key, comparator_);
+  if (index < leaf->GetSize() && comparator_(leaf->KeyAt(index), key) == 0) {
+    leaf->RemoveAt(index);
+  }
+}
+
+/**
+ * @return Page id of the root of this tree
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BLINKTREE_TYPE::GetRootPageId() -> page_id_t {
+  ReadPageGuard guard = bpm_->FetchPageRead(header_page_id_);
+  auto root_page = guard.As<BPlusTreeHeaderPage>();
+  return root_page->root_page_id_;
+}
+
+template class BLinkTree<GenericKey<4>, RID, GenericComparator<4>>;
+
+template class BLinkTree<GenericKey<8>, RID, GenericComparator<8>>;
+
+template class BLinkTree<GenericKey<16>, RID, GenericComparator<16>>;
+
+template class BLinkTree<GenericKey<32>, RID, GenericComparator<32>>;
+
+template class BLinkTree<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_link_tree_index.cpp
+//
+// Identification: src/storage/index/b_link_tree_index.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/b_link_tree_index.h"
+
+namespace bustub {
+/*
+ * Constructor
+ */
+INDEX_TEMPLATE_ARGUMENTS
+BLINKTREE_INDEX_TYPE::BLinkTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager)
+    : Index(std::move(metadata)), comparator_(GetMetadata()->GetKeySchema()) {
+  page_id_t header_page_id;
+  buffer_pool_manager->NewPage(&header_page_id);
+  container_ = std::make_shared<BLinkTree<KeyType, ValueType, KeyComparator>>(GetMetadata()->GetName(), header_page_id,
+                                                                              buffer_pool_manager, comparator_);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BLINKTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool {
+  // construct insert index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  return container_->Insert(index_key, rid, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BLINKTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  // construct delete index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  container_->Remove(index_key, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BLINKTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  // construct scan index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  container_->GetValue(index_key, result, transaction);
+}
+
+template class BLinkTreeIndex<GenericKey<4>, RID, GenericComparator<4>>;
+template class BLinkTreeIndex<GenericKey<8>, RID, GenericComparator<8>>;
+template class BLinkTreeIndex<GenericKey<16>, RID, GenericComparator<16>>;
+template class BLinkTreeIndex<GenericKey<32>, RID, GenericComparator<32>>;
+template class BLinkTreeIndex<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
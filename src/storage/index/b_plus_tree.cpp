@@ -22,15 +22,14 @@ BPLUSTREE_TYPE::BPlusTree(std::string name, page_id_t header_page_id, BufferPool
   root_page->root_page_id_ = INVALID_PAGE_ID;
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TYPE::~BPlusTree() { StopBackgroundCompaction(); }
+
 /*
  * Helper function to decide whether current b+tree is empty
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::IsEmpty() const -> bool {
-  ReadPageGuard guard = bpm_->FetchPageRead(header_page_id_);
-  auto head_page = guard.As<BPlusTreeHeaderPage>();
-  return head_page->root_page_id_ == INVALID_PAGE_ID;
-}
+auto BPLUSTREE_TYPE::IsEmpty() const -> bool { return root_page_id_.load() == INVALID_PAGE_ID; }
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
@@ -41,32 +40,137 @@ auto BPLUSTREE_TYPE::IsEmpty() const -> bool {
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn) -> bool {
-  // Declaration of context instance.
-  if (IsEmpty()) {
+  if (auto found = GetValueFromHashIndex(key, result); found.has_value()) {
+    return *found;
+  }
+  auto leaf_guard = FindLeafRead(&key);
+  if (!leaf_guard.has_value()) {
+    return false;
+  }
+  ReadPageGuard guard = std::move(*leaf_guard);
+  auto leaf = guard.As<LeafPage>();
+  int slot = leaf->LowerBound(key, comparator_);
+  if (slot >= leaf->GetSize() || comparator_(leaf->KeyAt(slot), key) != 0) {
     return false;
   }
+  result->push_back(leaf->ValueAt(slot));
+  page_id_t leaf_page_id = guard.PageId();
+  uint64_t version = guard.GetVersion();
+  // counted once the leaf is released, its version read under the latch tells whether it was written since
+  guard.Drop();
+  adaptive_hash_index_.RecordProbe(key, leaf_page_id, slot, version);
+  return true;
+}
+
+/*
+ * The entry is only used if the leaf, once read-latched, is still at the version the entry recorded.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::GetValueFromHashIndex(const KeyType &key, std::vector<ValueType> *result)
+    -> std::optional<bool> {
+  auto entry = adaptive_hash_index_.Lookup(key);
+  if (!entry.has_value()) {
+    return std::nullopt;
+  }
+  ReadPageGuard guard = bpm_->FetchPageRead(entry->leaf_page_id_);
+  if (guard.GetVersion() != entry->version_) {
+    adaptive_hash_index_.Invalidate(key, *entry);
+    return std::nullopt;
+  }
+  adaptive_hash_index_.RecordHit(key);
+  auto leaf = guard.As<LeafPage>();
+  int slot = entry->slot_;
+  if (slot >= leaf->GetSize() || comparator_(leaf->KeyAt(slot), key) != 0) {
+    // the key moved inside the leaf, or was deleted from it
+    slot = leaf->LowerBound(key, comparator_);
+  }
+  if (slot < leaf->GetSize() && comparator_(leaf->KeyAt(slot), key) == 0) {
+    result->push_back(leaf->ValueAt(slot));
+    return true;
+  }
+  return false;
+}
+
+/*
+ * Look up a batch of keys sorted in ascending order, result[i] receives the
+ * values of keys[i]. Instead of descending from the root for every key, the
+ * read-latched path to the current leaf is kept together with the separator
+ * bounding each page on the right; the next key only climbs back up as far
+ * as the first page whose range still covers it.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::GetValues(const std::vector<KeyType> &keys, std::vector<std::vector<ValueType>> *result,
+                               Transaction *txn) {
+  result->assign(keys.size(), std::vector<ValueType>{});
+  if (keys.empty()) {
+    return;
+  }
   Context ctx;
-  ReadPageGuard head_guard = bpm_->FetchPageRead(header_page_id_);
-  auto head = head_guard.As<BPlusTreeHeaderPage>();
-  page_id_t root_page_id = head->root_page_id_;
-  auto guard = bpm_->FetchPageRead(root_page_id);
-  auto cur = guard.As<BPlusTreePage>();
-  while (!cur->IsLeafPage()) {
-    ctx.read_set_.push_back(std::move(guard));
-    auto internal = reinterpret_cast<const InternalPage *>(cur);
-    page_id_t page_id = internal->FindValue(key, comparator_);
-    guard = bpm_->FetchPageRead(page_id);
-    cur = guard.As<BPlusTreePage>();
+  auto root_guard = FetchRootRead();
+  if (!root_guard.has_value()) {
+    return;
+  }
+  ctx.read_set_.push_back(std::move(*root_guard));
+  // upper_bounds[i] is the exclusive upper bound of the keys reachable through read_set_[i]
+  std::vector<std::optional<KeyType>> upper_bounds{std::nullopt};
+  if (!ctx.read_set_.back().As<BPlusTreePage>()->IsLeafPage()) {
+    PrefetchChildren(ctx.read_set_.back().As<InternalPage>(), keys, 0, std::nullopt);
+  }
+  for (size_t i = 0; i < keys.size(); i++) {
+    const KeyType &key = keys[i];
+    while (ctx.read_set_.size() > 1 && upper_bounds.back().has_value() &&
+           comparator_(key, *upper_bounds.back()) >= 0) {
+      ctx.read_set_.pop_back();
+      upper_bounds.pop_back();
+    }
+    while (!ctx.read_set_.back().As<BPlusTreePage>()->IsLeafPage()) {
+      auto internal = ctx.read_set_.back().As<InternalPage>();
+      int index = internal->KeyIndex(key, comparator_);
+      std::optional<KeyType> upper_bound = upper_bounds.back();
+      if (index + 1 < internal->GetSize()) {
+        upper_bound = internal->KeyAt(index + 1);
+      }
+      ctx.read_set_.push_back(bpm_->FetchPageRead(internal->ValueAt(index)));
+      upper_bounds.push_back(upper_bound);
+      if (!ctx.read_set_.back().As<BPlusTreePage>()->IsLeafPage()) {
+        PrefetchChildren(ctx.read_set_.back().As<InternalPage>(), keys, i, upper_bound);
+      }
+    }
+    ctx.read_set_.back().As<LeafPage>()->FindValue(key, comparator_, &(*result)[i]);
   }
-  auto leaf = reinterpret_cast<const LeafPage *>(cur);
-  bool res = leaf->FindValue(key, comparator_, result);
-  head_guard.Drop();
   while (!ctx.read_set_.empty()) {
-    ctx.read_set_.front().Drop();
-    ctx.read_set_.pop_front();
+    ctx.read_set_.back().Drop();
+    ctx.read_set_.pop_back();
+  }
+}
+
+/*
+ * Every page prefetched here is fetched by the descents of the later keys,
+ * whose misses are then read in the background while the earlier keys are
+ * looked up. The keys are sorted, so their children are found in one walk
+ * over the page.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::PrefetchChildren(const InternalPage *internal, const std::vector<KeyType> &keys, size_t from,
+                                      const std::optional<KeyType> &upper_bound) {
+  std::vector<page_id_t> children;
+  int index = internal->KeyIndex(keys[from], comparator_);
+  page_id_t last_child = internal->ValueAt(index);
+  for (size_t i = from + 1; i < keys.size(); i++) {
+    if (upper_bound.has_value() && comparator_(keys[i], *upper_bound) >= 0) {
+      break;
+    }
+    while (index + 1 < internal->GetSize() && comparator_(internal->KeyAt(index + 1), keys[i]) <= 0) {
+      index++;
+    }
+    if (internal->ValueAt(index) != last_child) {
+      last_child = internal->ValueAt(index);
+      children.push_back(last_child);
+    }
+  }
+  if (!children.empty()) {
+    bpm_->PrefetchPages(children);
   }
-  guard.Drop();
-  return res;
 }
 
 /*****************************************************************************
@@ -82,55 +186,29 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *txn) -> bool {
   // Declaration of context instance.
-  WritePageGuard head_guard = bpm_->FetchPageWrite(header_page_id_);
-  auto head = head_guard.AsMut<BPlusTreeHeaderPage>();
-  if (head->root_page_id_ == INVALID_PAGE_ID) {
+  Context ctx;
+  auto leaf_guard = FindLeafWrite(key, ctx, true);
+  if (!leaf_guard.has_value()) {
+    // the tree is empty, and the header page is latched to give it a root
     page_id_t page_id;
     BasicPageGuard guard = bpm_->NewPageGuarded(&page_id);
     auto root_page = guard.AsMut<LeafPage>();
     root_page->Init(leaf_max_size_);
     root_page->Insert(key, value, comparator_);
-    head->root_page_id_ = page_id;
+    SetRootPageId(ctx, page_id);
     return true;
   }
-  Context ctx;
-  page_id_t root_page_id = head->root_page_id_;
-  ctx.header_page_ = std::move(head_guard);
-  ctx.root_page_id_ = root_page_id;
-  WritePageGuard write_guard = bpm_->FetchPageWrite(root_page_id);
-  auto cur = write_guard.AsMut<BPlusTreePage>();
-  page_id_t tmp_page_id = root_page_id;
-  while (!cur->IsLeafPage()) {
-    ctx.write_set_.push_back(std::move(write_guard));
-    auto internal = reinterpret_cast<const InternalPage *>(cur);
-    tmp_page_id = internal->FindValue(key, comparator_);
-    write_guard = bpm_->FetchPageWrite(tmp_page_id);
-    cur = write_guard.AsMut<BPlusTreePage>();
-  }
-  auto leaf = reinterpret_cast<LeafPage *>(cur);
+  WritePageGuard write_guard = std::move(*leaf_guard);
+  auto leaf = write_guard.AsMut<LeafPage>();
   if (!leaf->Insert(key, value, comparator_)) {
     return false;
   }
   if (leaf->GetSize() == leaf->GetMaxSize()) {
-    page_id_t page_id;
-    BasicPageGuard new_guard = bpm_->NewPageGuarded(&page_id);
-    auto new_page = new_guard.AsMut<LeafPage>();
-    new_page->Init(leaf_max_size_);
-    std::shared_ptr<MappingType[]> tmp(new MappingType[leaf->GetMaxSize()]);
-    leaf->CopyOut(tmp);
-    new_page->CopyIn(tmp);
-    page_id_t next_page_id = leaf->GetNextPageId();
-    /*if(next_page_id!=INVALID_PAGE_ID){
-        WritePageGuard next_guard = bpm_->FetchPageWrite(next_page_id);
-        auto right_tree_p = next_guard.AsMut<LeafPage>();
-        right_tree_p->SetPrePageId(page_id);
-    }*/
-    new_page->SetNextPageId(next_page_id);
-    // new_page->SetPrePageId(tmp_page_id);
-    leaf->SetNextPageId(page_id);
-    InsertParent(tmp[0].first, page_id, ctx, tmp_page_id);
+    SplitLeaf(ctx, write_guard);
+  }
+  if (ctx.header_page_.has_value()) {
+    ctx.header_page_->Drop();
   }
-  ctx.header_page_->Drop();
   while (!ctx.write_set_.empty()) {
     ctx.write_set_.front().Drop();
     ctx.write_set_.pop_front();
@@ -139,19 +217,106 @@ auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
   return true;
 }
 
+/*
+ * Insert a batch of key & value pairs sorted by key in ascending order.
+ * The header page write latch is taken once for the whole batch, and the
+ * root-to-leaf descent is shared by all consecutive keys that fall into the
+ * same leaf: the leaf stays latched until a key goes past the separator that
+ * bounds it on the right, or until it has to be split.
+ * @return: the number of pairs inserted, duplicated keys are skipped
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::InsertBatch(const std::vector<MappingType> &entries, Transaction *txn) -> size_t {
+  if (entries.empty()) {
+    return 0;
+  }
+  Context ctx;
+  ctx.header_page_ = bpm_->FetchPageWrite(header_page_id_);
+  size_t inserted = 0;
+  size_t i = 0;
+  while (i < entries.size()) {
+    auto head = ctx.header_page_->AsMut<BPlusTreeHeaderPage>();
+    if (head->root_page_id_ == INVALID_PAGE_ID) {
+      page_id_t page_id;
+      BasicPageGuard guard = bpm_->NewPageGuarded(&page_id);
+      auto root_page = guard.AsMut<LeafPage>();
+      root_page->Init(leaf_max_size_);
+      root_page->Insert(entries[i].first, entries[i].second, comparator_);
+      SetRootPageId(ctx, page_id);
+      inserted++;
+      i++;
+      continue;
+    }
+    ctx.root_page_id_ = head->root_page_id_;
+    WritePageGuard write_guard = bpm_->FetchPageWrite(ctx.root_page_id_);
+    // separator key bounding the current subtree on the right, none for the rightmost subtree
+    std::optional<KeyType> upper_bound = std::nullopt;
+    while (!write_guard.As<BPlusTreePage>()->IsLeafPage()) {
+      auto internal = write_guard.As<InternalPage>();
+      int index = internal->KeyIndex(entries[i].first, comparator_);
+      if (index + 1 < internal->GetSize()) {
+        upper_bound = internal->KeyAt(index + 1);
+      }
+      page_id_t page_id = internal->ValueAt(index);
+      ctx.write_set_.push_back(std::move(write_guard));
+      write_guard = bpm_->FetchPageWrite(page_id);
+    }
+    auto leaf = write_guard.AsMut<LeafPage>();
+    do {
+      if (leaf->Insert(entries[i].first, entries[i].second, comparator_)) {
+        inserted++;
+      }
+      i++;
+      if (leaf->GetSize() == leaf->GetMaxSize()) {
+        SplitLeaf(ctx, write_guard);
+        break;
+      }
+    } while (i < entries.size() &&
+             (!upper_bound.has_value() || comparator_(entries[i].first, *upper_bound) < 0));
+    while (!ctx.write_set_.empty()) {
+      ctx.write_set_.front().Drop();
+      ctx.write_set_.pop_front();
+    }
+    write_guard.Drop();
+  }
+  ctx.header_page_->Drop();
+  return inserted;
+}
+
+/*
+ * Split a full leaf in two and insert the separator into its parent.
+ * The parent chain must be in ctx.write_set_.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SplitLeaf(Context &ctx, WritePageGuard &leaf_guard) {
+  auto leaf = leaf_guard.AsMut<LeafPage>();
+  page_id_t leaf_page_id = leaf_guard.PageId();
+  page_id_t page_id;
+  BasicPageGuard new_guard = bpm_->NewPageGuarded(&page_id);
+  auto new_page = new_guard.AsMut<LeafPage>();
+  new_page->Init(leaf_max_size_);
+  std::shared_ptr<MappingType[]> tmp(new MappingType[leaf->GetMaxSize()]);
+  leaf->CopyOut(tmp);
+  new_page->CopyIn(tmp);
+  page_id_t next_page_id = leaf->GetNextPageId();
+  new_page->SetNextPageId(next_page_id);
+  new_page->SetPrePageId(leaf_page_id);
+  // the new leaf is not latched, it must be complete before a reverse scan can reach it from the next leaf
+  SetPrePageIdOf(next_page_id, page_id);
+  leaf->SetNextPageId(page_id);
+  InsertParent(tmp[0].first, page_id, ctx, leaf_page_id);
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::InsertParent(const KeyType &key, page_id_t page_id, Context &ctx, page_id_t page_id_1) {
-  if (ctx.write_set_.empty()) {
+  if (ctx.IsRootPage(page_id_1)) {
     page_id_t new_page_id;
     BasicPageGuard new_guard = bpm_->NewPageGuarded(&new_page_id);
     auto new_page = new_guard.AsMut<InternalPage>();
     new_page->Init(internal_max_size_);
     new_page->Insert(key, page_id, comparator_);
     new_page->SetValueAt(0, page_id_1);
-    WritePageGuard head_guard = std::move(*ctx.header_page_);
-    auto head = head_guard.AsMut<BPlusTreeHeaderPage>();
-    head->root_page_id_ = new_page_id;
-    ctx.header_page_ = std::move(head_guard);
+    SetRootPageId(ctx, new_page_id);
     return;
   }
   WritePageGuard parent_guard = std::move(ctx.write_set_.back());
@@ -199,27 +364,17 @@ void BPLUSTREE_TYPE::InsertParent(const KeyType &key, page_id_t page_id, Context
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *txn) {
   // Declaration of context instance.
-  WritePageGuard head_guard = bpm_->FetchPageWrite(header_page_id_);
-  auto head = head_guard.As<BPlusTreeHeaderPage>();
-  if (head->root_page_id_ == INVALID_PAGE_ID) {
-    return;
-  }
   Context ctx;
-  page_id_t root_page_id = head->root_page_id_;
-  ctx.header_page_ = std::move(head_guard);
-  ctx.root_page_id_ = root_page_id;
-  WritePageGuard write_guard = bpm_->FetchPageWrite(root_page_id);
-  auto cur = write_guard.AsMut<BPlusTreePage>();
-  page_id_t tmp_page_id = root_page_id;
-  while (!cur->IsLeafPage()) {
-    ctx.write_set_.push_back(std::move(write_guard));
-    auto internal = reinterpret_cast<const InternalPage *>(cur);
-    tmp_page_id = internal->FindValue(key, comparator_);
-    write_guard = bpm_->FetchPageWrite(tmp_page_id);
-    cur = write_guard.AsMut<BPlusTreePage>();
+  ctx.merge_threshold_ = merge_threshold_.load();
+  auto leaf_guard = FindLeafWrite(key, ctx, false);
+  if (!leaf_guard.has_value()) {
+    return;
   }
+  WritePageGuard write_guard = std::move(*leaf_guard);
   Merge(ctx, key, write_guard);
-  ctx.header_page_->Drop();
+  if (ctx.header_page_.has_value()) {
+    ctx.header_page_->Drop();
+  }
   while (!ctx.write_set_.empty()) {
     ctx.write_set_.front().Drop();
     ctx.write_set_.pop_front();
@@ -230,96 +385,121 @@ INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::Merge(Context &ctx, const KeyType &key, WritePageGuard &write_guard) {
   auto leaf = write_guard.AsMut<LeafPage>();
   leaf->Remove(key, comparator_);
-  int max_size = leaf->GetMaxSize();
-  int least_size = (max_size + 2) / 2 - 1;
-  if (ctx.write_set_.empty()) {
+  RebalanceLeaf(ctx, key, write_guard);
+}
+
+/*
+ * Borrow from or merge with a sibling if the leaf shrank below the merge
+ * threshold of ctx. `key` routes to the leaf, its parent chain must be in
+ * ctx.write_set_.
+ * @return: true if a leaf was merged away
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RebalanceLeaf(Context &ctx, const KeyType &key, WritePageGuard &write_guard) -> bool {
+  auto leaf = write_guard.AsMut<LeafPage>();
+  int least_size = LeafMinSize(leaf->GetMaxSize(), ctx.merge_threshold_);
+  if (ctx.IsRootPage(write_guard.PageId())) {
     if (leaf->GetSize() == 0) {
       page_id_t write_guard_id = write_guard.PageId();
+      SetRootPageId(ctx, INVALID_PAGE_ID);
       write_guard.Drop();
       bpm_->DeletePage(write_guard_id);
-      WritePageGuard head_guard = std::move(*ctx.header_page_);
-      ctx.header_page_ = std::nullopt;
-      auto head = head_guard.AsMut<BPlusTreeHeaderPage>();
-      head->root_page_id_ = INVALID_PAGE_ID;
-      ctx.header_page_ = std::move(head_guard);
     }
-    return;
+    return false;
   }
-  if (leaf->GetSize() < least_size) {
-    WritePageGuard parent_guard = std::move(ctx.write_set_.back());
-    auto internal_p = parent_guard.AsMut<InternalPage>();
-    ctx.write_set_.pop_back();
-    int index = internal_p->KeyIndex(key, comparator_);
-    int bro_index;
-    bool is_right;
-    if (index != internal_p->GetSize() - 1) {
-      bro_index = index + 1;
-      is_right = true;
+  if (leaf->GetSize() >= least_size) {
+    return false;
+  }
+  WritePageGuard parent_guard = std::move(ctx.write_set_.back());
+  auto internal_p = parent_guard.AsMut<InternalPage>();
+  ctx.write_set_.pop_back();
+  int index = internal_p->KeyIndex(key, comparator_);
+  int bro_index;
+  bool is_right;
+  if (index != internal_p->GetSize() - 1) {
+    bro_index = index + 1;
+    is_right = true;
+  } else {
+    bro_index = index - 1;
+    is_right = false;
+  }
+  page_id_t page_id = internal_p->ValueAt(bro_index);
+  WritePageGuard guard = bpm_->FetchPageWrite(page_id);
+  auto page_p = guard.AsMut<LeafPage>();
+  if (page_p->GetSize() > least_size) {
+    if (is_right) {
+      MappingType mp = {page_p->KeyAt(0), page_p->ValueAt(0)};
+      page_p->Remove(0);
+      leaf->Insert(leaf->GetSize(), mp);
+      internal_p->SetKeyAt(index + 1, page_p->KeyAt(0));
     } else {
-      bro_index = index - 1;
-      is_right = false;
+      int size = page_p->GetSize();
+      MappingType mp = {page_p->KeyAt(size - 1), page_p->ValueAt(size - 1)};
+      page_p->IncreaseSize(-1);
+      leaf->Insert(0, mp);
+      internal_p->SetKeyAt(index, mp.first);
     }
-    page_id_t page_id = internal_p->ValueAt(bro_index);
-    WritePageGuard guard = bpm_->FetchPageWrite(page_id);
-    auto page_p = guard.AsMut<LeafPage>();
-    if (page_p->GetSize() > least_size) {
-      if (is_right) {
-        MappingType mp = {page_p->KeyAt(0), page_p->ValueAt(0)};
-        page_p->Remove(0);
-        leaf->Insert(leaf->GetSize(), mp);
-        internal_p->SetKeyAt(index + 1, page_p->KeyAt(0));
-      } else {
-        int size = page_p->GetSize();
-        MappingType mp = {page_p->KeyAt(size - 1), page_p->ValueAt(size - 1)};
-        page_p->IncreaseSize(-1);
-        leaf->Insert(0, mp);
-        internal_p->SetKeyAt(index, mp.first);
-      }
-      ctx.write_set_.push_back(std::move(write_guard));
-      ctx.write_set_.push_back(std::move(guard));
-    } else {
-      if (is_right) {
-        leaf->Copy(page_p);
-        leaf->SetNextPageId(page_p->GetNextPageId());
-        guard.Drop();
-        bpm_->DeletePage(page_id);
-        DeleteParent(parent_guard, ctx, index + 1, key);
-        ctx.write_set_.push_back(std::move(write_guard));
+    ctx.write_set_.push_back(std::move(write_guard));
+    ctx.write_set_.push_back(std::move(guard));
+    return false;
+  }
+  if (is_right) {
+    leaf->Copy(page_p);
+    leaf->SetNextPageId(page_p->GetNextPageId());
+    SetPrePageIdOf(page_p->GetNextPageId(), write_guard.PageId());
+    guard.Drop();
+    bpm_->DeletePage(page_id);
+    DeleteParent(parent_guard, ctx, index + 1, key);
+    ctx.write_set_.push_back(std::move(write_guard));
+  } else {
+    page_p->Copy(leaf);
+    page_p->SetNextPageId(leaf->GetNextPageId());
+    SetPrePageIdOf(leaf->GetNextPageId(), page_id);
+    page_id_t write_guard_id = write_guard.PageId();
+    write_guard.Drop();
+    bpm_->DeletePage(write_guard_id);
+    DeleteParent(parent_guard, ctx, index, key);
+    ctx.write_set_.push_back(std::move(guard));
+  }
+  return true;
+}
 
-      } else {
-        page_p->Copy(leaf);
-        page_p->SetNextPageId(leaf->GetNextPageId());
-        page_id_t write_guard_id = write_guard.PageId();
-        write_guard.Drop();
-        bpm_->DeletePage(write_guard_id);
-        DeleteParent(parent_guard, ctx, index, key);
-        ctx.write_set_.push_back(std::move(guard));
-      }
-    }
+/*
+ * Point the previous-leaf link of leaf `page_id` (if any) at `pre_page_id`.
+ * Only called by restructuring writers, which latch this leaf while holding
+ * their write-latched path. The header page write latch keeps them to one at a
+ * time, but leaf-only inserts and removes do not take it, so what keeps this
+ * deadlock-free is that no holder of a leaf latch waits for anything else: a
+ * leaf-only writer holds just its one leaf, plus a read latch on the parent
+ * while it gets the leaf, which it never upgrades and gives up right after,
+ * and lookups and iterators hold a single leaf at a time. The wait for this
+ * leaf therefore always ends.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SetPrePageIdOf(page_id_t page_id, page_id_t pre_page_id) {
+  if (page_id == INVALID_PAGE_ID) {
+    return;
   }
+  WritePageGuard guard = bpm_->FetchPageWrite(page_id);
+  guard.AsMut<LeafPage>()->SetPrePageId(pre_page_id);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::DeleteParent(WritePageGuard &write_guard, Context &ctx, int index, const KeyType &key) {
   auto internal_p = write_guard.AsMut<InternalPage>();
   internal_p->Remove(index);
-  if (ctx.write_set_.empty()) {
+  if (ctx.IsRootPage(write_guard.PageId())) {
     if (internal_p->GetSize() == 1) {
-      WritePageGuard head_guard = std::move(*ctx.header_page_);
-      ctx.header_page_ = std::nullopt;
-      auto head = head_guard.AsMut<BPlusTreeHeaderPage>();
-      head->root_page_id_ = internal_p->ValueAt(0);
+      SetRootPageId(ctx, internal_p->ValueAt(0));
       page_id_t write_guard_id = write_guard.PageId();
       write_guard.Drop();
       bpm_->DeletePage(write_guard_id);
-      ctx.header_page_ = std::move(head_guard);
     } else {
       ctx.write_set_.push_back(std::move(write_guard));
     }
     return;
   }
-  int max_size = internal_p->GetMaxSize();
-  int least_size = (max_size + 1) / 2 - 1;
+  int least_size = InternalMinSize(internal_p->GetMaxSize(), ctx.merge_threshold_);
   if (internal_p->GetSize() - 1 < least_size) {
     WritePageGuard parent_guard = std::move(ctx.write_set_.back());
     auto parent_p = parent_guard.AsMut<InternalPage>();
@@ -376,6 +556,103 @@ void BPLUSTREE_TYPE::DeleteParent(WritePageGuard &write_guard, Context &ctx, int
   }
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::LeafMinSize(int max_size, double threshold) -> int {
+  return std::max(1, static_cast<int>(max_size * threshold));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::InternalMinSize(int max_size, double threshold) -> int {
+  return std::max(1, static_cast<int>((max_size + 1) * threshold) - 1);
+}
+
+/*
+ * Any threshold up to one half keeps a merge from overflowing: a node below
+ * it and a sibling that cannot lend fit together in one page.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SetMergeThreshold(double threshold) {
+  BUSTUB_ASSERT(threshold >= 0 && threshold <= EAGER_MERGE_THRESHOLD, "merge threshold out of range");
+  merge_threshold_ = threshold;
+}
+
+/*****************************************************************************
+ * COMPACTION
+ *****************************************************************************/
+/*
+ * Visit the leaves from left to right and rebalance every one that is less
+ * than half full, as an eager delete would have. Each leaf is handled under
+ * its own header page write latch, so writers only wait for one rebalance at
+ * a time instead of the whole pass. The leaf to visit next is found again
+ * from the root by the separator that bounded the previous one on the right:
+ * after a merge that is the merged leaf itself, which gets another look.
+ * @return: the number of leaves merged away
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::Compact(Transaction *txn) -> size_t {
+  size_t merged = 0;
+  std::optional<KeyType> next_key = std::nullopt;
+  while (true) {
+    Context ctx;
+    ctx.header_page_ = bpm_->FetchPageWrite(header_page_id_);
+    ctx.root_page_id_ = ctx.header_page_->As<BPlusTreeHeaderPage>()->root_page_id_;
+    if (ctx.root_page_id_ == INVALID_PAGE_ID) {
+      break;
+    }
+    WritePageGuard write_guard = bpm_->FetchPageWrite(ctx.root_page_id_);
+    std::optional<KeyType> upper_bound = std::nullopt;
+    while (!write_guard.As<BPlusTreePage>()->IsLeafPage()) {
+      auto internal = write_guard.As<InternalPage>();
+      int index = next_key.has_value() ? internal->KeyIndex(*next_key, comparator_) : 0;
+      if (index + 1 < internal->GetSize()) {
+        upper_bound = internal->KeyAt(index + 1);
+      }
+      page_id_t page_id = internal->ValueAt(index);
+      ctx.write_set_.push_back(std::move(write_guard));
+      write_guard = bpm_->FetchPageWrite(page_id);
+    }
+    auto leaf = write_guard.As<LeafPage>();
+    if (!ctx.write_set_.empty() && leaf->GetSize() < LeafMinSize(leaf->GetMaxSize(), EAGER_MERGE_THRESHOLD)) {
+      KeyType key = leaf->KeyAt(0);
+      if (RebalanceLeaf(ctx, key, write_guard)) {
+        merged++;
+      }
+    }
+    if (!upper_bound.has_value()) {
+      break;
+    }
+    next_key = upper_bound;
+  }
+  return merged;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::StartBackgroundCompaction() {
+  if (compaction_thread_ != nullptr) {
+    return;
+  }
+  enable_compaction_ = true;
+  compaction_thread_ = new std::thread(&BPlusTree::RunCompaction, this);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::StopBackgroundCompaction() {
+  enable_compaction_ = false;
+  if (compaction_thread_ != nullptr) {
+    compaction_thread_->join();
+    delete compaction_thread_;
+    compaction_thread_ = nullptr;
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::RunCompaction() {
+  while (enable_compaction_) {
+    std::this_thread::sleep_for(b_plus_tree_compaction_interval);
+    Compact();
+  }
+}
+
 /*****************************************************************************
  * INDEX ITERATOR
  *****************************************************************************/
@@ -386,32 +663,11 @@ void BPLUSTREE_TYPE::DeleteParent(WritePageGuard &write_guard, Context &ctx, int
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE {
-  ReadPageGuard head_guard = bpm_->FetchPageRead(header_page_id_);
-  auto head = head_guard.As<BPlusTreeHeaderPage>();
-  if (head->root_page_id_ == INVALID_PAGE_ID) {
-    INDEXITERATOR_TYPE it;
-    return it;
+  auto guard = FindLeafRead(nullptr);
+  if (!guard.has_value()) {
+    return INDEXITERATOR_TYPE();
   }
-  Context ctx;
-  page_id_t root_page_id = head->root_page_id_;
-  auto guard = bpm_->FetchPageRead(root_page_id);
-  auto cur = guard.As<BPlusTreePage>();
-  while (!cur->IsLeafPage()) {
-    ctx.read_set_.push_back(std::move(guard));
-    auto internal = reinterpret_cast<const InternalPage *>(cur);
-    page_id_t page_id = internal->ValueAt(0);
-    guard = bpm_->FetchPageRead(page_id);
-    cur = guard.As<BPlusTreePage>();
-  }
-  page_id_t page_id = guard.PageId();
-  INDEXITERATOR_TYPE it(page_id, 0, bpm_);
-  head_guard.Drop();
-  while (!ctx.read_set_.empty()) {
-    ctx.read_set_.front().Drop();
-    ctx.read_set_.pop_front();
-  }
-  guard.Drop();
-  return it;
+  return INDEXITERATOR_TYPE(this, bpm_, std::move(*guard), 0);
 }
 
 /*
@@ -421,35 +677,279 @@ auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE {
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE {
-  ReadPageGuard head_guard = bpm_->FetchPageRead(header_page_id_);
-  auto head = head_guard.As<BPlusTreeHeaderPage>();
-  if (head->root_page_id_ == INVALID_PAGE_ID) {
-    INDEXITERATOR_TYPE it;
-    return it;
+  auto guard = FindLeafRead(&key);
+  if (!guard.has_value()) {
+    return INDEXITERATOR_TYPE();
   }
-  Context ctx;
+  int num = guard->template As<LeafPage>()->LowerBound(key, comparator_);
+  INDEXITERATOR_TYPE it(this, bpm_, std::move(*guard), num);
+  // if the position fell off the leaf and the iterator had to re-seek, it may land before the bound
+  while (!it.IsEnd() && comparator_((*it).first, key) < 0) {
+    ++it;
+  }
+  return it;
+}
+
+/*
+ * Same as Begin(key), but skip the input key itself if it is present
+ * @return : index iterator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::BeginAfter(const KeyType &key) -> INDEXITERATOR_TYPE {
+  auto guard = FindLeafRead(&key);
+  if (!guard.has_value()) {
+    return INDEXITERATOR_TYPE();
+  }
+  auto leaf = guard->template As<LeafPage>();
+  int num = leaf->LowerBound(key, comparator_);
+  if (num < leaf->GetSize() && comparator_(leaf->KeyAt(num), key) == 0) {
+    num++;
+  }
+  INDEXITERATOR_TYPE it(this, bpm_, std::move(*guard), num);
+  while (!it.IsEnd() && comparator_((*it).first, key) <= 0) {
+    ++it;
+  }
+  return it;
+}
+
+/*
+ * Find the rightmost leaf page first, then construct a reverse index iterator
+ * on its last entry
+ * @return : reverse index iterator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RBegin() -> INDEXITERATOR_TYPE {
+  auto guard = FindLeafRead(nullptr, true);
+  if (!guard.has_value()) {
+    return INDEXITERATOR_TYPE();
+  }
+  int num = guard->template As<LeafPage>()->GetSize() - 1;
+  return INDEXITERATOR_TYPE(this, bpm_, std::move(*guard), num, true);
+}
+
+/*
+ * Input parameter is high key, find the leaf page that contains the input key
+ * first, then construct a reverse index iterator on the last key <= input key
+ * @return : reverse index iterator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RBegin(const KeyType &key) -> INDEXITERATOR_TYPE {
+  auto guard = FindLeafRead(&key);
+  if (!guard.has_value()) {
+    return INDEXITERATOR_TYPE();
+  }
+  auto leaf = guard->template As<LeafPage>();
+  int num = leaf->LowerBound(key, comparator_);
+  if (num == leaf->GetSize() || comparator_(leaf->KeyAt(num), key) != 0) {
+    num--;
+  }
+  INDEXITERATOR_TYPE it(this, bpm_, std::move(*guard), num, true);
+  while (!it.IsEnd() && comparator_((*it).first, key) > 0) {
+    ++it;
+  }
+  return it;
+}
+
+/*
+ * Same as RBegin(key), but skip the input key itself if it is present
+ * @return : reverse index iterator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RBeginBefore(const KeyType &key) -> INDEXITERATOR_TYPE {
+  auto guard = FindLeafRead(&key);
+  if (!guard.has_value()) {
+    return INDEXITERATOR_TYPE();
+  }
+  int num = guard->template As<LeafPage>()->LowerBound(key, comparator_) - 1;
+  INDEXITERATOR_TYPE it(this, bpm_, std::move(*guard), num, true);
+  while (!it.IsEnd() && comparator_((*it).first, key) >= 0) {
+    ++it;
+  }
+  return it;
+}
 
-  page_id_t root_page_id = head->root_page_id_;
-  auto guard = bpm_->FetchPageRead(root_page_id);
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FindLeafRead(const KeyType *key, bool rightmost) -> std::optional<ReadPageGuard> {
+  for (int attempt = 0; attempt < OPTIMISTIC_DESCENT_ATTEMPTS; attempt++) {
+    std::optional<ReadPageGuard> leaf;
+    if (FindLeafOptimistic(key, rightmost, &leaf)) {
+      return leaf;
+    }
+  }
+  auto root_guard = FetchRootRead();
+  if (!root_guard.has_value()) {
+    return std::nullopt;
+  }
+  ReadPageGuard guard = std::move(*root_guard);
   auto cur = guard.As<BPlusTreePage>();
   while (!cur->IsLeafPage()) {
-    ctx.read_set_.push_back(std::move(guard));
     auto internal = reinterpret_cast<const InternalPage *>(cur);
-    page_id_t page_id = internal->FindValue(key, comparator_);
+    page_id_t page_id;
+    if (key != nullptr) {
+      page_id = internal->FindValue(*key, comparator_);
+    } else {
+      page_id = internal->ValueAt(rightmost ? internal->GetSize() - 1 : 0);
+    }
+    // the child is latched before the parent guard is released by the move assignment
     guard = bpm_->FetchPageRead(page_id);
     cur = guard.As<BPlusTreePage>();
   }
-  page_id_t page_id = guard.PageId();
-  auto leaf = reinterpret_cast<const LeafPage *>(cur);
-  int num = leaf->KeyIndex(key, comparator_);
-  INDEXITERATOR_TYPE it(page_id, num, bpm_);
-  head_guard.Drop();
-  while (!ctx.read_set_.empty()) {
-    ctx.read_set_.front().Drop();
-    ctx.read_set_.pop_front();
+  return std::make_optional(std::move(guard));
+}
+
+/*
+ * Each internal page is copied while only pinned, and the copy is used once
+ * the version of the page is found unchanged after it. The child it names was
+ * still linked when it got pinned if the parent is unchanged after the pin as
+ * well: unlinking it write-latches the parent, and a pinned page cannot be
+ * deleted. The leaf is read-latched if it still has the version it had when
+ * pinned, and the root is checked against the cached root page id as in
+ * FetchRootRead.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FindLeafOptimistic(const KeyType *key, bool rightmost, std::optional<ReadPageGuard> *leaf)
+    -> bool {
+  page_id_t root_page_id = root_page_id_.load();
+  if (root_page_id == INVALID_PAGE_ID) {
+    *leaf = std::nullopt;
+    return true;
   }
-  guard.Drop();
-  return it;
+  OptimisticPageGuard guard = bpm_->FetchPageOptimistic(root_page_id);
+  if (!guard.IsValid() || root_page_id_.load() != root_page_id) {
+    return false;
+  }
+  alignas(InternalPage) char page_copy[BUSTUB_PAGE_SIZE];
+  // the type of a page is set before the page is linked into the tree and never changes
+  while (!guard.As<BPlusTreePage>()->IsLeafPage()) {
+    if (!guard.CopyData(page_copy)) {
+      return false;
+    }
+    auto internal = reinterpret_cast<const InternalPage *>(page_copy);
+    page_id_t page_id;
+    if (key != nullptr) {
+      page_id = internal->FindValue(*key, comparator_);
+    } else {
+      page_id = internal->ValueAt(rightmost ? internal->GetSize() - 1 : 0);
+    }
+    OptimisticPageGuard child = bpm_->FetchPageOptimistic(page_id);
+    if (!child.IsValid() || !guard.Validate()) {
+      return false;
+    }
+    guard = std::move(child);
+  }
+  *leaf = guard.UpgradeRead();
+  return leaf->has_value();
+}
+
+/*
+ * The cached root page id is only changed while the old root is write-latched,
+ * and page ids are never reused. So once the page it named is latched, the
+ * page is still the root if the cached id did not change in between: a root
+ * split or collapse that raced with the fetch is seen as a different id, and
+ * the fetch is retried.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FetchRootRead() -> std::optional<ReadPageGuard> {
+  while (true) {
+    page_id_t root_page_id = root_page_id_.load();
+    if (root_page_id == INVALID_PAGE_ID) {
+      return std::nullopt;
+    }
+    ReadPageGuard guard = bpm_->FetchPageRead(root_page_id);
+    if (root_page_id_.load() == root_page_id) {
+      return std::make_optional(std::move(guard));
+    }
+  }
+}
+
+/*
+ * Descend to the leaf of key for an insert or a remove. Most of them only
+ * change their leaf, so the leaf is first reached optimistically with read
+ * latches, as a lookup would, and write-latched while its parent is still
+ * read-latched. If the leaf turns out unsafe, i.e. the operation may split
+ * (or rebalance) it, the descent starts over pessimistically: the header page
+ * and then the path are write-latched, and the latches above a safe page are
+ * released as soon as it is reached. The header page itself is kept until the
+ * operation ends, so restructuring writers run one at a time and the buffer
+ * pool never has to hold more than one of their latched paths.
+ * @return: the write guard of the leaf, or nullopt if the tree is empty, in
+ * which case the header page is left latched in ctx.header_page_
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FindLeafWrite(const KeyType &key, Context &ctx, bool is_insert) -> std::optional<WritePageGuard> {
+  std::optional<ReadPageGuard> guard = FetchRootRead();
+  if (guard.has_value()) {
+    page_id_t root_page_id = guard->PageId();
+    std::optional<WritePageGuard> leaf_guard = std::nullopt;
+    if (guard->As<BPlusTreePage>()->IsLeafPage()) {
+      guard = std::nullopt;
+      leaf_guard = bpm_->FetchPageWrite(root_page_id);
+      if (root_page_id_.load() != root_page_id) {
+        // the root leaf was split or emptied while it was not latched
+        leaf_guard = std::nullopt;
+      }
+    } else {
+      while (true) {
+        page_id_t page_id = guard->As<InternalPage>()->FindValue(key, comparator_);
+        ReadPageGuard child = bpm_->FetchPageRead(page_id);
+        if (child.As<BPlusTreePage>()->IsLeafPage()) {
+          // the parent stays read-latched, so the leaf cannot be split or merged before it is write-latched
+          child.Drop();
+          leaf_guard = bpm_->FetchPageWrite(page_id);
+          break;
+        }
+        guard = std::move(child);
+      }
+      guard = std::nullopt;
+    }
+    if (leaf_guard.has_value() && IsSafe(leaf_guard->As<BPlusTreePage>(), leaf_guard->PageId() == root_page_id,
+                                         is_insert, ctx.merge_threshold_)) {
+      ctx.root_page_id_ = root_page_id;
+      return leaf_guard;
+    }
+  }
+
+  ctx.header_page_ = bpm_->FetchPageWrite(header_page_id_);
+  ctx.root_page_id_ = ctx.header_page_->As<BPlusTreeHeaderPage>()->root_page_id_;
+  if (ctx.root_page_id_ == INVALID_PAGE_ID) {
+    return std::nullopt;
+  }
+  WritePageGuard write_guard = bpm_->FetchPageWrite(ctx.root_page_id_);
+  while (!write_guard.As<BPlusTreePage>()->IsLeafPage()) {
+    page_id_t page_id = write_guard.As<InternalPage>()->FindValue(key, comparator_);
+    ctx.write_set_.push_back(std::move(write_guard));
+    write_guard = bpm_->FetchPageWrite(page_id);
+    if (IsSafe(write_guard.As<BPlusTreePage>(), false, is_insert, ctx.merge_threshold_)) {
+      ctx.write_set_.clear();
+    }
+  }
+  return std::make_optional(std::move(write_guard));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::IsSafe(const BPlusTreePage *page, bool is_root, bool is_insert, double merge_threshold) -> bool {
+  if (page->IsLeafPage()) {
+    if (is_insert) {
+      return page->GetSize() + 1 < page->GetMaxSize();
+    }
+    return is_root ? page->GetSize() > 1 : page->GetSize() - 1 >= LeafMinSize(page->GetMaxSize(), merge_threshold);
+  }
+  if (is_insert) {
+    return page->GetSize() < page->GetMaxSize();
+  }
+  return is_root ? page->GetSize() > 2 : page->GetSize() - 2 >= InternalMinSize(page->GetMaxSize(), merge_threshold);
+}
+
+/*
+ * Only called with the header page and the old root write-latched, see
+ * FetchRootRead.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SetRootPageId(Context &ctx, page_id_t root_page_id) {
+  BUSTUB_ASSERT(ctx.header_page_.has_value(), "the root changed without the header page latched");
+  ctx.header_page_->template AsMut<BPlusTreeHeaderPage>()->root_page_id_ = root_page_id;
+  ctx.root_page_id_ = root_page_id;
+  root_page_id_.store(root_page_id);
 }
 
 /*
@@ -467,11 +967,7 @@ auto BPLUSTREE_TYPE::End() -> INDEXITERATOR_TYPE {
  * @return Page id of the root of this tree
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t {
-  ReadPageGuard guard = bpm_->FetchPageRead(header_page_id_);
-  auto root_page = guard.As<BPlusTreeHeaderPage>();
-  return root_page->root_page_id_;
-}
+auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t { return root_page_id_.load(); }
 
 /*****************************************************************************
  * UTILITIES AND DEBUG
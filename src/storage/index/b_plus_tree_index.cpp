@@ -9,6 +9,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstring>
+
 #include "storage/index/b_plus_tree_index.h"
 
 namespace bustub {
@@ -28,7 +31,7 @@ INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool {
   // construct insert index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetEntrySchema());
 
   return container_->Insert(index_key, rid, transaction);
 }
@@ -37,7 +40,7 @@ INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct delete index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetEntrySchema());
 
   container_->Remove(index_key, transaction);
 }
@@ -46,9 +49,98 @@ INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
   // construct scan index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  size_t key_length = index_key.SetFromKey(key, *GetKeySchema());
+
+  if (!GetMetadata()->HasIncludedColumns()) {
+    container_->GetValue(index_key, result, transaction);
+    return;
+  }
+  // The included columns follow the key in the entries, so every entry of the key starts with its encoding. The
+  // zero-filled search key sorts before all of them.
+  for (auto it = container_->Begin(index_key); !it.IsEnd(); ++it) {
+    if (memcmp((*it).first.data_, index_key.data_, key_length) != 0) {
+      break;
+    }
+    result->push_back((*it).second);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::ScanRange(const Tuple *lower, const Tuple *upper, std::vector<RID> *result,
+                                     Transaction *transaction) {
+  ScanRange(lower, upper, result, nullptr, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::ScanRange(const Tuple *lower, const Tuple *upper, std::vector<RID> *result,
+                                     std::vector<KeyType> *entries, Transaction *transaction) {
+  KeyType lower_key;
+  if (lower != nullptr) {
+    lower_key.SetFromKey(*lower, *GetKeySchema());
+  }
+  KeyType upper_key;
+  size_t upper_length = 0;
+  if (upper != nullptr) {
+    upper_length = upper_key.SetFromKey(*upper, *GetKeySchema());
+  }
+  // A zero-filled key sorts before every entry that starts with it, and entries that go past the upper key differ
+  // from it within its encoded length, whatever columns are included after the key.
+  for (auto it = lower != nullptr ? container_->Begin(lower_key) : container_->Begin(); !it.IsEnd(); ++it) {
+    if (upper != nullptr && memcmp((*it).first.data_, upper_key.data_, upper_length) > 0) {
+      break;
+    }
+    result->push_back((*it).second);
+    if (entries != nullptr) {
+      entries->push_back((*it).first);
+    }
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::InsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction)
+    -> size_t {
+  // construct insert index keys and sort them so that the tree can share descents
+  std::vector<MappingType> index_entries(entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    index_entries[i].first.SetFromKey(entries[i].first, *GetEntrySchema());
+    index_entries[i].second = entries[i].second;
+  }
+  std::stable_sort(index_entries.begin(), index_entries.end(), [this](const MappingType &a, const MappingType &b) {
+    return comparator_(a.first, b.first) < 0;
+  });
+
+  return container_->InsertBatch(index_entries, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *result,
+                                    Transaction *transaction) {
+  if (GetMetadata()->HasIncludedColumns()) {
+    // every key may match several entries, look them up one by one
+    Index::ScanKeys(keys, result, transaction);
+    return;
+  }
+  // construct scan index keys, remembering where each one came from
+  std::vector<std::pair<KeyType, size_t>> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].first.SetFromKey(keys[i], *GetKeySchema());
+    index_keys[i].second = i;
+  }
+  std::sort(index_keys.begin(), index_keys.end(), [this](const auto &a, const auto &b) {
+    return comparator_(a.first, b.first) < 0;
+  });
+  std::vector<KeyType> sorted_keys;
+  sorted_keys.reserve(index_keys.size());
+  for (const auto &[index_key, pos] : index_keys) {
+    sorted_keys.push_back(index_key);
+  }
 
-  container_->GetValue(index_key, result, transaction);
+  std::vector<std::vector<RID>> sorted_result;
+  container_->GetValues(sorted_keys, &sorted_result, transaction);
+  result->assign(keys.size(), std::vector<RID>{});
+  for (size_t i = 0; i < index_keys.size(); i++) {
+    (*result)[index_keys[i].second] = std::move(sorted_result[i]);
+  }
 }
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -60,6 +152,14 @@ auto BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType &key) -> INDEXITERATOR
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::GetEndIterator() -> INDEXITERATOR_TYPE { return container_->End(); }
 
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::GetReverseBeginIterator() -> INDEXITERATOR_TYPE { return container_->RBegin(); }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::GetReverseBeginIterator(const KeyType &key) -> INDEXITERATOR_TYPE {
+  return container_->RBegin(key);
+}
+
 template class BPlusTreeIndex<GenericKey<4>, RID, GenericComparator<4>>;
 template class BPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>>;
 template class BPlusTreeIndex<GenericKey<16>, RID, GenericComparator<16>>;
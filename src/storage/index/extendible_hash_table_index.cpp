@@ -18,7 +18,7 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool {
   // construct insert index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetKeySchema());
 
   return container_.Insert(transaction, index_key, rid);
 }
@@ -27,7 +27,7 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct delete index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetKeySchema());
 
   container_.Remove(transaction, index_key, rid);
 }
@@ -36,10 +36,27 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
   // construct scan index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetKeySchema());
 
   container_.GetValue(transaction, index_key, result);
 }
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_INDEX_TYPE::ScanRange(const Tuple *lower, const Tuple *upper, std::vector<RID> *result,
+                                      Transaction *transaction) {
+  if (lower != nullptr && upper != nullptr) {
+    KeyType lower_key;
+    lower_key.SetFromKey(*lower, *GetKeySchema());
+    KeyType upper_key;
+    upper_key.SetFromKey(*upper, *GetKeySchema());
+    if (comparator_(lower_key, upper_key) == 0) {
+      container_.GetValue(transaction, lower_key, result);
+      return;
+    }
+  }
+  throw NotImplementedException(fmt::format("hash index {} can only scan a single key", GetName()));
+}
+
 template class ExtendibleHashTableIndex<GenericKey<4>, RID, GenericComparator<4>>;
 template class ExtendibleHashTableIndex<GenericKey<8>, RID, GenericComparator<8>>;
 template class ExtendibleHashTableIndex<GenericKey<16>, RID, GenericComparator<16>>;
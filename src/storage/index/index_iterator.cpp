@@ -3,19 +3,21 @@
  */
 #include <cassert>
 
+#include "storage/index/b_plus_tree.h"
 #include "storage/index/index_iterator.h"
 
 namespace bustub {
 
-/*
- * NOTE: you can change the destructor/constructor method here
- * set your own input parameters
- */
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE::IndexIterator(page_id_t page_id, int num, BufferPoolManager *bpm) {
-  page_id_ = page_id;
+INDEXITERATOR_TYPE::IndexIterator(BPlusTree<KeyType, ValueType, KeyComparator> *tree, BufferPoolManager *bpm,
+                                  ReadPageGuard guard, int num, bool reverse)
+    : tree_(tree), bpm_(bpm), reverse_(reverse) {
+  LoadLeaf(guard);
   num_ = num;
-  bpm_ = bpm;
+  if (num_ < 0 || num_ >= static_cast<int>(entries_.size())) {
+    // the requested position is outside of this leaf, in the direction of the scan
+    NextLeaf();
+  }
 }
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -25,32 +27,106 @@ INDEX_TEMPLATE_ARGUMENTS
 auto INDEXITERATOR_TYPE::IsEnd() -> bool { return page_id_ == INVALID_PAGE_ID; }
 
 INDEX_TEMPLATE_ARGUMENTS
-auto INDEXITERATOR_TYPE::operator*() -> const MappingType & {
-  WritePageGuard guard = bpm_->FetchPageWrite(page_id_);
-  auto leaf = guard.As<LeafPage>();
-  // MappingType& mp = leaf->PairAt(num_);
-  return leaf->PairAt(num_);
-}
+auto INDEXITERATOR_TYPE::operator*() -> const MappingType & { return entries_[num_]; }
 
 INDEX_TEMPLATE_ARGUMENTS
 auto INDEXITERATOR_TYPE::operator++() -> INDEXITERATOR_TYPE & {
-  ReadPageGuard guard = bpm_->FetchPageRead(page_id_);
-  auto leaf = guard.As<LeafPage>();
-  if (num_ != leaf->GetSize() - 1) {
+  if (reverse_ && num_ > 0) {
+    num_--;
+  } else if (!reverse_ && num_ + 1 < static_cast<int>(entries_.size())) {
     num_++;
   } else {
-    if (leaf->GetNextPageId() == INVALID_PAGE_ID) {
-      bpm_ = nullptr;
-      page_id_ = INVALID_PAGE_ID;
-      num_ = -1;
-    } else {
-      page_id_ = leaf->GetNextPageId();
-      num_ = 0;
-    }
+    NextLeaf();
   }
   return *this;
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::LoadLeaf(ReadPageGuard &guard) {
+  auto leaf = guard.As<LeafPage>();
+  page_id_ = guard.PageId();
+  leaf_version_ = guard.GetVersion();
+  next_page_id_ = leaf->GetNextPageId();
+  pre_page_id_ = leaf->GetPrePageId();
+  entries_.clear();
+  entries_.reserve(leaf->GetSize());
+  for (int i = 0; i < leaf->GetSize(); i++) {
+    entries_.push_back(leaf->PairAt(i));
+  }
+  guard.Drop();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::NextLeaf() {
+  page_id_t sibling_page_id = reverse_ ? pre_page_id_ : next_page_id_;
+  if (sibling_page_id == INVALID_PAGE_ID || entries_.empty()) {
+    SetEnd();
+    return;
+  }
+  // the key at the far end of the current leaf in the direction of the scan
+  KeyType last_key = reverse_ ? entries_.front().first : entries_.back().first;
+  ReadPageGuard guard = bpm_->FetchPageRead(sibling_page_id);
+  auto page = guard.As<BPlusTreePage>();
+  bool moved = !page->IsLeafPage() || page->GetSize() == 0;
+  if (!moved) {
+    auto leaf = guard.As<LeafPage>();
+    moved = reverse_ ? tree_->comparator_(last_key, leaf->KeyAt(leaf->GetSize() - 1)) <= 0
+                     : tree_->comparator_(leaf->KeyAt(0), last_key) <= 0;
+  }
+  std::vector<MappingType> sibling_entries;
+  page_id_t sibling_next_page_id = INVALID_PAGE_ID;
+  page_id_t sibling_pre_page_id = INVALID_PAGE_ID;
+  uint64_t sibling_version = 0;
+  if (!moved) {
+    auto leaf = guard.As<LeafPage>();
+    sibling_version = guard.GetVersion();
+    sibling_next_page_id = leaf->GetNextPageId();
+    sibling_pre_page_id = leaf->GetPrePageId();
+    sibling_entries.reserve(leaf->GetSize());
+    for (int i = 0; i < leaf->GetSize(); i++) {
+      sibling_entries.push_back(leaf->PairAt(i));
+    }
+  }
+  guard.Drop();
+  // The sibling pointer is only trustworthy if the leaf we copied it from has not changed since: a split,
+  // a merge or a redistribution with a sibling would all have modified it.
+  if (moved || !LeafUnchanged()) {
+    *this = reverse_ ? tree_->RBeginBefore(last_key) : tree_->BeginAfter(last_key);
+    return;
+  }
+  page_id_ = sibling_page_id;
+  next_page_id_ = sibling_next_page_id;
+  pre_page_id_ = sibling_pre_page_id;
+  leaf_version_ = sibling_version;
+  entries_ = std::move(sibling_entries);
+  num_ = reverse_ ? static_cast<int>(entries_.size()) - 1 : 0;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::LeafUnchanged() -> bool {
+  ReadPageGuard guard = bpm_->FetchPageRead(page_id_);
+  auto page = guard.As<BPlusTreePage>();
+  if (!page->IsLeafPage() || page->GetSize() != static_cast<int>(entries_.size())) {
+    return false;
+  }
+  auto leaf = guard.As<LeafPage>();
+  // the version catches a leaf that changed and changed back, e.g. lent a key to a sibling and borrowed it again
+  return guard.GetVersion() == leaf_version_ &&
+         leaf->GetNextPageId() == next_page_id_ && leaf->GetPrePageId() == pre_page_id_ &&
+         tree_->comparator_(leaf->KeyAt(0), entries_.front().first) == 0 &&
+         tree_->comparator_(leaf->KeyAt(leaf->GetSize() - 1), entries_.back().first) == 0;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::SetEnd() {
+  bpm_ = nullptr;
+  page_id_ = INVALID_PAGE_ID;
+  next_page_id_ = INVALID_PAGE_ID;
+  pre_page_id_ = INVALID_PAGE_ID;
+  num_ = -1;
+  entries_.clear();
+}
+
 template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>>;
 
 template class IndexIterator<GenericKey<8>, RID, GenericComparator<8>>;
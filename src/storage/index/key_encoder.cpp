@@ -0,0 +1,209 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// key_encoder.cpp
+//
+// Identification: src/storage/index/key_encoder.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <string>
+
+#include "common/exception.h"
+#include "storage/index/key_encoder.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+constexpr char NULL_MARKER = 0x00;
+constexpr char VALUE_MARKER = 0x01;
+/** bytes for the NULL marker of a column */
+constexpr size_t MARKER_SIZE = 1;
+/** bytes for the terminator of a VARCHAR */
+constexpr size_t TERMINATOR_SIZE = 2;
+
+/** Write the low `width` bytes of `bits` big-endian. */
+void PutBigEndian(uint64_t bits, size_t width, char *out) {
+  for (size_t i = 0; i < width; i++) {
+    out[i] = static_cast<char>(bits >> (8 * (width - 1 - i)));
+  }
+}
+
+/** The big-endian bytes of a signed integer of `width` bytes, with the sign bit flipped. */
+void PutSigned(int64_t value, size_t width, char *out) {
+  uint64_t sign_bit = uint64_t{1} << (8 * width - 1);
+  PutBigEndian(static_cast<uint64_t>(value) ^ sign_bit, width, out);
+}
+
+/** Read `width` bytes big-endian. */
+auto GetBigEndian(const char *in, size_t width) -> uint64_t {
+  uint64_t bits = 0;
+  for (size_t i = 0; i < width; i++) {
+    bits = (bits << 8) | static_cast<uint8_t>(in[i]);
+  }
+  return bits;
+}
+
+/** Read a signed integer of `width` bytes written by PutSigned. */
+auto GetSigned(const char *in, size_t width) -> int64_t {
+  uint64_t sign_bit = uint64_t{1} << (8 * width - 1);
+  uint64_t bits = GetBigEndian(in, width) ^ sign_bit;
+  if (width < sizeof(uint64_t) && (bits & sign_bit) != 0) {
+    // sign-extend
+    bits |= ~((sign_bit << 1) - 1);
+  }
+  return static_cast<int64_t>(bits);
+}
+
+}  // namespace
+
+auto KeyEncoder::EncodedSize(const Schema &key_schema) -> size_t {
+  size_t size = 0;
+  for (const auto &column : key_schema.GetColumns()) {
+    size += MARKER_SIZE;
+    if (column.GetType() == TypeId::VARCHAR) {
+      size += column.GetLength() + TERMINATOR_SIZE;
+    } else {
+      size += column.GetFixedLength();
+    }
+  }
+  return size;
+}
+
+auto KeyEncoder::Encode(const Tuple &key, const Schema &key_schema, char *data, size_t size) -> size_t {
+  memset(data, 0, size);
+  size_t offset = 0;
+  auto reserve = [&](size_t bytes) -> char * {
+    if (offset + bytes > size) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "index key is too long");
+    }
+    offset += bytes;
+    return data + offset - bytes;
+  };
+
+  for (uint32_t i = 0; i < key_schema.GetColumnCount(); i++) {
+    const auto value = key.GetValue(&key_schema, i);
+    if (value.IsNull()) {
+      *reserve(MARKER_SIZE) = NULL_MARKER;
+      continue;
+    }
+    *reserve(MARKER_SIZE) = VALUE_MARKER;
+    switch (value.GetTypeId()) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+        PutSigned(value.GetAs<int8_t>(), 1, reserve(1));
+        break;
+      case TypeId::SMALLINT:
+        PutSigned(value.GetAs<int16_t>(), 2, reserve(2));
+        break;
+      case TypeId::INTEGER:
+        PutSigned(value.GetAs<int32_t>(), 4, reserve(4));
+        break;
+      case TypeId::BIGINT:
+        PutSigned(value.GetAs<int64_t>(), 8, reserve(8));
+        break;
+      case TypeId::DECIMAL: {
+        auto decimal = value.GetAs<double>();
+        uint64_t bits;
+        memcpy(&bits, &decimal, sizeof(bits));
+        bits = (bits >> 63) != 0 ? ~bits : bits ^ (uint64_t{1} << 63);
+        PutBigEndian(bits, 8, reserve(8));
+        break;
+      }
+      case TypeId::TIMESTAMP:
+        PutBigEndian(value.GetAs<uint64_t>(), 8, reserve(8));
+        break;
+      case TypeId::VARCHAR: {
+        const auto str = value.ToString();
+        for (char c : str) {
+          if (c == '\0') {
+            char *out = reserve(2);
+            out[0] = '\0';
+            out[1] = static_cast<char>(0xFF);
+          } else {
+            *reserve(1) = c;
+          }
+        }
+        // the terminator is already zero
+        reserve(TERMINATOR_SIZE);
+        break;
+      }
+      default:
+        throw NotImplementedException("unsupported index key type");
+    }
+  }
+  return offset;
+}
+
+auto KeyEncoder::Decode(const char *data, const Schema &key_schema) -> std::vector<Value> {
+  std::vector<Value> values;
+  values.reserve(key_schema.GetColumnCount());
+  for (const auto &column : key_schema.GetColumns()) {
+    const auto type = column.GetType();
+    if (*data++ == NULL_MARKER) {
+      values.push_back(ValueFactory::GetNullValueByType(type));
+      continue;
+    }
+    switch (type) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+        values.emplace_back(type, static_cast<int8_t>(GetSigned(data, 1)));
+        data += 1;
+        break;
+      case TypeId::SMALLINT:
+        values.emplace_back(type, static_cast<int16_t>(GetSigned(data, 2)));
+        data += 2;
+        break;
+      case TypeId::INTEGER:
+        values.emplace_back(type, static_cast<int32_t>(GetSigned(data, 4)));
+        data += 4;
+        break;
+      case TypeId::BIGINT:
+        values.emplace_back(type, GetSigned(data, 8));
+        data += 8;
+        break;
+      case TypeId::DECIMAL: {
+        uint64_t bits = GetBigEndian(data, 8);
+        bits = (bits >> 63) != 0 ? bits ^ (uint64_t{1} << 63) : ~bits;
+        double decimal;
+        memcpy(&decimal, &bits, sizeof(decimal));
+        values.emplace_back(type, decimal);
+        data += 8;
+        break;
+      }
+      case TypeId::TIMESTAMP:
+        values.emplace_back(type, GetBigEndian(data, 8));
+        data += 8;
+        break;
+      case TypeId::VARCHAR: {
+        std::string str;
+        // 0x00 0xFF is an escaped NUL, 0x00 0x00 the terminator
+        for (; data[0] != '\0' || data[1] != '\0'; data++) {
+          str.push_back(*data);
+          if (*data == '\0') {
+            data++;
+          }
+        }
+        data += TERMINATOR_SIZE;
+        values.emplace_back(type, str);
+        break;
+      }
+      default:
+        throw NotImplementedException("unsupported index key type");
+    }
+  }
+  return values;
+}
+
+void KeyEncoder::EncodeInteger(int64_t key, char *data, size_t size) {
+  memset(data, 0, size);
+  PutSigned(key, sizeof(int64_t), data);
+}
+
+auto KeyEncoder::DecodeInteger(const char *data) -> int64_t { return GetSigned(data, sizeof(int64_t)); }
+
+}  // namespace bustub
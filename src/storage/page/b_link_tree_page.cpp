@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_link_tree_page.cpp
+//
+// Identification: src/storage/page/b_link_tree_page.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/b_link_tree_page.h"
+#include "common/rid.h"
+
+namespace bustub {
+
+/*
+ * Init method after creating a new node
+ * Leaves are on level 0 and start out empty, internal nodes are filled by their creator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_LINK_TREE_PAGE_TYPE::Init(int max_size, int level) {
+  SetPageType(level == 0 ? IndexPageType::LEAF_PAGE : IndexPageType::INTERNAL_PAGE);
+  SetSize(0);
+  SetMaxSize(max_size);
+  right_page_id_ = INVALID_PAGE_ID;
+  level_ = level;
+  has_high_key_ = 0;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_LINK_TREE_PAGE_TYPE::GetRightPageId() const -> page_id_t { return right_page_id_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_LINK_TREE_PAGE_TYPE::SetRightPageId(page_id_t right_page_id) { right_page_id_ = right_page_id; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_LINK_TREE_PAGE_TYPE::GetLevel() const -> int { return level_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_LINK_TREE_PAGE_TYPE::HasHighKey() const -> bool { return has_high_key_ != 0; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_LINK_TREE_PAGE_TYPE::GetHighKey() const -> KeyType { return high_key_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_LINK_TREE_PAGE_TYPE::SetHighKey(const KeyType &high_key) {
+  has_high_key_ = 1;
+  high_key_ = high_key;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_LINK_TREE_PAGE_TYPE::ShouldMoveRight(const KeyType &key, const KeyComparator &comparator) const -> bool {
+  return HasHighKey() && comparator(key, high_key_) >= 0;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_LINK_TREE_PAGE_TYPE::KeyAt(int index) const -> KeyType {
+  CheckLegal(index, " blink keyat ");
+  return array_[index].first;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_LINK_TREE_PAGE_TYPE::ValueAt(int index) const -> ValueType {
+  CheckLegal(index, " blink valueat ");
+  return array_[index].second;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_LINK_TREE_PAGE_TYPE::LowerBound(const KeyType &key, const KeyComparator &comparator) const -> int {
+  int l = 0;
+  int r = GetSize();
+  while (l < r) {
+    int mid = (l + r) / 2;
+    if (comparator(array_[mid].first, key) < 0) {
+      l = mid + 1;
+    } else {
+      r = mid;
+    }
+  }
+  return l;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_LINK_TREE_PAGE_TYPE::ChildIndex(const KeyType &key, const KeyComparator &comparator) const -> int {
+  // the first key is invalid, find the last key <= key among the others
+  int l = 1;
+  int r = GetSize() - 1;
+  while (l <= r) {
+    int mid = (l + r) / 2;
+    if (comparator(key, array_[mid].first) < 0) {
+      r = mid - 1;
+    } else {
+      l = mid + 1;
+    }
+  }
+  return r;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_LINK_TREE_PAGE_TYPE::InsertAt(int index, const KeyType &key, const ValueType &value) {
+  CheckLegalInsert(index, " blink insert ");
+  for (int i = GetSize(); i > index; i--) {
+    array_[i] = array_[i - 1];
+  }
+  array_[index] = {key, value};
+  IncreaseSize(1);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_LINK_TREE_PAGE_TYPE::RemoveAt(int index) {
+  CheckLegal(index, " blink remove ");
+  for (int i = index; i < GetSize() - 1; i++) {
+    array_[i] = array_[i + 1];
+  }
+  IncreaseSize(-1);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_LINK_TREE_PAGE_TYPE::MoveHalfTo(B_LINK_TREE_PAGE_TYPE *recipient) {
+  int mid = GetSize() / 2;
+  for (int i = mid; i < GetSize(); i++) {
+    recipient->array_[i - mid] = array_[i];
+  }
+  recipient->SetSize(GetSize() - mid);
+  SetSize(mid);
+}
+
+template class BLinkTreePage<GenericKey<4>, RID, GenericComparator<4>>;
+template class BLinkTreePage<GenericKey<8>, RID, GenericComparator<8>>;
+template class BLinkTreePage<GenericKey<16>, RID, GenericComparator<16>>;
+template class BLinkTreePage<GenericKey<32>, RID, GenericComparator<32>>;
+template class BLinkTreePage<GenericKey<64>, RID, GenericComparator<64>>;
+
+template class BLinkTreePage<GenericKey<4>, page_id_t, GenericComparator<4>>;
+template class BLinkTreePage<GenericKey<8>, page_id_t, GenericComparator<8>>;
+template class BLinkTreePage<GenericKey<16>, page_id_t, GenericComparator<16>>;
+template class BLinkTreePage<GenericKey<32>, page_id_t, GenericComparator<32>>;
+template class BLinkTreePage<GenericKey<64>, page_id_t, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -81,4 +81,39 @@ void WritePageGuard::Drop() {
 
 WritePageGuard::~WritePageGuard() { Drop(); }  // NOLINT
 
+OptimisticPageGuard::OptimisticPageGuard(BufferPoolManager *bpm, Page *page) : guard_(bpm, page) {
+  if (page != nullptr) {
+    version_ = page->GetVersion();
+  }
+}
+
+auto OptimisticPageGuard::Validate() const -> bool {
+  // the reads of the page must be done before the version is read again
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return IsValid() && guard_.page_->GetVersion() == version_;
+}
+
+auto OptimisticPageGuard::CopyData(char *data) const -> bool {
+  if (!IsValid()) {
+    return false;
+  }
+  memcpy(data, guard_.page_->GetData(), BUSTUB_PAGE_SIZE);
+  return Validate();
+}
+
+auto OptimisticPageGuard::UpgradeRead() -> std::optional<ReadPageGuard> {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  guard_.page_->RLatch();
+  if (guard_.page_->GetVersion() != version_) {
+    guard_.page_->RUnlatch();
+    return std::nullopt;
+  }
+  // the pin moves to the read guard
+  ReadPageGuard read_guard(guard_.bpm_, guard_.page_);
+  guard_.page_ = nullptr;
+  return std::make_optional(std::move(read_guard));
+}
+
 }  // namespace bustub
@@ -10,8 +10,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
 #include <mutex>  // NOLINT
+#include <numeric>
 #include <utility>
 
 #include "common/config.h"
@@ -99,6 +101,41 @@ auto TableHeap::GetTuple(RID rid) -> std::pair<TupleMeta, Tuple> {
   return std::make_pair(meta, std::move(tuple));
 }
 
+auto TableHeap::GetTuples(const std::vector<RID> &rids) -> std::vector<std::pair<TupleMeta, Tuple>> {
+  std::vector<size_t> order(rids.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&rids](size_t a, size_t b) {
+    return rids[a].GetPageId() != rids[b].GetPageId() ? rids[a].GetPageId() < rids[b].GetPageId()
+                                                      : rids[a].GetSlotNum() < rids[b].GetSlotNum();
+  });
+
+  // the pages after the first are read in the background while the ones before them are copied from
+  std::vector<page_id_t> page_ids;
+  for (auto i : order) {
+    if (rids[i].GetPageId() != rids[order.front()].GetPageId() &&
+        (page_ids.empty() || page_ids.back() != rids[i].GetPageId())) {
+      page_ids.push_back(rids[i].GetPageId());
+    }
+  }
+  if (!page_ids.empty()) {
+    bpm_->PrefetchPages(page_ids);
+  }
+
+  std::vector<std::pair<TupleMeta, Tuple>> result(rids.size());
+  ReadPageGuard page_guard;
+  page_id_t page_id = INVALID_PAGE_ID;
+  for (auto i : order) {
+    if (rids[i].GetPageId() != page_id) {
+      page_guard.Drop();
+      page_id = rids[i].GetPageId();
+      page_guard = bpm_->FetchPageRead(page_id);
+    }
+    result[i] = page_guard.As<TablePage>()->GetTuple(rids[i]);
+    result[i].second.rid_ = rids[i];
+  }
+  return result;
+}
+
 auto TableHeap::GetTupleMeta(RID rid) -> TupleMeta {
   auto page_guard = bpm_->FetchPageRead(rid.GetPageId());
   auto page = page_guard.As<TablePage>();
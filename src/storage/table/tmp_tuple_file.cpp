@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.cpp
+//
+// Identification: src/storage/table/tmp_tuple_file.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/tmp_tuple_file.h"
+
+#include <cstring>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+TmpTupleFile::TmpTupleFile(TmpFileManager *tmp_files) : tmp_files_(tmp_files) {
+  page_.Init(INVALID_PAGE_ID, BUSTUB_PAGE_SIZE);
+}
+
+TmpTupleFile::~TmpTupleFile() {
+  for (auto page_id : pages_) {
+    tmp_files_->DeallocatePage(page_id);
+  }
+}
+
+void TmpTupleFile::Append(const Tuple &tuple) {
+  BUSTUB_ASSERT(writing_, "append to a file that is being read");
+  TmpTuple location(INVALID_PAGE_ID, 0);
+  if (!page_.Insert(tuple, &location)) {
+    Flush();
+    if (!page_.Insert(tuple, &location)) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "Tuple does not fit in a temporary page.");
+    }
+  }
+  tuple_count_++;
+}
+
+void TmpTupleFile::Flush() {
+  if (page_.GetFreeSpacePointer() == BUSTUB_PAGE_SIZE) {
+    return;
+  }
+  page_id_t page_id = tmp_files_->AllocatePage();
+  memcpy(page_.GetData(), &page_id, sizeof(page_id_t));
+  tmp_files_->WritePage(page_id, page_.GetData());
+  pages_.push_back(page_id);
+  page_.Init(INVALID_PAGE_ID, BUSTUB_PAGE_SIZE);
+}
+
+void TmpTupleFile::Rewind() {
+  if (writing_) {
+    Flush();
+    writing_ = false;
+  }
+  next_page_ = 0;
+  offset_ = BUSTUB_PAGE_SIZE;
+}
+
+auto TmpTupleFile::Next(Tuple *tuple) -> bool {
+  BUSTUB_ASSERT(!writing_, "read a file before rewinding it");
+  while (offset_ == BUSTUB_PAGE_SIZE) {
+    if (next_page_ == pages_.size()) {
+      return false;
+    }
+    tmp_files_->ReadPage(pages_[next_page_++], page_.GetData());
+    offset_ = page_.GetFreeSpacePointer();
+  }
+  offset_ = page_.Get(offset_, tuple);
+  return true;
+}
+
+}  // namespace bustub
@@ -17,6 +17,7 @@
 #include <string>
 
 #include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
 
 namespace bustub {
 
@@ -144,4 +145,54 @@ TEST(BufferPoolManagerTest, SampleTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, PrefetchTest) {
+  const size_t buffer_pool_size = 40;
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get());
+
+  // pages written out and evicted by as many newer ones as the pool holds
+  std::vector<page_id_t> page_ids(20);
+  for (auto &page_id : page_ids) {
+    Page *page = bpm->NewPage(&page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+    bpm->UnpinPage(page_id, true);
+  }
+  std::vector<page_id_t> newer_page_ids(buffer_pool_size);
+  for (auto &page_id : newer_page_ids) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+    bpm->UnpinPage(page_id, false);
+  }
+
+  // a quarter of the pool is prefetched, and the other pages are read as usual, whether their prefetches were queued
+  // or not, the reads in flight waited for and the queued ones taken over
+  disk_manager->SetLatency(2);
+  bpm->PrefetchPages(page_ids);
+  bpm->PrefetchPages(page_ids);
+  for (auto page_id : page_ids) {
+    Page *page = bpm->FetchPage(page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ("page " + std::to_string(page_id), std::string(page->GetData()));
+    EXPECT_EQ(1, page->GetPinCount());
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+
+  // with every frame pinned, a prefetched page has nowhere to go and is fetched once a frame is free
+  disk_manager->SetLatency(0);
+  for (auto page_id : newer_page_ids) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_id));
+  }
+  bpm->PrefetchPages({page_ids[0], page_ids[1]});
+  EXPECT_EQ(nullptr, bpm->FetchPage(page_ids[0]));
+  EXPECT_TRUE(bpm->UnpinPage(newer_page_ids[0], false));
+  Page *page = bpm->FetchPage(page_ids[0]);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ("page " + std::to_string(page_ids[0]), std::string(page->GetData()));
+  EXPECT_TRUE(bpm->UnpinPage(page_ids[0], false));
+  for (size_t i = 1; i < newer_page_ids.size(); i++) {
+    EXPECT_TRUE(bpm->UnpinPage(newer_page_ids[i], false));
+  }
+}
+
 }  // namespace bustub
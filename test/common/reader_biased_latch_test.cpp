@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// reader_biased_latch_test.cpp
+//
+// Identification: test/common/reader_biased_latch_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/reader_biased_latch.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ReaderBiasedLatchTest, WritersExcludeReaders) {
+  // fewer stripes than threads, so that readers share indicators as well
+  ReaderBiasedLatch<2> latch;
+  int first = 0;
+  int second = 0;
+  std::atomic<int> torn_reads{0};
+
+  std::vector<std::thread> threads;
+  for (int tid = 0; tid < 8; tid++) {
+    threads.emplace_back([&, tid] {
+      for (int round = 0; round < 2000; round++) {
+        if (tid % 4 == 0) {
+          latch.WLock();
+          first++;
+          std::this_thread::yield();
+          second++;
+          latch.WUnlock();
+        } else {
+          latch.RLock();
+          if (first != second) {
+            torn_reads++;
+          }
+          latch.RUnlock();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(torn_reads.load(), 0);
+  EXPECT_EQ(first, 4000);
+  EXPECT_EQ(second, 4000);
+}
+
+// NOLINTNEXTLINE
+TEST(ReaderBiasedLatchTest, ReadersShareTheLatch) {
+  ReaderBiasedLatch<> latch;
+  std::atomic<int> holding{0};
+  std::atomic<bool> all_held{false};
+
+  std::vector<std::thread> threads;
+  for (int tid = 0; tid < 4; tid++) {
+    threads.emplace_back([&] {
+      latch.RLock();
+      holding++;
+      // every reader waits for the others while holding the latch, which only works if none of them blocks
+      while (holding.load() < 4) {
+        std::this_thread::yield();
+      }
+      all_held = true;
+      latch.RUnlock();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(all_held.load());
+
+  latch.WLock();
+  latch.WUnlock();
+}
+
+}  // namespace bustub
@@ -43,6 +43,83 @@ void Test1(IsolationLevel lvl) {
   Commit(*db, txn2);
 }
 
+void ScanIndexOnly(Transaction *txn, BustubInstance &instance, const std::vector<int> &v1) {
+  std::stringstream ss;
+  auto writer = bustub::SimpleStreamWriter(ss, true, ",");
+  instance.ExecuteSqlTxn("SELECT v2, v1 FROM t1", writer, txn);
+  std::string expected_result;
+  for (auto v : v1) {
+    for (size_t i = 1; i <= 3; i++) {
+      expected_result += fmt::format("{},{},\n", i, v);
+    }
+  }
+  ASSERT_TRUE(ExpectResult(ss.str(), expected_result));
+}
+
+void AbortIndexOnlyTest1() {
+  // index-only scans read no tuple meta, so an abort has to revert the index entries of the txn as well
+  auto db = GetDbForCommitAbortTest("AbortIndexOnlyTest1");
+  auto writer = bustub::SimpleStreamWriter(std::cout, true);
+  db->ExecuteSql("CREATE INDEX t1v1 ON t1(v1) WITH (include = 'v2');", writer);
+  std::stringstream plan;
+  auto plan_writer = bustub::SimpleStreamWriter(plan, true);
+  db->ExecuteSql("EXPLAIN (o) SELECT v2, v1 FROM t1", plan_writer);
+  ASSERT_NE(plan.str().find("index_only=true"), std::string::npos) << plan.str();
+
+  auto txn1 = Begin(*db, IsolationLevel::READ_UNCOMMITTED);
+  Insert(txn1, *db, 1);
+  Delete(txn1, *db, 233);
+  ScanIndexOnly(txn1, *db, {1, 234});
+  Abort(*db, txn1);
+  auto txn2 = Begin(*db, IsolationLevel::READ_UNCOMMITTED);
+  ScanIndexOnly(txn2, *db, {233, 234});
+  Commit(*db, txn2);
+
+  auto txn3 = Begin(*db, IsolationLevel::READ_UNCOMMITTED);
+  db->ExecuteSqlTxn("UPDATE t1 SET v1 = 2 WHERE v1 = 234", writer, txn3);
+  ScanIndexOnly(txn3, *db, {2, 233});
+  Abort(*db, txn3);
+  auto txn4 = Begin(*db, IsolationLevel::READ_UNCOMMITTED);
+  ScanIndexOnly(txn4, *db, {233, 234});
+  Commit(*db, txn4);
+}
+
+// NOLINTNEXTLINE
+TEST(CommitAbortTest, AbortIndexOnlyTestA) { AbortIndexOnlyTest1(); }
+
+void IndexScanLockTest1() {
+  // deletes and updates through an index scan or a bitmap heap scan lock the rows they change, as a seq scan does
+  auto db = std::make_unique<BustubInstance>();
+  auto writer = bustub::SimpleStreamWriter(std::cout, true);
+  db->ExecuteSql("CREATE TABLE t1(v1 int, v2 int);", writer);
+  db->ExecuteSql("INSERT INTO t1 VALUES (1, 1), (2, 2), (3, 3), (4, 4), (5, 5)", writer);
+  db->ExecuteSql("CREATE INDEX t1v1 ON t1(v1);", writer);
+  auto oid = db->catalog_->GetTable("t1")->oid_;
+  for (const auto &[sql, scan] : std::vector<std::pair<std::string, std::string>>{
+           {"DELETE FROM t1 WHERE v1 = 1", "IndexScan"}, {"UPDATE t1 SET v2 = 0 WHERE v1 >= 4", "BitmapHeapScan"}}) {
+    std::stringstream plan;
+    auto plan_writer = bustub::SimpleStreamWriter(plan, true);
+    db->ExecuteSql("EXPLAIN (o) " + sql, plan_writer);
+    ASSERT_NE(plan.str().find(scan), std::string::npos) << plan.str();
+
+    auto txn = Begin(*db, IsolationLevel::REPEATABLE_READ);
+    db->ExecuteSqlTxn(sql, writer, txn);
+    ASSERT_EQ(txn->GetIntentionExclusiveTableLockSet()->count(oid), 1);
+    ASSERT_EQ((*txn->GetExclusiveRowLockSet())[oid].size(), scan == "IndexScan" ? 1 : 2);
+    Commit(*db, txn);
+  }
+  auto txn = Begin(*db, IsolationLevel::REPEATABLE_READ);
+  std::stringstream ss;
+  auto scan_writer = bustub::SimpleStreamWriter(ss, true, ",");
+  db->ExecuteSqlTxn("SELECT * FROM t1 WHERE v1 >= 2", scan_writer, txn);
+  ASSERT_TRUE(ExpectResult(ss.str(), "2,2,\n3,3,\n4,0,\n5,0,\n"));
+  ASSERT_EQ((*txn->GetSharedRowLockSet())[oid].size(), 4);
+  Commit(*db, txn);
+}
+
+// NOLINTNEXTLINE
+TEST(IsolationLevelTest, IndexScanLockTestA) { IndexScanLockTest1(); }
+
 // NOLINTNEXTLINE
 TEST(VisibilityTest, TestA) {
   // only this one will be public :)
@@ -0,0 +1,246 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// adaptive_radix_tree_test.cpp
+//
+// Identification: test/container/art/adaptive_radix_tree_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "container/art/adaptive_radix_tree.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(AdaptiveRadixTreeTest, BasicTest) {
+  AdaptiveRadixTree<uint32_t> tree;
+  EXPECT_FALSE(tree.Get("").has_value());
+
+  // keys that are prefixes of each other, including the empty key
+  for (const auto *key : {"", "a", "ab", "abc", "abd", "b"}) {
+    EXPECT_TRUE(tree.Insert(key, std::string(key).size()));
+  }
+  EXPECT_FALSE(tree.Insert("ab", 100));
+  EXPECT_EQ(6, tree.Size());
+  for (const auto *key : {"", "a", "ab", "abc", "abd", "b"}) {
+    ASSERT_EQ(std::string(key).size(), tree.Get(key)) << key;
+  }
+  EXPECT_FALSE(tree.Get("abcd").has_value());
+  EXPECT_FALSE(tree.Get("c").has_value());
+
+  tree.Put("ab", 100);
+  tree.Put("abe", 3);
+  EXPECT_EQ(100, tree.Get("ab"));
+  EXPECT_EQ(3, tree.Get("abe"));
+  EXPECT_EQ(7, tree.Size());
+
+  EXPECT_TRUE(tree.Remove("ab"));
+  EXPECT_FALSE(tree.Remove("ab"));
+  EXPECT_FALSE(tree.Get("ab").has_value());
+  EXPECT_EQ(3, tree.Get("abc"));
+  EXPECT_TRUE(tree.Remove(""));
+  EXPECT_FALSE(tree.Get("").has_value());
+  EXPECT_EQ(1, tree.Get("a"));
+  EXPECT_EQ(5, tree.Size());
+}
+
+// NOLINTNEXTLINE
+TEST(AdaptiveRadixTreeTest, LongPrefixTest) {
+  // the shared prefixes are longer than a node stores, so they have to be split from the bytes of a leaf
+  AdaptiveRadixTree<std::string> tree;
+  std::string base(40, 'x');
+  std::vector<std::string> keys = {base + "1", base + "2", base.substr(0, 20) + "y", base.substr(0, 30),
+                                   base.substr(0, 5) + "z" + base, base};
+  for (const auto &key : keys) {
+    EXPECT_TRUE(tree.Insert(key, key));
+  }
+  for (const auto &key : keys) {
+    EXPECT_EQ(key, tree.Get(key));
+  }
+  EXPECT_FALSE(tree.Get(base.substr(0, 25)).has_value());
+  EXPECT_FALSE(tree.Get(base + "3").has_value());
+  EXPECT_FALSE(tree.Get(std::string(40, 'w')).has_value());
+
+  // removing keys merges the nodes back, and what is left is still found
+  for (size_t i = 0; i < keys.size(); i++) {
+    EXPECT_TRUE(tree.Remove(keys[i]));
+    for (size_t j = i + 1; j < keys.size(); j++) {
+      EXPECT_EQ(keys[j], tree.Get(keys[j]));
+    }
+  }
+  EXPECT_EQ(0, tree.Size());
+}
+
+// NOLINTNEXTLINE
+TEST(AdaptiveRadixTreeTest, NodeSizesTest) {
+  // one node gets all 256 children one at a time, so it grows through every node size and shrinks back
+  AdaptiveRadixTree<uint64_t> tree;
+  auto key_of = [](int byte) { return std::string("k") + static_cast<char>(byte) + "tail"; };
+  size_t memory_with_four = 0;
+  for (int byte = 0; byte < 256; byte++) {
+    EXPECT_TRUE(tree.Insert(key_of(byte), byte));
+    if (byte == 3) {
+      memory_with_four = tree.MemoryUsage();
+    }
+    for (int other = 0; other <= byte; other++) {
+      ASSERT_EQ(other, tree.Get(key_of(other)));
+    }
+  }
+  EXPECT_GT(tree.MemoryUsage(), memory_with_four);
+  for (int byte = 255; byte >= 0; byte--) {
+    EXPECT_TRUE(tree.Remove(key_of(byte)));
+    for (int other = 0; other < byte; other++) {
+      ASSERT_EQ(other, tree.Get(key_of(other)));
+    }
+    EXPECT_FALSE(tree.Get(key_of(byte)).has_value());
+  }
+  EXPECT_EQ(0, tree.Size());
+}
+
+// NOLINTNEXTLINE
+TEST(AdaptiveRadixTreeTest, RandomAgainstMapTest) {
+  AdaptiveRadixTree<uint64_t> tree;
+  std::map<std::string, uint64_t> expected;
+  std::mt19937 gen(42);
+  // short keys over a small alphabet, so that they share prefixes and often are prefixes of each other
+  std::uniform_int_distribution<int> length_dis(0, 6);
+  std::uniform_int_distribution<int> char_dis('a', 'd');
+  std::uniform_int_distribution<int> op_dis(0, 3);
+  for (uint64_t round = 0; round < 20000; round++) {
+    std::string key(length_dis(gen), ' ');
+    for (auto &c : key) {
+      c = static_cast<char>(char_dis(gen));
+    }
+    switch (op_dis(gen)) {
+      case 0:
+        ASSERT_EQ(expected.emplace(key, round).second, tree.Insert(key, round)) << key;
+        break;
+      case 1:
+        tree.Put(key, round);
+        expected[key] = round;
+        break;
+      case 2:
+        ASSERT_EQ(expected.erase(key) == 1, tree.Remove(key)) << key;
+        break;
+      default: {
+        auto it = expected.find(key);
+        auto value = tree.Get(key);
+        ASSERT_EQ(it != expected.end(), value.has_value()) << key;
+        if (value.has_value()) {
+          ASSERT_EQ(it->second, *value) << key;
+        }
+      }
+    }
+    ASSERT_EQ(expected.size(), tree.Size());
+  }
+  for (const auto &[key, value] : expected) {
+    EXPECT_EQ(value, tree.Get(key));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(AdaptiveRadixTreeTest, ConcurrentTest) {
+  AdaptiveRadixTree<uint64_t> tree;
+  const int num_threads = 4;
+  const uint64_t keys_per_thread = 5000;
+  auto key_of = [](uint64_t key) { return fmt::format("key{:08}", key); };
+
+  // the writers interleave their keys, so that they keep splitting and growing the same nodes
+  std::vector<std::thread> threads;
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&, tid] {
+      for (uint64_t key = tid; key < num_threads * keys_per_thread; key += num_threads) {
+        EXPECT_TRUE(tree.Insert(key_of(key), key));
+        EXPECT_EQ(key, tree.Get(key_of(key)));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(num_threads * keys_per_thread, tree.Size());
+
+  // half of the threads remove their keys while the others overwrite and read theirs
+  threads.clear();
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&, tid] {
+      for (uint64_t key = tid; key < num_threads * keys_per_thread; key += num_threads) {
+        if (tid % 2 == 0) {
+          EXPECT_TRUE(tree.Remove(key_of(key)));
+        } else {
+          tree.Put(key_of(key), key + 1);
+          EXPECT_EQ(key + 1, tree.Get(key_of(key)));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(num_threads * keys_per_thread / 2, tree.Size());
+  for (uint64_t key = 0; key < num_threads * keys_per_thread; key++) {
+    auto value = tree.Get(key_of(key));
+    if (key % 2 == 0) {
+      EXPECT_FALSE(value.has_value()) << key;
+    } else {
+      EXPECT_EQ(key + 1, value) << key;
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(AdaptiveRadixTreeTest, ReclaimUnderLoadTest) {
+  AdaptiveRadixTree<uint64_t> tree;
+  const int num_keys = 100;
+  const int num_overwrites = 20000;
+  auto key_of = [](uint64_t key) { return fmt::format("key{:08}", key); };
+  for (int key = 0; key < num_keys; key++) {
+    tree.Put(key_of(key), key);
+  }
+
+  // the readers keep an operation in flight all the time, so the tree is never left without one
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int tid = 0; tid < 2; tid++) {
+    readers.emplace_back([&, tid] {
+      for (uint64_t i = tid; !stop.load(); i++) {
+        EXPECT_TRUE(tree.Get(key_of(i % num_keys)).has_value());
+      }
+    });
+  }
+  // every overwrite retires a leaf
+  std::vector<std::thread> writers;
+  for (int tid = 0; tid < 2; tid++) {
+    writers.emplace_back([&, tid] {
+      for (int i = 0; i < num_overwrites; i++) {
+        tree.Put(key_of((i + tid) % num_keys), i);
+      }
+    });
+  }
+  for (auto &thread : writers) {
+    thread.join();
+  }
+  for (int i = 0; i < 10; i++) {
+    tree.Put(key_of(0), i);
+  }
+  // only what was retired in the last epochs is still waiting to be freed
+  EXPECT_LT(tree.NumRetired(), 1000);
+  stop = true;
+  for (auto &thread : readers) {
+    thread.join();
+  }
+  EXPECT_EQ(num_keys, tree.Size());
+}
+
+}  // namespace bustub
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <thread>  // NOLINT
 #include <vector>
 
@@ -22,9 +23,7 @@
 namespace bustub {
 
 // NOLINTNEXTLINE
-
-// NOLINTNEXTLINE
-TEST(HashTableTest, DISABLED_SampleTest) {
+TEST(HashTableTest, SampleTest) {
   auto *disk_manager = new DiskManager("test.db");
   auto *bpm = new BufferPoolManager(50, disk_manager);
   DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
@@ -117,4 +116,244 @@ TEST(HashTableTest, DISABLED_SampleTest) {
   delete bpm;
 }
 
+// NOLINTNEXTLINE
+TEST(HashTableTest, GrowShrinkTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // far more pairs than a bucket holds, so that the directory has to grow, and with buckets evicted from the pool
+  const int num_keys = 10000;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i)) << "Failed to insert " << i << std::endl;
+  }
+  ht.VerifyIntegrity();
+  EXPECT_GT(ht.GetGlobalDepth(), 0);
+
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(1, res.size()) << "Failed to keep " << i << std::endl;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  // emptied buckets merge back into their split images until the directory is a single slot again
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i)) << "Failed to remove " << i << std::endl;
+  }
+  ht.VerifyIntegrity();
+  EXPECT_EQ(0, ht.GetGlobalDepth());
+  for (int i = 0; i < num_keys; i += 97) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(0, res.size());
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, SplitOutOfMemoryTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  // the directory, a bucket and one more frame, which is held below so that the bucket has nowhere to split into
+  auto *bpm = new BufferPoolManager(3, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+  page_id_t held_page_id;
+  ASSERT_NE(nullptr, bpm->NewPage(&held_page_id));
+
+  int num_keys = 0;
+  bool out_of_memory = false;
+  while (!out_of_memory) {
+    try {
+      EXPECT_TRUE(ht.Insert(nullptr, num_keys, num_keys));
+      num_keys++;
+    } catch (const Exception &e) {
+      EXPECT_EQ(ExceptionType::OUT_OF_MEMORY, e.GetType());
+      out_of_memory = true;
+    }
+  }
+  // the failed split gave back the table latch and its pins, so the table is still usable
+  ht.VerifyIntegrity();
+  EXPECT_EQ(0, ht.GetGlobalDepth());
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(1, res.size()) << "Failed to keep " << i << std::endl;
+  }
+
+  ASSERT_TRUE(bpm->UnpinPage(held_page_id, false));
+  EXPECT_TRUE(ht.Insert(nullptr, num_keys, num_keys));
+  ht.VerifyIntegrity();
+  EXPECT_GT(ht.GetGlobalDepth(), 0);
+  for (int i = 0; i <= num_keys; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(1, res.size()) << "Failed to keep " << i << std::endl;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, FetchOutOfMemoryTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(3, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+  EXPECT_TRUE(ht.Insert(nullptr, 1, 1));
+
+  // every frame is held, so neither the directory nor the bucket can be brought back in
+  std::vector<page_id_t> held_page_ids(3);
+  for (auto &page_id : held_page_ids) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+  }
+  std::vector<int> res;
+  EXPECT_THROW(ht.GetValue(nullptr, 1, &res), Exception);
+  EXPECT_THROW(ht.Insert(nullptr, 2, 2), Exception);
+  EXPECT_THROW(ht.Remove(nullptr, 1, 1), Exception);
+
+  // the directory comes back but the bucket does not
+  ASSERT_TRUE(bpm->UnpinPage(held_page_ids[0], false));
+  EXPECT_THROW(ht.GetValue(nullptr, 1, &res), Exception);
+  EXPECT_THROW(ht.Insert(nullptr, 2, 2), Exception);
+  EXPECT_THROW(ht.Remove(nullptr, 1, 1), Exception);
+
+  // the latch and the pins were given back each time
+  ASSERT_TRUE(bpm->UnpinPage(held_page_ids[1], false));
+  EXPECT_TRUE(ht.Insert(nullptr, 2, 2));
+  ht.GetValue(nullptr, 1, &res);
+  EXPECT_EQ(1, res.size());
+  EXPECT_TRUE(ht.Remove(nullptr, 1, 1));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, OverflowTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // the pairs of one key all have the same hash, so the bucket splits until the directory is full and then goes on in
+  // overflow pages
+  const int num_values = 2000;
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, 0, i)) << "Failed to insert " << i << std::endl;
+  }
+  ht.VerifyIntegrity();
+  EXPECT_EQ(9, ht.GetGlobalDepth());
+  for (int i = 0; i < num_values; i += 199) {
+    EXPECT_FALSE(ht.Insert(nullptr, 0, i)) << "Inserted " << i << " twice" << std::endl;
+  }
+  for (int key = 1; key <= 100; key++) {
+    EXPECT_TRUE(ht.Insert(nullptr, key, key));
+  }
+  std::vector<int> res;
+  ht.GetValue(nullptr, 0, &res);
+  ASSERT_EQ(num_values, res.size());
+  std::sort(res.begin(), res.end());
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_EQ(i, res[i]);
+  }
+
+  // removing from the first page of the bucket and from the overflow pages alike
+  for (int i = num_values - 1; i >= 0; i -= 2) {
+    EXPECT_TRUE(ht.Remove(nullptr, 0, i)) << "Failed to remove " << i << std::endl;
+  }
+  EXPECT_FALSE(ht.Remove(nullptr, 0, num_values - 1));
+  res.clear();
+  ht.GetValue(nullptr, 0, &res);
+  EXPECT_EQ(num_values / 2, res.size());
+  // the freed slots are taken again before a new overflow page is
+  for (int i = num_values - 1; i >= 0; i -= 2) {
+    EXPECT_TRUE(ht.Insert(nullptr, 0, i)) << "Failed to insert " << i << std::endl;
+  }
+  res.clear();
+  ht.GetValue(nullptr, 0, &res);
+  EXPECT_EQ(num_values, res.size());
+
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, 0, i)) << "Failed to remove " << i << std::endl;
+  }
+  for (int key = 1; key <= 100; key++) {
+    res.clear();
+    ht.GetValue(nullptr, key, &res);
+    ASSERT_EQ(1, res.size());
+    EXPECT_TRUE(ht.Remove(nullptr, key, key));
+  }
+  ht.VerifyIntegrity();
+  res.clear();
+  ht.GetValue(nullptr, 0, &res);
+  EXPECT_EQ(0, res.size());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, ConcurrentInsertRemoveTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  const int num_threads = 4;
+  const int keys_per_thread = 2000;
+  std::vector<std::thread> threads;
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&ht, tid] {
+      for (int i = tid; i < num_threads * keys_per_thread; i += num_threads) {
+        EXPECT_TRUE(ht.Insert(nullptr, i, i));
+        std::vector<int> res;
+        ht.GetValue(nullptr, i, &res);
+        EXPECT_EQ(1, res.size());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ht.VerifyIntegrity();
+
+  // half of the threads remove their keys while the others read theirs
+  threads.clear();
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&ht, tid] {
+      for (int i = tid; i < num_threads * keys_per_thread; i += num_threads) {
+        if (tid % 2 == 0) {
+          EXPECT_TRUE(ht.Remove(nullptr, i, i));
+        } else {
+          std::vector<int> res;
+          ht.GetValue(nullptr, i, &res);
+          EXPECT_EQ(1, res.size());
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ht.VerifyIntegrity();
+
+  for (int i = 0; i < num_threads * keys_per_thread; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(i % 2 == 0 ? 0 : 1, res.size()) << "Wrong entries for " << i << std::endl;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
 }  // namespace bustub
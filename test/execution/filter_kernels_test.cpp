@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// filter_kernels_test.cpp
+//
+// Identification: test/execution/filter_kernels_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "execution/filter_kernels.h"
+#include "gtest/gtest.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+const std::vector<ComparisonType> COMPARISON_TYPES = {
+    ComparisonType::Equal,           ComparisonType::NotEqual,    ComparisonType::LessThan,
+    ComparisonType::LessThanOrEqual, ComparisonType::GreaterThan, ComparisonType::GreaterThanOrEqual,
+};
+
+// lengths that are not multiples of any vector width, so that the tails run too
+const std::vector<size_t> LENGTHS = {0, 1, 7, 8, 9, 31, 32, 33, 100, 1000};
+
+/** @return the kernel tables that this CPU can run, other than the scalar one */
+auto SimdKernels() -> std::vector<const FilterKernels *> {
+  std::vector<const FilterKernels *> kernels;
+  for (const auto *table : {GetSse42FilterKernels(), GetAvx2FilterKernels()}) {
+    if (table != nullptr) {
+      kernels.push_back(table);
+    }
+  }
+  return kernels;
+}
+
+/** Draw from a small domain so that there are plenty of equal values, with about one NULL in eight. */
+template <typename T>
+auto RandomColumn(std::mt19937 *gen, size_t count, T null) -> std::vector<T> {
+  std::uniform_int_distribution<int> dist(-4, 4);
+  std::vector<T> column(count);
+  for (auto &value : column) {
+    value = (*gen)() % 8 == 0 ? null : static_cast<T>(dist(*gen));
+  }
+  return column;
+}
+
+auto RandomBooleans(std::mt19937 *gen, size_t count) -> std::vector<int8_t> {
+  std::vector<int8_t> column(count);
+  for (auto &value : column) {
+    auto draw = (*gen)() % 3;
+    value = draw == 2 ? BUSTUB_BOOLEAN_NULL : static_cast<int8_t>(draw);
+  }
+  return column;
+}
+
+}  // namespace
+
+TEST(FilterKernelsTest, PicksAvailableKernels) {
+  const auto &kernels = GetFilterKernels();
+  if (GetAvx2FilterKernels() != nullptr) {
+    EXPECT_EQ(&kernels, GetAvx2FilterKernels());
+  } else if (GetSse42FilterKernels() != nullptr) {
+    EXPECT_EQ(&kernels, GetSse42FilterKernels());
+  } else {
+    EXPECT_EQ(&kernels, GetScalarFilterKernels());
+  }
+}
+
+TEST(FilterKernelsTest, ScalarCompare) {
+  std::vector<int32_t> lhs{1, 2, 3, BUSTUB_INT32_NULL, 5};
+  std::vector<int32_t> rhs{2, 2, 2, 2, BUSTUB_INT32_NULL};
+  std::vector<int8_t> out(lhs.size());
+  GetScalarFilterKernels()->compare_int32_(ComparisonType::LessThanOrEqual, lhs.data(), rhs.data(), out.data(),
+                                           lhs.size());
+  EXPECT_EQ(out, (std::vector<int8_t>{1, 1, 0, BUSTUB_BOOLEAN_NULL, BUSTUB_BOOLEAN_NULL}));
+
+  std::vector<uint32_t> positions(out.size());
+  ASSERT_EQ(GetScalarFilterKernels()->select_true_(out.data(), out.size(), positions.data()), 2);
+  EXPECT_EQ(positions[0], 0);
+  EXPECT_EQ(positions[1], 1);
+}
+
+TEST(FilterKernelsTest, SimdMatchesScalar) {
+  const auto *scalar = GetScalarFilterKernels();
+  std::mt19937 gen(2023);
+  for (const auto *kernels : SimdKernels()) {
+    SCOPED_TRACE(kernels->isa_);
+    for (auto count : LENGTHS) {
+      SCOPED_TRACE(count);
+      std::vector<int8_t> expected(count);
+      std::vector<int8_t> actual(count);
+
+      auto lhs32 = RandomColumn<int32_t>(&gen, count, BUSTUB_INT32_NULL);
+      auto rhs32 = RandomColumn<int32_t>(&gen, count, BUSTUB_INT32_NULL);
+      auto lhs64 = RandomColumn<int64_t>(&gen, count, BUSTUB_INT64_NULL);
+      auto rhs64 = RandomColumn<int64_t>(&gen, count, BUSTUB_INT64_NULL);
+      for (auto op : COMPARISON_TYPES) {
+        scalar->compare_int32_(op, lhs32.data(), rhs32.data(), expected.data(), count);
+        kernels->compare_int32_(op, lhs32.data(), rhs32.data(), actual.data(), count);
+        EXPECT_EQ(expected, actual);
+        scalar->compare_int64_(op, lhs64.data(), rhs64.data(), expected.data(), count);
+        kernels->compare_int64_(op, lhs64.data(), rhs64.data(), actual.data(), count);
+        EXPECT_EQ(expected, actual);
+      }
+
+      auto lhs = RandomBooleans(&gen, count);
+      auto rhs = RandomBooleans(&gen, count);
+      scalar->and_(lhs.data(), rhs.data(), expected.data(), count);
+      kernels->and_(lhs.data(), rhs.data(), actual.data(), count);
+      EXPECT_EQ(expected, actual);
+      scalar->or_(lhs.data(), rhs.data(), expected.data(), count);
+      kernels->or_(lhs.data(), rhs.data(), actual.data(), count);
+      EXPECT_EQ(expected, actual);
+
+      std::vector<uint32_t> expected_positions(count);
+      std::vector<uint32_t> actual_positions(count);
+      auto selected = scalar->select_true_(lhs.data(), count, expected_positions.data());
+      ASSERT_EQ(selected, kernels->select_true_(lhs.data(), count, actual_positions.data()));
+      expected_positions.resize(selected);
+      actual_positions.resize(selected);
+      EXPECT_EQ(expected_positions, actual_positions);
+    }
+  }
+}
+
+}  // namespace bustub
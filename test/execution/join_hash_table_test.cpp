@@ -0,0 +1,220 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table_test.cpp
+//
+// Identification: test/execution/join_hash_table_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "execution/join_hash_table.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the build rows at the offsets from `entry` on, as the values of their columns */
+auto Matches(const JoinHashTable &table, uint64_t entry, const Schema *schema) -> std::vector<std::vector<Value>> {
+  std::vector<std::vector<Value>> rows;
+  DataChunk chunk;
+  for (; entry != JoinHashTable::NONE; entry = table.Next(entry)) {
+    chunk.Reset(schema);
+    size_t row = chunk.AppendRow(RID{});
+    table.CopyRow(entry, &chunk, row, 0);
+    std::vector<Value> values;
+    for (size_t c = 0; c < schema->GetColumnCount(); c++) {
+      values.push_back(chunk.GetValue(c, row));
+    }
+    rows.push_back(values);
+  }
+  return rows;
+}
+
+}  // namespace
+
+TEST(JoinHashTableTest, FindsRowsOfKeyInOrder) {
+  Schema schema({Column{"k", TypeId::INTEGER}, Column{"s", TypeId::VARCHAR, 16}, Column{"d", TypeId::DECIMAL}});
+  JoinHashTable table(schema, {TypeId::INTEGER}, {TypeId::BIGINT});
+
+  DataChunk build;
+  build.Reset(&schema);
+  auto append = [&](const Value &key, const Value &s, double d) {
+    size_t row = build.AppendRow(RID{});
+    build.GetColumn(0).SetValue(row, key);
+    build.GetColumn(1).SetValue(row, s);
+    build.GetColumn(2).SetValue(row, ValueFactory::GetDecimalValue(d));
+  };
+  append(ValueFactory::GetIntegerValue(1), ValueFactory::GetVarcharValue("a"), 1.5);
+  append(ValueFactory::GetIntegerValue(2), ValueFactory::GetVarcharValue("b"), 2.5);
+  append(ValueFactory::GetNullValueByType(TypeId::INTEGER), ValueFactory::GetVarcharValue("null"), 0);
+  append(ValueFactory::GetIntegerValue(1), ValueFactory::GetNullValueByType(TypeId::VARCHAR), 3.5);
+  append(ValueFactory::GetIntegerValue(1), ValueFactory::GetVarcharValue(""), -1);
+  table.Append(build, {&build.GetColumn(0)});
+  table.Build();
+  ASSERT_EQ(table.GetRowCount(), 4);
+
+  Schema probe_schema({Column{"k", TypeId::BIGINT}});
+  DataChunk probe;
+  probe.Reset(&probe_schema);
+  for (const auto &key : {ValueFactory::GetBigIntValue(1), ValueFactory::GetBigIntValue(2),
+                          ValueFactory::GetBigIntValue(3), ValueFactory::GetNullValueByType(TypeId::BIGINT)}) {
+    probe.GetColumn(0).SetValue(probe.AppendRow(RID{}), key);
+  }
+  std::vector<const ColumnVector *> keys{&probe.GetColumn(0)};
+
+  auto ones = Matches(table, table.Find(table.Hash(keys, 0), keys, 0), &schema);
+  ASSERT_EQ(ones.size(), 3);
+  EXPECT_EQ(ones[0][1].ToString(), "a");
+  EXPECT_EQ(ones[0][2].GetAs<double>(), 1.5);
+  EXPECT_TRUE(ones[1][1].IsNull());
+  EXPECT_EQ(ones[1][2].GetAs<double>(), 3.5);
+  EXPECT_EQ(ones[2][1].ToString(), "");
+  EXPECT_EQ(ones[2][0].GetAs<int32_t>(), 1);
+
+  auto twos = Matches(table, table.Find(table.Hash(keys, 1), keys, 1), &schema);
+  ASSERT_EQ(twos.size(), 1);
+  EXPECT_EQ(twos[0][1].ToString(), "b");
+
+  EXPECT_EQ(table.Find(table.Hash(keys, 2), keys, 2), JoinHashTable::NONE);
+  EXPECT_EQ(table.Find(table.Hash(keys, 3), keys, 3), JoinHashTable::NONE);
+}
+
+TEST(JoinHashTableTest, ManyKeys) {
+  const int key_count = 5000;
+  const int copies = 3;
+  Schema schema({Column{"k", TypeId::VARCHAR, 16}, Column{"v", TypeId::INTEGER}});
+  JoinHashTable table(schema, {TypeId::VARCHAR, TypeId::INTEGER}, {TypeId::VARCHAR, TypeId::INTEGER});
+
+  DataChunk chunk;
+  for (int i = 0; i < key_count * copies;) {
+    chunk.Reset(&schema);
+    for (; i < key_count * copies && !chunk.IsFull(); i++) {
+      size_t row = chunk.AppendRow(RID{});
+      chunk.GetColumn(0).SetValue(row, ValueFactory::GetVarcharValue(std::to_string(i % key_count)));
+      chunk.GetColumn(1).SetValue(row, ValueFactory::GetIntegerValue(i % key_count % 7));
+    }
+    table.Append(chunk, {&chunk.GetColumn(0), &chunk.GetColumn(1)});
+  }
+  table.Build();
+  ASSERT_EQ(table.GetRowCount(), key_count * copies);
+
+  for (int i = 0; i < key_count * 2;) {
+    chunk.Reset(&schema);
+    for (; i < key_count * 2 && !chunk.IsFull(); i++) {
+      size_t row = chunk.AppendRow(RID{});
+      chunk.GetColumn(0).SetValue(row, ValueFactory::GetVarcharValue(std::to_string(i)));
+      chunk.GetColumn(1).SetValue(row, ValueFactory::GetIntegerValue(i % 7));
+    }
+    std::vector<const ColumnVector *> keys{&chunk.GetColumn(0), &chunk.GetColumn(1)};
+    for (size_t row = 0; row < chunk.Size(); row++) {
+      auto matches = Matches(table, table.Find(table.Hash(keys, row), keys, row), &schema);
+      int key = std::stoi(chunk.GetColumn(0).GetString(row));
+      ASSERT_EQ(matches.size(), key < key_count ? copies : 0) << key;
+      for (const auto &match : matches) {
+        EXPECT_EQ(match[0].ToString(), std::to_string(key));
+      }
+    }
+  }
+}
+
+TEST(JoinHashTableTest, FindBatchMatchesFind) {
+  const int key_count = 1000;
+  Schema build_schema({Column{"k", TypeId::INTEGER}, Column{"v", TypeId::INTEGER}});
+  Schema probe_schema({Column{"k", TypeId::BIGINT}});
+  JoinHashTable table(build_schema, {TypeId::INTEGER}, {TypeId::BIGINT});
+
+  DataChunk chunk;
+  chunk.Reset(&build_schema);
+  for (int i = 0; i < key_count; i++) {
+    size_t row = chunk.AppendRow(RID{});
+    chunk.GetColumn(0).SetValue(row, ValueFactory::GetIntegerValue(i % (key_count / 2)));
+    chunk.GetColumn(1).SetValue(row, ValueFactory::GetIntegerValue(i));
+  }
+  table.Append(chunk, {&chunk.GetColumn(0)});
+  table.Build();
+
+  // probe with hits, misses and NULLs, through a selection that skips every third row
+  chunk.Reset(&probe_schema);
+  std::vector<uint32_t> positions;
+  for (int i = 0; i < key_count; i++) {
+    auto key = i % 10 == 0 ? ValueFactory::GetNullValueByType(TypeId::BIGINT) : ValueFactory::GetBigIntValue(i);
+    chunk.GetColumn(0).SetValue(chunk.AppendRow(RID{}), key);
+    if (i % 3 != 0) {
+      positions.push_back(i);
+    }
+  }
+  chunk.Select(positions);
+  std::vector<const ColumnVector *> keys{&chunk.GetColumn(0)};
+  std::vector<uint64_t> matches;
+  table.FindBatch(chunk, keys, &matches);
+  ASSERT_EQ(matches.size(), chunk.Size());
+  for (size_t i = 0; i < chunk.Size(); i++) {
+    size_t row = chunk.RowAt(i);
+    EXPECT_EQ(matches[i], table.Find(table.Hash(keys, row), keys, row)) << row;
+    EXPECT_EQ(matches[i] != JoinHashTable::NONE, row % 10 != 0 && row < key_count / 2) << row;
+  }
+}
+
+TEST(JoinHashTableTest, PartitionedProbe) {
+  const int key_count = 3000;
+  Schema build_schema({Column{"k", TypeId::INTEGER}, Column{"v", TypeId::VARCHAR, 16}});
+  Schema probe_schema({Column{"k", TypeId::BIGINT}});
+  JoinHashTable table(build_schema, {TypeId::INTEGER}, {TypeId::BIGINT});
+  JoinHashTable probe(probe_schema, {TypeId::BIGINT}, {TypeId::INTEGER}, true);
+
+  DataChunk chunk;
+  for (int i = 0; i < key_count * 2;) {
+    chunk.Reset(&build_schema);
+    for (; i < key_count * 2 && !chunk.IsFull(); i++) {
+      size_t row = chunk.AppendRow(RID{});
+      chunk.GetColumn(0).SetValue(row, ValueFactory::GetIntegerValue(i % key_count));
+      chunk.GetColumn(1).SetValue(row, ValueFactory::GetVarcharValue(std::to_string(i)));
+    }
+    table.Append(chunk, {&chunk.GetColumn(0)});
+  }
+  table.Build(4);
+  ASSERT_EQ(table.GetPartitionCount(), 16);
+
+  chunk.Reset(&probe_schema);
+  for (int i = -1; i < key_count + 10; i++) {
+    auto key = i < 0 ? ValueFactory::GetNullValueByType(TypeId::BIGINT) : ValueFactory::GetBigIntValue(i);
+    chunk.GetColumn(0).SetValue(chunk.AppendRow(RID{}), key);
+    if (chunk.IsFull()) {
+      probe.Append(chunk, {&chunk.GetColumn(0)});
+      chunk.Reset(&probe_schema);
+    }
+  }
+  probe.Append(chunk, {&chunk.GetColumn(0)});
+  probe.Partition(table.GetPartitionBits());
+  ASSERT_EQ(probe.GetRowCount(), key_count + 11);
+
+  // every probe row is in one partition, and finds the build rows of its key in the order they were appended
+  size_t probed = 0;
+  for (size_t p = 0; p < probe.GetPartitionCount(); p++) {
+    for (uint64_t entry = probe.GetPartitionBegin(p); entry < probe.GetPartitionEnd(p); entry = probe.RowAfter(entry)) {
+      probed++;
+      DataChunk row;
+      row.Reset(&probe_schema);
+      probe.CopyRow(entry, &row, row.AppendRow(RID{}), 0);
+      auto key = row.GetValue(0, 0);
+      auto matches = Matches(table, table.Find(probe, entry), &build_schema);
+      if (key.IsNull() || key.GetAs<int64_t>() >= key_count) {
+        EXPECT_TRUE(matches.empty());
+        continue;
+      }
+      ASSERT_EQ(matches.size(), 2);
+      EXPECT_EQ(matches[0][1].ToString(), std::to_string(key.GetAs<int64_t>()));
+      EXPECT_EQ(matches[1][1].ToString(), std::to_string(key.GetAs<int64_t>() + key_count));
+    }
+  }
+  EXPECT_EQ(probed, key_count + 11);
+}
+
+}  // namespace bustub
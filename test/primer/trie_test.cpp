@@ -250,4 +250,32 @@ TEST(TrieTest, PointerStability) {
   ASSERT_EQ(reinterpret_cast<uint64_t>(ptr_before), reinterpret_cast<uint64_t>(ptr_after));
 }
 
+TEST(TrieTest, PathCompressionTest) {
+  auto trie = Trie();
+  std::string prefix(1000, 'x');
+  trie = trie.Put<uint32_t>(prefix + "a", 1);
+  // one node for the whole key
+  size_t one_key = trie.MemoryUsage();
+  ASSERT_LT(one_key, 2 * prefix.size());
+  trie = trie.Put<uint32_t>(prefix + "b", 2);
+  trie = trie.Put<uint32_t>(prefix, 3);
+  trie = trie.Put<uint32_t>(prefix.substr(0, 500), 4);
+  // the shared prefix is stored once
+  ASSERT_LT(trie.MemoryUsage(), 2 * one_key);
+  ASSERT_EQ(*trie.Get<uint32_t>(prefix + "a"), 1);
+  ASSERT_EQ(*trie.Get<uint32_t>(prefix + "b"), 2);
+  ASSERT_EQ(*trie.Get<uint32_t>(prefix), 3);
+  ASSERT_EQ(*trie.Get<uint32_t>(prefix.substr(0, 500)), 4);
+  ASSERT_EQ(trie.Get<uint32_t>(prefix.substr(0, 501)), nullptr);
+  ASSERT_EQ(trie.Get<uint32_t>(prefix + "c"), nullptr);
+
+  auto removed = trie.Remove(prefix + "a").Remove(prefix).Remove(prefix.substr(0, 500));
+  // the nodes left without a value are merged back into one
+  ASSERT_EQ(removed.MemoryUsage(), one_key);
+  ASSERT_EQ(*removed.Get<uint32_t>(prefix + "b"), 2);
+  ASSERT_EQ(removed.Remove(prefix + "b").MemoryUsage(), 0);
+  // the old version is untouched
+  ASSERT_EQ(*trie.Get<uint32_t>(prefix + "a"), 1);
+}
+
 }  // namespace bustub
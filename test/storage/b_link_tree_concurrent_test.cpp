@@ -0,0 +1,214 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_link_tree_concurrent_test.cpp
+//
+// Identification: test/storage/b_link_tree_concurrent_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <thread>  // NOLINT
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_link_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using bustub::DiskManagerUnlimitedMemory;
+using BLinkTreeForTest = BLinkTree<GenericKey<8>, RID, GenericComparator<8>>;
+
+// helper function to launch multiple threads
+template <typename... Args>
+void LaunchParallelTest(uint64_t num_threads, Args &&...args) {
+  std::vector<std::thread> thread_group;
+
+  // Launch a group of threads
+  for (uint64_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group.push_back(std::thread(args..., thread_itr));
+  }
+
+  // Join the threads with the main thread
+  for (uint64_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group[thread_itr].join();
+  }
+}
+
+// helper function to insert the keys that belong to this thread
+void InsertHelperSplit(BLinkTreeForTest *tree, const std::vector<int64_t> &keys, int total_threads,
+                       __attribute__((unused)) uint64_t thread_itr) {
+  GenericKey<8> index_key;
+  RID rid;
+  for (auto key : keys) {
+    if (static_cast<uint64_t>(key) % total_threads == thread_itr) {
+      int64_t value = key & 0xFFFFFFFF;
+      rid.Set(static_cast<int32_t>(key >> 32), value);
+      index_key.SetFromInteger(key);
+      tree->Insert(index_key, rid);
+    }
+  }
+}
+
+// helper function to delete the keys that belong to this thread
+void DeleteHelperSplit(BLinkTreeForTest *tree, const std::vector<int64_t> &remove_keys, int total_threads,
+                       __attribute__((unused)) uint64_t thread_itr) {
+  GenericKey<8> index_key;
+  for (auto key : remove_keys) {
+    if (static_cast<uint64_t>(key) % total_threads == thread_itr) {
+      index_key.SetFromInteger(key);
+      tree->Remove(index_key);
+    }
+  }
+}
+
+void CheckKeys(BLinkTreeForTest *tree, const std::vector<int64_t> &present, const std::vector<int64_t> &absent) {
+  GenericKey<8> index_key;
+  std::vector<RID> rids;
+  for (auto key : present) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    ASSERT_TRUE(tree->GetValue(index_key, &rids));
+    ASSERT_EQ(rids.size(), 1U);
+    ASSERT_EQ(rids[0].GetSlotNum(), key & 0xFFFFFFFF);
+  }
+  for (auto key : absent) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    ASSERT_FALSE(tree->GetValue(index_key, &rids));
+  }
+}
+
+TEST(BLinkTreeConcurrentTest, InsertTest1) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  // create b-link tree with the default node sizes
+  BLinkTreeForTest tree("foo_pk", header_page->GetPageId(), bpm, comparator);
+  std::vector<int64_t> keys;
+  int64_t scale_factor = 10000;
+  for (int64_t key = 1; key < scale_factor; key++) {
+    keys.push_back(key);
+  }
+  LaunchParallelTest(4, InsertHelperSplit, &tree, keys, 4);
+
+  CheckKeys(&tree, keys, {0, scale_factor});
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+}
+
+TEST(BLinkTreeConcurrentTest, InsertTest2) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  // tiny nodes, so that splits propagate all the way up while other threads descend
+  BLinkTreeForTest tree("foo_pk", header_page->GetPageId(), bpm, comparator, 3, 4);
+  std::vector<int64_t> keys;
+  int64_t scale_factor = 2000;
+  for (int64_t key = 1; key < scale_factor; key++) {
+    keys.push_back(key);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(445));
+  LaunchParallelTest(8, InsertHelperSplit, &tree, keys, 8);
+
+  CheckKeys(&tree, keys, {0, scale_factor});
+
+  // duplicated keys are rejected
+  GenericKey<8> index_key;
+  index_key.SetFromInteger(keys[0]);
+  EXPECT_FALSE(tree.Insert(index_key, RID(0, 0)));
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+}
+
+TEST(BLinkTreeConcurrentTest, DeleteTest1) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  BLinkTreeForTest tree("foo_pk", header_page->GetPageId(), bpm, comparator, 3, 4);
+  std::vector<int64_t> keys;
+  std::vector<int64_t> remove_keys;
+  std::vector<int64_t> remain_keys;
+  for (int64_t key = 1; key <= 1000; key++) {
+    keys.push_back(key);
+    (key % 3 == 0 ? remain_keys : remove_keys).push_back(key);
+  }
+  LaunchParallelTest(1, InsertHelperSplit, &tree, keys, 1);
+  LaunchParallelTest(4, DeleteHelperSplit, &tree, remove_keys, 4);
+
+  CheckKeys(&tree, remain_keys, remove_keys);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+}
+
+TEST(BLinkTreeConcurrentTest, MixTest1) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  BLinkTreeForTest tree("foo_pk", header_page->GetPageId(), bpm, comparator, 3, 4);
+
+  // even keys are inserted up front and must stay visible while odd keys are inserted and removed around them
+  std::vector<int64_t> stable_keys;
+  std::vector<int64_t> churn_keys;
+  for (int64_t key = 0; key < 2000; key++) {
+    (key % 2 == 0 ? stable_keys : churn_keys).push_back(key);
+  }
+  LaunchParallelTest(1, InsertHelperSplit, &tree, stable_keys, 1);
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; i++) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        CheckKeys(&tree, stable_keys, {});
+      }
+    });
+  }
+  LaunchParallelTest(4, InsertHelperSplit, &tree, churn_keys, 4);
+  LaunchParallelTest(4, DeleteHelperSplit, &tree, churn_keys, 4);
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  CheckKeys(&tree, stable_keys, churn_keys);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+}
+
+}  // namespace bustub
@@ -0,0 +1,207 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_adaptive_hash_test.cpp
+//
+// Identification: test/storage/b_plus_tree_adaptive_hash_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using bustub::DiskManagerUnlimitedMemory;
+using Tree = BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+
+namespace {
+
+void InsertKey(Tree *tree, int64_t key, Transaction *txn) {
+  GenericKey<8> index_key;
+  index_key.SetFromInteger(key);
+  tree->Insert(index_key, RID(static_cast<int32_t>(key >> 32), static_cast<uint32_t>(key & 0xFFFFFFFF)), txn);
+}
+
+void RemoveKey(Tree *tree, int64_t key, Transaction *txn) {
+  GenericKey<8> index_key;
+  index_key.SetFromInteger(key);
+  tree->Remove(index_key, txn);
+}
+
+/** @return the slot number of the value found for the key, or -1 */
+auto LookupKey(Tree *tree, int64_t key) -> int64_t {
+  GenericKey<8> index_key;
+  index_key.SetFromInteger(key);
+  std::vector<RID> rids;
+  if (!tree->GetValue(index_key, &rids)) {
+    return -1;
+  }
+  EXPECT_EQ(rids.size(), 1);
+  return rids[0].GetSlotNum();
+}
+
+}  // namespace
+
+TEST(BPlusTreeAdaptiveHashTests, HotKeysSkipTheDescent) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  Tree tree("foo_pk", header_page->GetPageId(), bpm.get(), comparator, 3, 3);
+  Transaction txn(0);
+
+  for (int64_t key = 1; key <= 100; key++) {
+    InsertKey(&tree, key, &txn);
+  }
+  for (int round = 0; round < 10; round++) {
+    EXPECT_EQ(LookupKey(&tree, 42), 42);
+  }
+  auto stats = tree.GetAdaptiveHashIndexStats();
+  EXPECT_EQ(stats.builds_, 1);
+  EXPECT_EQ(stats.entries_, 1);
+  // the key is cached once it was looked up ADAPTIVE_HASH_INDEX_BUILD_THRESHOLD times
+  EXPECT_EQ(stats.hits_, 10 - ADAPTIVE_HASH_INDEX_BUILD_THRESHOLD);
+
+  // a key deleted from the cached leaf is not found, and a key put back is found again
+  RemoveKey(&tree, 42, &txn);
+  EXPECT_EQ(LookupKey(&tree, 42), -1);
+  // any write to the leaf makes the entries into it stale
+  EXPECT_EQ(tree.GetAdaptiveHashIndexStats().stale_, 1);
+  InsertKey(&tree, 42, &txn);
+  EXPECT_EQ(LookupKey(&tree, 42), 42);
+
+  tree.SetAdaptiveHashIndexEnabled(false);
+  EXPECT_EQ(tree.GetAdaptiveHashIndexStats().entries_, 0);
+  auto lookups = tree.GetAdaptiveHashIndexStats().lookups_;
+  for (int round = 0; round < 10; round++) {
+    EXPECT_EQ(LookupKey(&tree, 42), 42);
+  }
+  EXPECT_EQ(tree.GetAdaptiveHashIndexStats().lookups_, lookups);
+  EXPECT_EQ(tree.GetAdaptiveHashIndexStats().entries_, 0);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+}
+
+TEST(BPlusTreeAdaptiveHashTests, StructureChangesMakeEntriesStale) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  Tree tree("foo_pk", header_page->GetPageId(), bpm.get(), comparator, 3, 3);
+  Transaction txn(0);
+
+  for (int64_t key = 1; key <= 10; key++) {
+    InsertKey(&tree, key, &txn);
+  }
+  for (int64_t key = 1; key <= 10; key++) {
+    for (uint32_t round = 0; round < ADAPTIVE_HASH_INDEX_BUILD_THRESHOLD; round++) {
+      EXPECT_EQ(LookupKey(&tree, key), key);
+    }
+  }
+  EXPECT_EQ(tree.GetAdaptiveHashIndexStats().entries_, 10);
+
+  // splits move keys to new leaves, merges delete leaves
+  for (int64_t key = 11; key <= 60; key++) {
+    InsertKey(&tree, key, &txn);
+  }
+  for (int64_t key = 1; key <= 10; key += 2) {
+    RemoveKey(&tree, key, &txn);
+  }
+  for (int64_t key = 1; key <= 10; key++) {
+    EXPECT_EQ(LookupKey(&tree, key), key % 2 == 1 ? -1 : key);
+  }
+  EXPECT_GT(tree.GetAdaptiveHashIndexStats().stale_, 0);
+
+  // removing every key deletes the root leaf as well
+  for (int64_t key = 1; key <= 60; key++) {
+    RemoveKey(&tree, key, &txn);
+  }
+  for (int64_t key = 1; key <= 10; key++) {
+    EXPECT_EQ(LookupKey(&tree, key), -1);
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+}
+
+TEST(BPlusTreeAdaptiveHashTests, ConcurrentReadersAndWriters) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  Tree tree("foo_pk", header_page->GetPageId(), bpm.get(), comparator, 3, 3);
+  Transaction txn(0);
+
+  // the even keys are hot and never removed, the writers churn the odd ones around them
+  const int64_t num_keys = 200;
+  for (int64_t key = 0; key < num_keys; key += 2) {
+    InsertKey(&tree, key, &txn);
+  }
+  // cache the hot keys up front, the first splits make some of them stale whenever the readers get to run
+  for (int64_t key = 0; key < num_keys; key += 2) {
+    for (uint32_t round = 0; round < ADAPTIVE_HASH_INDEX_BUILD_THRESHOLD; round++) {
+      EXPECT_EQ(LookupKey(&tree, key), key);
+    }
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<int> wrong{0};
+  std::vector<std::thread> threads;
+  for (int reader = 0; reader < 4; reader++) {
+    threads.emplace_back([&] {
+      while (!done.load()) {
+        for (int64_t key = 0; key < num_keys; key += 2) {
+          if (LookupKey(&tree, key) != key) {
+            wrong++;
+          }
+        }
+      }
+    });
+  }
+  for (int writer = 0; writer < 2; writer++) {
+    threads.emplace_back([&, writer] {
+      Transaction writer_txn(writer + 1);
+      for (int round = 0; round < 20; round++) {
+        for (int64_t key = 1 + 2 * writer; key < num_keys; key += 4) {
+          InsertKey(&tree, key, &writer_txn);
+        }
+        for (int64_t key = 1 + 2 * writer; key < num_keys; key += 4) {
+          RemoveKey(&tree, key, &writer_txn);
+        }
+      }
+    });
+  }
+  for (size_t i = 4; i < threads.size(); i++) {
+    threads[i].join();
+  }
+  done = true;
+  for (size_t i = 0; i < 4; i++) {
+    threads[i].join();
+  }
+
+  EXPECT_EQ(wrong.load(), 0);
+  for (int64_t key = 0; key < num_keys; key += 2) {
+    EXPECT_EQ(LookupKey(&tree, key), key);
+  }
+  auto stats = tree.GetAdaptiveHashIndexStats();
+  EXPECT_GT(stats.hits_, 0);
+  EXPECT_GT(stats.stale_, 0);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+}
+
+}  // namespace bustub
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <atomic>
 #include <chrono>  // NOLINT
 #include <cstdio>
 #include <functional>
@@ -336,6 +337,154 @@ TEST(BPlusTreeConcurrentTest, MixTest1) {
   delete bpm;
 }
 
+TEST(BPlusTreeConcurrentTest, BatchTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto *header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", page_id, bpm, comparator, 4, 4);
+
+  int64_t total_keys = 2000;
+  int64_t num_threads = 4;
+  // each thread inserts its own residue class in sorted batches of 50
+  auto insert_task = [&](int64_t tid) {
+    std::vector<std::pair<GenericKey<8>, RID>> entries;
+    for (int64_t key = tid; key < total_keys; key += num_threads) {
+      GenericKey<8> index_key;
+      index_key.SetFromInteger(key);
+      entries.emplace_back(index_key, RID(0, key));
+      if (entries.size() == 50) {
+        tree.InsertBatch(entries);
+        entries.clear();
+      }
+    }
+    tree.InsertBatch(entries);
+  };
+  // batched lookups racing with the inserts must only ever see correct values
+  auto lookup_task = [&](int64_t tid) {
+    std::vector<GenericKey<8>> keys;
+    for (int64_t key = 0; key < total_keys; key += 7) {
+      GenericKey<8> index_key;
+      index_key.SetFromInteger(key);
+      keys.push_back(index_key);
+    }
+    for (int round = 0; round < 5; round++) {
+      std::vector<std::vector<RID>> result;
+      tree.GetValues(keys, &result);
+      for (size_t i = 0; i < keys.size(); i++) {
+        ASSERT_LE(result[i].size(), 1U);
+        if (!result[i].empty()) {
+          ASSERT_EQ(result[i][0].GetSlotNum(), static_cast<uint32_t>(i * 7));
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int64_t tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back(insert_task, tid);
+  }
+  threads.emplace_back(lookup_task, num_threads);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  int64_t current_key = 0;
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator) {
+    ASSERT_EQ((*iterator).second.GetSlotNum(), current_key);
+    current_key++;
+  }
+  EXPECT_EQ(current_key, total_keys);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+}
+
+TEST(BPlusTreeConcurrentTest, ScanWhileWriteTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto *header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  // create b+ tree with small pages so that writers keep splitting and merging leaves under the scanners
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", page_id, bpm, comparator, 4, 4);
+
+  std::vector<int64_t> perserved_keys;
+  std::vector<int64_t> dynamic_keys;
+  int64_t total_keys = 3000;
+  int64_t sieve = 3;
+  for (int64_t i = 1; i <= total_keys; i++) {
+    if (i % sieve == 0) {
+      perserved_keys.push_back(i);
+    } else {
+      dynamic_keys.push_back(i);
+    }
+  }
+  InsertHelper(&tree, perserved_keys, 1);
+
+  // every scan must return keys in strictly increasing (decreasing for reverse scans) order and see every
+  // perserved key exactly once
+  auto scan_task = [&](int tid) {
+    for (int round = 0; round < 5; round++) {
+      size_t seen = 0;
+      int64_t last = 0;
+      for (auto iter = tree.Begin(); !iter.IsEnd(); ++iter) {
+        int64_t key = (*iter).first.ToString();
+        ASSERT_GT(key, last);
+        last = key;
+        if (key % sieve == 0) {
+          seen++;
+        }
+      }
+      ASSERT_EQ(seen, perserved_keys.size());
+    }
+  };
+  auto reverse_scan_task = [&](int tid) {
+    for (int round = 0; round < 5; round++) {
+      size_t seen = 0;
+      int64_t last = total_keys + 1;
+      for (auto iter = tree.RBegin(); !iter.IsEnd(); ++iter) {
+        int64_t key = (*iter).first.ToString();
+        ASSERT_LT(key, last);
+        last = key;
+        if (key % sieve == 0) {
+          seen++;
+        }
+      }
+      ASSERT_EQ(seen, perserved_keys.size());
+    }
+  };
+  auto insert_task = [&](int tid) { InsertHelper(&tree, dynamic_keys, tid); };
+  auto delete_task = [&](int tid) { DeleteHelper(&tree, dynamic_keys, tid); };
+
+  std::vector<std::thread> threads;
+  threads.emplace_back(insert_task, 0);
+  threads.emplace_back(scan_task, 1);
+  threads.emplace_back(delete_task, 2);
+  threads.emplace_back(reverse_scan_task, 3);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+}
+
 TEST(BPlusTreeConcurrentTest, MixTest2) {
   // create KeyComparator and index schema
   auto key_schema = ParseCreateStatement("a bigint");
@@ -402,4 +551,67 @@ TEST(BPlusTreeConcurrentTest, MixTest2) {
   delete bpm;
 }
 
+TEST(BPlusTreeConcurrentTest, RootChangeTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  page_id_t page_id;
+  auto *header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", page_id, bpm, comparator, 3, 3);
+
+  // writers grow the tree a few levels above the only preserved key and shrink it back, so that the root
+  // keeps splitting and collapsing under the readers
+  std::vector<int64_t> perserved_keys = {0};
+  InsertHelper(&tree, perserved_keys);
+  std::atomic<bool> done{false};
+  std::atomic<int> misses{0};
+  std::vector<std::thread> threads;
+  for (int64_t writer = 0; writer < 4; writer++) {
+    threads.emplace_back([&, writer] {
+      std::vector<int64_t> keys;
+      for (int64_t key = writer + 1; key <= 40; key += 4) {
+        keys.push_back(key);
+      }
+      for (int round = 0; round < 50; round++) {
+        InsertHelper(&tree, keys);
+        DeleteHelper(&tree, keys);
+      }
+    });
+  }
+  for (int reader = 0; reader < 4; reader++) {
+    threads.emplace_back([&] {
+      GenericKey<8> index_key;
+      index_key.SetFromInteger(0);
+      std::vector<RID> rids;
+      while (!done) {
+        rids.clear();
+        if (!tree.GetValue(index_key, &rids) || tree.Begin() == tree.End()) {
+          misses++;
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 4; i++) {
+    threads[i].join();
+  }
+  done = true;
+  for (size_t i = 4; i < threads.size(); i++) {
+    threads[i].join();
+  }
+
+  EXPECT_EQ(misses.load(), 0);
+  size_t size = 0;
+  for (auto iter = tree.Begin(); iter != tree.End(); ++iter) {
+    EXPECT_EQ((*iter).first.ToString(), 0);
+    size++;
+  }
+  EXPECT_EQ(size, 1);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+}
+
 }  // namespace bustub
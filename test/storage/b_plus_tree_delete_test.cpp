@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <thread>  // NOLINT
 
 #include "buffer/buffer_pool_manager.h"
 #include "gtest/gtest.h"
@@ -23,6 +24,26 @@ namespace bustub {
 
 using bustub::DiskManagerUnlimitedMemory;
 
+// helper function to count the leaves of a tree by following the leaf chain
+auto CountLeaves(BufferPoolManager *bpm, page_id_t root_page_id) -> int {
+  if (root_page_id == INVALID_PAGE_ID) {
+    return 0;
+  }
+  ReadPageGuard guard = bpm->FetchPageRead(root_page_id);
+  while (!guard.As<BPlusTreePage>()->IsLeafPage()) {
+    page_id_t child = guard.As<BPlusTreeInternalPage<GenericKey<8>, page_id_t, GenericComparator<8>>>()->ValueAt(0);
+    guard = bpm->FetchPageRead(child);
+  }
+  int count = 1;
+  page_id_t next = guard.As<BPlusTreeLeafPage<GenericKey<8>, RID, GenericComparator<8>>>()->GetNextPageId();
+  while (next != INVALID_PAGE_ID) {
+    guard = bpm->FetchPageRead(next);
+    next = guard.As<BPlusTreeLeafPage<GenericKey<8>, RID, GenericComparator<8>>>()->GetNextPageId();
+    count++;
+  }
+  return count;
+}
+
 TEST(BPlusTreeTests, DeleteTest1) {
   // create KeyComparator and index schema
   auto key_schema = ParseCreateStatement("a bigint");
@@ -222,4 +243,121 @@ TEST(BPlusTreeTests, DeleteTest3) {
   delete transaction;
   delete bpm;
 }
+
+TEST(BPlusTreeTests, LazyMergeTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", header_page->GetPageId(), bpm, comparator, 8, 8);
+  // only rebalance nodes that became empty
+  tree.SetMergeThreshold(0);
+  GenericKey<8> index_key;
+  RID rid;
+  auto *transaction = new Transaction(0);
+
+  for (int64_t key = 1; key <= 400; key++) {
+    rid.Set(static_cast<int32_t>(key >> 32), key & 0xFFFFFFFF);
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, rid, transaction);
+  }
+  int leaves_before = CountLeaves(bpm, tree.GetRootPageId());
+  for (int64_t key = 1; key <= 400; key++) {
+    if (key % 8 != 0) {
+      index_key.SetFromInteger(key);
+      tree.Remove(index_key, transaction);
+    }
+  }
+  // leaves of four keys keep their multiple of eight, or are merged away once empty
+  int sparse_leaves = CountLeaves(bpm, tree.GetRootPageId());
+  EXPECT_GT(sparse_leaves, leaves_before / 3);
+
+  size_t merged = tree.Compact(transaction);
+  EXPECT_GT(merged, 0);
+  int compacted_leaves = CountLeaves(bpm, tree.GetRootPageId());
+  EXPECT_EQ(compacted_leaves, sparse_leaves - static_cast<int>(merged));
+  EXPECT_LE(compacted_leaves, 50 / 4 + 1);
+  EXPECT_EQ(tree.Compact(transaction), 0);
+
+  std::vector<RID> rids;
+  for (int64_t key = 1; key <= 400; key++) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    EXPECT_EQ(tree.GetValue(index_key, &rids), key % 8 == 0);
+  }
+  int64_t expected_key = 8;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    EXPECT_EQ((*iterator).second.GetSlotNum(), expected_key);
+    expected_key += 8;
+  }
+  EXPECT_EQ(expected_key, 408);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete bpm;
+}
+
+TEST(BPlusTreeTests, BackgroundCompactionTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  auto interval = b_plus_tree_compaction_interval;
+  b_plus_tree_compaction_interval = std::chrono::milliseconds(1);
+  {
+    BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", header_page->GetPageId(), bpm, comparator, 8,
+                                                             8);
+    tree.SetMergeThreshold(0.25);
+    auto *transaction = new Transaction(0);
+    GenericKey<8> index_key;
+    RID rid;
+    for (int64_t key = 1; key <= 1000; key++) {
+      rid.Set(static_cast<int32_t>(key >> 32), key & 0xFFFFFFFF);
+      index_key.SetFromInteger(key);
+      tree.Insert(index_key, rid, transaction);
+    }
+
+    tree.StartBackgroundCompaction();
+    // two writers delete all but every tenth key while the compaction merges behind them
+    std::vector<std::thread> threads;
+    for (int64_t start = 1; start <= 2; start++) {
+      threads.emplace_back([&, start] {
+        GenericKey<8> key_to_remove;
+        for (int64_t key = start; key <= 1000; key += 2) {
+          if (key % 10 != 0) {
+            key_to_remove.SetFromInteger(key);
+            tree.Remove(key_to_remove, transaction);
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    tree.StopBackgroundCompaction();
+    tree.Compact(transaction);
+
+    // 100 keys left, in half full leaves of eight
+    EXPECT_LE(CountLeaves(bpm, tree.GetRootPageId()), 100 / 4 + 1);
+    std::vector<RID> rids;
+    for (int64_t key = 1; key <= 1000; key++) {
+      rids.clear();
+      index_key.SetFromInteger(key);
+      EXPECT_EQ(tree.GetValue(index_key, &rids), key % 10 == 0);
+    }
+    delete transaction;
+  }
+  b_plus_tree_compaction_interval = interval;
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+}
+
 }  // namespace bustub
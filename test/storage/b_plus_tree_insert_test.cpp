@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <random>
 
 #include "buffer/buffer_pool_manager.h"
 #include "gtest/gtest.h"
@@ -260,6 +261,147 @@ TEST(BPlusTreeTests, IteratorTest) {
   remove("test.db");
   remove("test.log");
 }
+
+TEST(BPlusTreeTests, IteratorMultiLeafTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  ASSERT_EQ(page_id, HEADER_PAGE_ID);
+
+  // create b+ tree with tiny pages so that the scan crosses many leaves
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", header_page->GetPageId(), bpm, comparator, 3, 3);
+  GenericKey<8> index_key;
+  RID rid;
+  // create transaction
+  auto *transaction = new Transaction(0);
+
+  // only even keys, inserted in a scrambled order
+  std::vector<int64_t> keys;
+  for (int64_t key = 2; key <= 200; key += 2) {
+    keys.push_back(key);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(445));
+  for (auto key : keys) {
+    rid.Set(0, key);
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, rid, transaction);
+  }
+
+  int64_t current_key = 2;
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator) {
+    EXPECT_EQ((*iterator).second.GetSlotNum(), current_key);
+    current_key += 2;
+  }
+  EXPECT_EQ(current_key, 202);
+
+  // a start key that is not in the tree positions the iterator on its successor
+  for (int64_t start_key = 1; start_key <= 201; start_key += 20) {
+    index_key.SetFromInteger(start_key);
+    auto iterator = tree.Begin(index_key);
+    if (start_key > 200) {
+      EXPECT_TRUE(iterator.IsEnd());
+      continue;
+    }
+    ASSERT_FALSE(iterator.IsEnd());
+    EXPECT_EQ((*iterator).second.GetSlotNum(), start_key + 1);
+  }
+
+  // BeginAfter skips the key itself
+  index_key.SetFromInteger(100);
+  auto iterator = tree.BeginAfter(index_key);
+  ASSERT_FALSE(iterator.IsEnd());
+  EXPECT_EQ((*iterator).second.GetSlotNum(), 102);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete bpm;
+}
+
+TEST(BPlusTreeTests, ReverseIteratorTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  ASSERT_EQ(page_id, HEADER_PAGE_ID);
+
+  // create b+ tree with tiny pages so that the scan crosses many leaves
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", header_page->GetPageId(), bpm, comparator, 3, 3);
+  GenericKey<8> index_key;
+  RID rid;
+  // create transaction
+  auto *transaction = new Transaction(0);
+
+  EXPECT_TRUE(tree.RBegin().IsEnd());
+
+  // only even keys, inserted in a scrambled order
+  std::vector<int64_t> keys;
+  for (int64_t key = 2; key <= 200; key += 2) {
+    keys.push_back(key);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(445));
+  for (auto key : keys) {
+    rid.Set(0, key);
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, rid, transaction);
+  }
+
+  int64_t current_key = 200;
+  for (auto iterator = tree.RBegin(); !iterator.IsEnd(); ++iterator) {
+    EXPECT_EQ((*iterator).second.GetSlotNum(), current_key);
+    current_key -= 2;
+  }
+  EXPECT_EQ(current_key, 0);
+
+  // a start key that is not in the tree positions the iterator on its predecessor
+  for (int64_t start_key = 1; start_key <= 201; start_key += 20) {
+    index_key.SetFromInteger(start_key);
+    auto iterator = tree.RBegin(index_key);
+    if (start_key < 2) {
+      EXPECT_TRUE(iterator.IsEnd());
+      continue;
+    }
+    ASSERT_FALSE(iterator.IsEnd());
+    EXPECT_EQ((*iterator).second.GetSlotNum(), start_key - 1);
+  }
+
+  // RBegin(key) includes the key itself, RBeginBefore skips it
+  index_key.SetFromInteger(100);
+  EXPECT_EQ((*tree.RBegin(index_key)).second.GetSlotNum(), 100);
+  EXPECT_EQ((*tree.RBeginBefore(index_key)).second.GetSlotNum(), 98);
+
+  // merges must keep the previous-leaf links intact
+  for (int64_t key = 40; key <= 160; key += 2) {
+    index_key.SetFromInteger(key);
+    tree.Remove(index_key, transaction);
+  }
+  std::vector<int64_t> forward;
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator) {
+    forward.push_back((*iterator).second.GetSlotNum());
+  }
+  std::vector<int64_t> backward;
+  for (auto iterator = tree.RBegin(); !iterator.IsEnd(); ++iterator) {
+    backward.push_back((*iterator).second.GetSlotNum());
+  }
+  std::reverse(backward.begin(), backward.end());
+  EXPECT_EQ(forward.size(), 39U);
+  EXPECT_EQ(forward, backward);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete bpm;
+}
+
 /*
  * Score: 20
  * Description: Insert keys range from 1 to 5 repeatedly,
@@ -268,4 +410,69 @@ TEST(BPlusTreeTests, IteratorTest) {
  * leaf nodes
  */
 
+TEST(BPlusTreeTests, BatchTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  ASSERT_EQ(page_id, HEADER_PAGE_ID);
+
+  // create b+ tree with tiny pages so that a batch spans many leaves and splits
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", header_page->GetPageId(), bpm, comparator, 3, 3);
+  GenericKey<8> index_key;
+  RID rid;
+  // create transaction
+  auto *transaction = new Transaction(0);
+
+  // odd keys one by one first, so that the batch has to interleave with existing leaves
+  for (int64_t key = 1; key < 200; key += 2) {
+    rid.Set(0, key);
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, rid, transaction);
+  }
+
+  // every key in [0, 200), odd keys are duplicates and must be skipped
+  std::vector<std::pair<GenericKey<8>, RID>> entries;
+  for (int64_t key = 0; key < 200; key++) {
+    index_key.SetFromInteger(key);
+    entries.emplace_back(index_key, RID(0, key));
+  }
+  EXPECT_EQ(tree.InsertBatch(entries, transaction), 100U);
+
+  int64_t current_key = 0;
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator) {
+    EXPECT_EQ((*iterator).second.GetSlotNum(), current_key);
+    current_key++;
+  }
+  EXPECT_EQ(current_key, 200);
+
+  // batched lookups, including keys below, between and above the stored ones
+  std::vector<GenericKey<8>> keys;
+  for (int64_t key = -5; key < 210; key += 3) {
+    index_key.SetFromInteger(key);
+    keys.push_back(index_key);
+  }
+  std::vector<std::vector<RID>> result;
+  tree.GetValues(keys, &result, transaction);
+  ASSERT_EQ(result.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    int64_t key = -5 + static_cast<int64_t>(i) * 3;
+    if (key < 0 || key >= 200) {
+      EXPECT_TRUE(result[i].empty());
+      continue;
+    }
+    ASSERT_EQ(result[i].size(), 1U);
+    EXPECT_EQ(result[i][0].GetSlotNum(), key);
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete bpm;
+}
+
 }  // namespace bustub
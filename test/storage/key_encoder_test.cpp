@@ -0,0 +1,145 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// key_encoder_test.cpp
+//
+// Identification: test/storage/key_encoder_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/index/generic_key.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+template <size_t KeySize>
+auto MakeKey(const std::vector<Value> &values, const Schema &schema) -> GenericKey<KeySize> {
+  GenericKey<KeySize> key;
+  key.SetFromKey(Tuple(values, &schema), schema);
+  return key;
+}
+
+/** Check that the keys built from `rows`, which are sorted ascending, compare in the same order. */
+template <size_t KeySize>
+void CheckOrder(const std::vector<std::vector<Value>> &rows, Schema *schema) {
+  GenericComparator<KeySize> comparator(schema);
+  for (size_t i = 0; i < rows.size(); i++) {
+    auto lhs = MakeKey<KeySize>(rows[i], *schema);
+    EXPECT_EQ(comparator(lhs, MakeKey<KeySize>(rows[i], *schema)), 0) << "row " << i;
+    for (size_t j = i + 1; j < rows.size(); j++) {
+      auto rhs = MakeKey<KeySize>(rows[j], *schema);
+      EXPECT_LT(comparator(lhs, rhs), 0) << "rows " << i << " and " << j;
+      EXPECT_GT(comparator(rhs, lhs), 0) << "rows " << j << " and " << i;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(KeyEncoderTest, IntegerTest) {
+  Schema schema({Column{"a", TypeId::INTEGER}});
+  EXPECT_EQ(KeyEncoder::EncodedSize(schema), 5U);
+
+  std::vector<std::vector<Value>> rows{{ValueFactory::GetNullValueByType(TypeId::INTEGER)},
+                                       {ValueFactory::GetIntegerValue(BUSTUB_INT32_MIN)},
+                                       {ValueFactory::GetIntegerValue(-256)},
+                                       {ValueFactory::GetIntegerValue(-1)},
+                                       {ValueFactory::GetIntegerValue(0)},
+                                       {ValueFactory::GetIntegerValue(1)},
+                                       {ValueFactory::GetIntegerValue(255)},
+                                       {ValueFactory::GetIntegerValue(256)},
+                                       {ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX)}};
+  CheckOrder<8>(rows, &schema);
+}
+
+TEST(KeyEncoderTest, DecimalTest) {
+  Schema schema({Column{"a", TypeId::DECIMAL}});
+  std::vector<std::vector<Value>> rows{{ValueFactory::GetDecimalValue(-1e10)}, {ValueFactory::GetDecimalValue(-2.5)},
+                                       {ValueFactory::GetDecimalValue(-0.5)},  {ValueFactory::GetDecimalValue(0)},
+                                       {ValueFactory::GetDecimalValue(0.25)},  {ValueFactory::GetDecimalValue(3)},
+                                       {ValueFactory::GetDecimalValue(1e10)}};
+  CheckOrder<16>(rows, &schema);
+}
+
+TEST(KeyEncoderTest, VarcharTest) {
+  Schema schema({Column{"a", TypeId::VARCHAR, 8}});
+  EXPECT_EQ(KeyEncoder::EncodedSize(schema), 11U);
+
+  std::vector<std::vector<Value>> rows{{ValueFactory::GetNullValueByType(TypeId::VARCHAR)},
+                                       {ValueFactory::GetVarcharValue("")},
+                                       {ValueFactory::GetVarcharValue(std::string("\0", 1))},
+                                       {ValueFactory::GetVarcharValue("a")},
+                                       {ValueFactory::GetVarcharValue(std::string("a\0", 2))},
+                                       {ValueFactory::GetVarcharValue("ab")},
+                                       {ValueFactory::GetVarcharValue("b")},
+                                       {ValueFactory::GetVarcharValue("bustub")}};
+  CheckOrder<16>(rows, &schema);
+
+  // keys longer than the key type are rejected instead of being truncated
+  GenericKey<8> key;
+  EXPECT_THROW(key.SetFromKey(Tuple({ValueFactory::GetVarcharValue("bustub!!")}, &schema), schema), Exception);
+}
+
+TEST(KeyEncoderTest, CompositeTest) {
+  Schema schema({Column{"a", TypeId::VARCHAR, 4}, Column{"b", TypeId::INTEGER}});
+  EXPECT_EQ(KeyEncoder::EncodedSize(schema), 12U);
+
+  // the first column decides, even when it is a prefix of the other one
+  std::vector<std::vector<Value>> rows{
+      {ValueFactory::GetNullValueByType(TypeId::VARCHAR), ValueFactory::GetIntegerValue(5)},
+      {ValueFactory::GetVarcharValue("a"), ValueFactory::GetNullValueByType(TypeId::INTEGER)},
+      {ValueFactory::GetVarcharValue("a"), ValueFactory::GetIntegerValue(-7)},
+      {ValueFactory::GetVarcharValue("a"), ValueFactory::GetIntegerValue(100)},
+      {ValueFactory::GetVarcharValue("ab"), ValueFactory::GetIntegerValue(-100)},
+      {ValueFactory::GetVarcharValue("b"), ValueFactory::GetIntegerValue(0)}};
+  CheckOrder<16>(rows, &schema);
+}
+
+TEST(KeyEncoderTest, DecodeTest) {
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 8}, Column{"c", TypeId::DECIMAL},
+                 Column{"d", TypeId::BIGINT}, Column{"e", TypeId::SMALLINT}});
+  std::vector<std::vector<Value>> rows{
+      {ValueFactory::GetIntegerValue(-42), ValueFactory::GetVarcharValue(std::string("a\0b", 3)),
+       ValueFactory::GetDecimalValue(-2.5), ValueFactory::GetBigIntValue(BUSTUB_INT64_MIN),
+       ValueFactory::GetSmallIntValue(-7)},
+      {ValueFactory::GetNullValueByType(TypeId::INTEGER), ValueFactory::GetVarcharValue(""),
+       ValueFactory::GetDecimalValue(0.25), ValueFactory::GetNullValueByType(TypeId::BIGINT),
+       ValueFactory::GetSmallIntValue(300)}};
+  for (const auto &row : rows) {
+    GenericKey<64> key;
+    size_t used = key.SetFromKey(Tuple(row, &schema), schema);
+    EXPECT_LE(used, KeyEncoder::EncodedSize(schema));
+    auto decoded = KeyEncoder::Decode(key.data_, schema);
+    ASSERT_EQ(decoded.size(), row.size());
+    for (size_t i = 0; i < row.size(); i++) {
+      EXPECT_EQ(decoded[i].IsNull(), row[i].IsNull()) << "column " << i;
+      if (!row[i].IsNull()) {
+        EXPECT_EQ(decoded[i].CompareEquals(row[i]), CmpBool::CmpTrue) << "column " << i;
+      }
+    }
+  }
+}
+
+TEST(KeyEncoderTest, IntegerRoundTripTest) {
+  GenericComparator<8> comparator(nullptr);
+  std::vector<int64_t> keys{BUSTUB_INT64_MIN, -1000, -1, 0, 1, 1000, BUSTUB_INT64_MAX};
+  for (size_t i = 0; i < keys.size(); i++) {
+    GenericKey<8> lhs;
+    lhs.SetFromInteger(keys[i]);
+    EXPECT_EQ(lhs.ToString(), keys[i]);
+    if (i + 1 < keys.size()) {
+      GenericKey<8> rhs;
+      rhs.SetFromInteger(keys[i + 1]);
+      EXPECT_LT(comparator(lhs, rhs), 0);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -192,4 +192,75 @@ TEST(PageGuardTest, HHTest) {
 
   disk_manager->ShutDown();
 }
+
+// NOLINTNEXTLINE
+TEST(PageGuardTest, OptimisticTest) {
+  const size_t buffer_pool_size = 5;
+  const size_t k = 2;
+
+  auto disk_manager = std::make_shared<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_shared<BufferPoolManager>(buffer_pool_size, disk_manager.get(), k);
+
+  page_id_t page_id_temp = 0;
+  auto *page0 = bpm->NewPage(&page_id_temp);
+  bpm->UnpinPage(page_id_temp, false);
+
+  char data[BUSTUB_PAGE_SIZE];
+  {
+    auto optimistic_guard = bpm->FetchPageOptimistic(page_id_temp);
+    EXPECT_TRUE(optimistic_guard.IsValid());
+    EXPECT_EQ(1, page0->GetPinCount());
+    EXPECT_TRUE(optimistic_guard.CopyData(data));
+    EXPECT_TRUE(optimistic_guard.Validate());
+
+    // reading does not get in the way, writing does
+    bpm->FetchPageRead(page_id_temp).Drop();
+    EXPECT_TRUE(optimistic_guard.Validate());
+    bpm->FetchPageWrite(page_id_temp).Drop();
+    EXPECT_FALSE(optimistic_guard.Validate());
+    EXPECT_FALSE(optimistic_guard.CopyData(data));
+    EXPECT_FALSE(optimistic_guard.UpgradeRead().has_value());
+    EXPECT_EQ(1, page0->GetPinCount());
+  }
+  EXPECT_EQ(0, page0->GetPinCount());
+
+  {
+    // a page that is write-latched cannot be read optimistically
+    auto write_guard = bpm->FetchPageWrite(page_id_temp);
+    auto optimistic_guard = bpm->FetchPageOptimistic(page_id_temp);
+    EXPECT_FALSE(optimistic_guard.IsValid());
+    EXPECT_FALSE(optimistic_guard.Validate());
+  }
+  EXPECT_EQ(0, page0->GetPinCount());
+
+  {
+    // the pin moves to the read guard
+    auto optimistic_guard = bpm->FetchPageOptimistic(page_id_temp);
+    auto read_guard = optimistic_guard.UpgradeRead();
+    ASSERT_TRUE(read_guard.has_value());
+    EXPECT_EQ(page_id_temp, read_guard->PageId());
+    EXPECT_EQ(1, page0->GetPinCount());
+    optimistic_guard.Drop();
+    EXPECT_EQ(1, page0->GetPinCount());
+  }
+  EXPECT_EQ(0, page0->GetPinCount());
+
+  {
+    // a page evicted and fetched again, into any frame, never comes back at a version seen before
+    uint64_t version = bpm->FetchPageRead(page_id_temp).GetVersion();
+    EXPECT_EQ(version, bpm->FetchPageRead(page_id_temp).GetVersion());
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+      page_id_t page_id;
+      bpm->NewPage(&page_id);
+      bpm->FetchPageWrite(page_id).Drop();
+      bpm->UnpinPage(page_id, false);
+    }
+    auto read_guard = bpm->FetchPageRead(page_id_temp);
+    EXPECT_NE(version, read_guard.GetVersion());
+    EXPECT_EQ(0, read_guard.GetVersion() % 2);
+  }
+
+  disk_manager->ShutDown();
+}
+
 }  // namespace bustub
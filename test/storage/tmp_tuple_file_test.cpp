@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file_test.cpp
+//
+// Identification: test/storage/tmp_tuple_file_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/disk/tmp_file_manager.h"
+#include "storage/table/tmp_tuple_file.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(TmpTupleFileTest, SpillsToTmpFile) {
+  TmpFileManager tmp_files;
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 64}});
+
+  const int tuple_count = 2000;
+  std::vector<std::unique_ptr<TmpTupleFile>> files;
+  for (int i = 0; i < 3; i++) {
+    files.push_back(std::make_unique<TmpTupleFile>(&tmp_files));
+  }
+  for (int i = 0; i < tuple_count; i++) {
+    std::vector<Value> values{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::to_string(i))};
+    files[i % files.size()]->Append(Tuple{values, &schema});
+  }
+
+  std::vector<bool> seen(tuple_count);
+  for (auto &file : files) {
+    file->Rewind();
+    EXPECT_GE(file->GetSpilledBytes(), 3 * BUSTUB_PAGE_SIZE);
+    Tuple tuple;
+    size_t count = 0;
+    while (file->Next(&tuple)) {
+      auto a = tuple.GetValue(&schema, 0).GetAs<int32_t>();
+      ASSERT_EQ(tuple.GetValue(&schema, 1).ToString(), std::to_string(a));
+      ASSERT_FALSE(seen[a]);
+      seen[a] = true;
+      count++;
+    }
+    EXPECT_EQ(count, file->GetTupleCount());
+
+    // a file can be read again
+    file->Rewind();
+    ASSERT_TRUE(file->Next(&tuple));
+  }
+  for (int i = 0; i < tuple_count; i++) {
+    EXPECT_TRUE(seen[i]) << i;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TmpTupleFileTest, ReusesPagesAndDeletesFile) {
+  auto tmp_files = std::make_unique<TmpFileManager>();
+  std::string file_name = tmp_files->GetFileName();
+  EXPECT_TRUE(std::filesystem::exists(file_name));
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 64}});
+
+  auto fill = [&](TmpTupleFile *file) {
+    for (int i = 0; i < 1000; i++) {
+      std::vector<Value> values{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::to_string(i))};
+      file->Append(Tuple{values, &schema});
+    }
+    file->Rewind();
+  };
+  {
+    TmpTupleFile file(tmp_files.get());
+    fill(&file);
+  }
+  size_t page_count = tmp_files->GetPageCount();
+  EXPECT_GT(page_count, 1);
+
+  // the pages of a deleted file are reused, so the temporary file does not grow
+  for (int round = 0; round < 3; round++) {
+    TmpTupleFile file(tmp_files.get());
+    fill(&file);
+    Tuple tuple;
+    size_t count = 0;
+    while (file.Next(&tuple)) {
+      count++;
+    }
+    EXPECT_EQ(1000, count);
+  }
+  EXPECT_EQ(page_count, tmp_files->GetPageCount());
+
+  tmp_files.reset();
+  EXPECT_FALSE(std::filesystem::exists(file_name));
+}
+
+}  // namespace bustub
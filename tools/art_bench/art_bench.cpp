@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "buffer/buffer_pool_manager.h"
+#include "common/rid.h"
+#include "container/art/adaptive_radix_tree.h"
+#include "fmt/format.h"
+#include "primer/trie.h"
+#include "primer/trie_store.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/index/generic_key.h"
+#include "test_util.h"
+
+/** Pages of the buffer pool of the B+ tree, enough to keep the whole tree in memory. */
+static const size_t BUSTUB_BPM_SIZE = 4096;
+static const size_t LRU_K_SIZE = 4;
+
+using Key = bustub::GenericKey<8>;
+
+auto KeyOf(uint64_t key) -> Key {
+  Key index_key;
+  index_key.SetFromInteger(static_cast<int64_t>(key));
+  return index_key;
+}
+
+auto KeyBytes(const Key &key) -> std::string_view { return {key.data_, sizeof(key.data_)}; }
+
+auto Seconds(std::chrono::steady_clock::time_point begin) -> double {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/**
+ * Look up random loaded keys with `threads` threads for `duration_ms`.
+ * @return the number of lookups per second
+ */
+template <typename Lookup>
+auto RunLookups(size_t threads, size_t num_keys, uint64_t duration_ms, const std::vector<uint64_t> &keys,
+                Lookup lookup) -> double {
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> total_ops{0};
+  std::vector<std::thread> workers;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t thread_id = 0; thread_id < threads; thread_id++) {
+    workers.emplace_back([&, thread_id] {
+      std::default_random_engine gen(thread_id);
+      std::uniform_int_distribution<size_t> dis(0, num_keys - 1);
+      uint64_t ops = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto key = keys[dis(gen)];
+        if (!lookup(key)) {
+          throw std::runtime_error(fmt::format("key not found: {}", key));
+        }
+        ops++;
+      }
+      total_ops += ops;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+  stop = true;
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return total_ops.load() / Seconds(begin);
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-art-bench");
+  program.add_argument("--keys").help("number of keys loaded into each index");
+  program.add_argument("--duration").help("run the lookups for n milliseconds");
+  program.add_argument("--threads").help("number of threads looking keys up");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t num_keys = 1000000;
+  if (program.present("--keys")) {
+    num_keys = std::stoi(program.get("--keys"));
+  }
+  uint64_t duration_ms = 3000;
+  if (program.present("--duration")) {
+    duration_ms = std::stoi(program.get("--duration"));
+  }
+  size_t threads = std::thread::hardware_concurrency();
+  if (program.present("--threads")) {
+    threads = std::stoi(program.get("--threads"));
+  }
+
+  fmt::print(stderr, "[info] keys={}, threads={}, duration_ms={}, bpm_size={}\n", num_keys, threads, duration_ms,
+             BUSTUB_BPM_SIZE);
+
+  // sparse keys in random order, so that neither index gets to append at its right edge
+  std::vector<uint64_t> keys(num_keys);
+  std::mt19937_64 gen(0);
+  for (auto &key : keys) {
+    key = gen() >> 16;
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  std::shuffle(keys.begin(), keys.end(), gen);
+  num_keys = keys.size();
+
+  bustub::AdaptiveRadixTree<bustub::RID> art;
+  auto begin = std::chrono::steady_clock::now();
+  for (auto key : keys) {
+    art.Insert(KeyBytes(KeyOf(key)), bustub::RID(key));
+  }
+  double art_inserts = num_keys / Seconds(begin);
+
+  auto disk_manager = std::make_unique<bustub::DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<bustub::BufferPoolManager>(BUSTUB_BPM_SIZE, disk_manager.get(), LRU_K_SIZE);
+  auto key_schema = bustub::ParseCreateStatement("a bigint");
+  bustub::GenericComparator<8> comparator(key_schema.get());
+  bustub::page_id_t header_page_id;
+  bpm->NewPageGuarded(&header_page_id);
+  bustub::BPlusTree<Key, bustub::RID, bustub::GenericComparator<8>> tree("art_bench", header_page_id, bpm.get(),
+                                                                         comparator);
+  begin = std::chrono::steady_clock::now();
+  for (auto key : keys) {
+    tree.Insert(KeyOf(key), bustub::RID(key), nullptr);
+  }
+  double tree_inserts = num_keys / Seconds(begin);
+
+  // the tries hold the low 32 bits of the key, for which TrieStore is instantiated; the lookups only check presence
+  bustub::Trie trie;
+  begin = std::chrono::steady_clock::now();
+  for (auto key : keys) {
+    trie = trie.Put<uint32_t>(KeyBytes(KeyOf(key)), static_cast<uint32_t>(key));
+  }
+  double trie_inserts = num_keys / Seconds(begin);
+
+  bustub::TrieStore trie_store;
+  begin = std::chrono::steady_clock::now();
+  for (auto key : keys) {
+    trie_store.Put<uint32_t>(KeyBytes(KeyOf(key)), static_cast<uint32_t>(key));
+  }
+  double trie_store_inserts = num_keys / Seconds(begin);
+
+  double art_lookups = RunLookups(threads, num_keys, duration_ms, keys, [&art](uint64_t key) {
+    return art.Get(KeyBytes(KeyOf(key))).has_value();
+  });
+  double tree_lookups = RunLookups(threads, num_keys, duration_ms, keys, [&tree](uint64_t key) {
+    std::vector<bustub::RID> rids;
+    return tree.GetValue(KeyOf(key), &rids);
+  });
+  // a Trie is immutable, so the threads share one version of it without any lock
+  double trie_lookups = RunLookups(threads, num_keys, duration_ms, keys, [&trie](uint64_t key) {
+    return trie.Get<uint32_t>(KeyBytes(KeyOf(key))) != nullptr;
+  });
+  double trie_store_lookups = RunLookups(threads, num_keys, duration_ms, keys, [&trie_store](uint64_t key) {
+    return trie_store.Get<uint32_t>(KeyBytes(KeyOf(key))).has_value();
+  });
+
+  fmt::print("<<< BEGIN\n");
+  fmt::print("{:>10} {:>16} {:>16} {:>16}\n", "index", "inserts/s", "lookups/s", "bytes/key");
+  fmt::print("{:>10} {:>16.0f} {:>16.0f} {:>16.1f}\n", "art", art_inserts, art_lookups,
+             static_cast<double>(art.MemoryUsage()) / num_keys);
+  fmt::print("{:>10} {:>16.0f} {:>16.0f} {:>16}\n", "b+tree", tree_inserts, tree_lookups, "-");
+  fmt::print("{:>10} {:>16.0f} {:>16.0f} {:>16}\n", "trie", trie_inserts, trie_lookups, "-");
+  fmt::print("{:>10} {:>16.0f} {:>16.0f} {:>16}\n", "trie_store", trie_store_inserts, trie_store_lookups, "-");
+  fmt::print(">>> END\n");
+
+  return 0;
+}
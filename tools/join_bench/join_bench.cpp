@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "common/config.h"
+#include "fmt/format.h"
+
+/** The joins of the benchmark, over the 1M-row mock tables, whose build sides are far larger than a cache */
+static const std::vector<std::pair<std::string, std::string>> JOIN_BENCH_QUERIES = {
+    {"t4 x t5", "select count(*) from __mock_t4_1m t4 inner join __mock_t5_1m t5 on t4.x = t5.x"},
+    {"t4 x t6 left", "select count(*), count(t6.y) from __mock_t4_1m t4 left join __mock_t6_1m t6 on t4.x = t6.x"},
+};
+
+auto Seconds(std::chrono::steady_clock::time_point begin) -> double {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/** Run `sql` and check that it gives `expected`, if not empty. @return the result */
+auto Execute(bustub::BustubInstance *bustub, const std::string &sql, const std::string &expected = "") -> std::string {
+  std::stringstream ss;
+  auto writer = bustub::SimpleStreamWriter(ss, true, " ");
+  if (!bustub->ExecuteSql(sql, writer)) {
+    throw std::runtime_error(fmt::format("failed to execute: {}", sql));
+  }
+  if (!expected.empty() && ss.str() != expected) {
+    throw std::runtime_error(fmt::format("{}: got {}, expected {}", sql, ss.str(), expected));
+  }
+  return ss.str();
+}
+
+/** Run a query `repeat` times with the hash join cache size set to `cache_size`. @return the best time in seconds */
+auto RunQuery(bustub::BustubInstance *bustub, const std::string &sql, size_t cache_size, size_t repeat,
+              std::string *result) -> double {
+  Execute(bustub, fmt::format("set hash_join_cache_size={}", cache_size));
+  double best = 0;
+  for (size_t i = 0; i < repeat; i++) {
+    auto begin = std::chrono::steady_clock::now();
+    auto output = Execute(bustub, sql, *result);
+    double seconds = Seconds(begin);
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+    *result = output;
+  }
+  return best;
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-join-bench");
+  program.add_argument("--repeat").help("run each query n times and keep the best time");
+  program.add_argument("--cache-size").help("the hash join cache size of the partitioned joins, in bytes");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t repeat = 3;
+  if (program.present("--repeat")) {
+    repeat = std::stoi(program.get("--repeat"));
+  }
+  size_t cache_size = bustub::HASH_JOIN_CACHE_SIZE;
+  if (program.present("--cache-size")) {
+    cache_size = std::stoull(program.get("--cache-size"));
+  }
+
+  fmt::print(stderr, "[info] repeat={}, cache_size={}\n", repeat, cache_size);
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+  bustub->GenerateMockTable();
+
+  fmt::print("<<< BEGIN\n");
+  fmt::print("{:>14} {:>16} {:>16} {:>10}\n", "query", "unpartitioned s", "partitioned s", "speedup");
+  for (const auto &[name, sql] : JOIN_BENCH_QUERIES) {
+    // a cache size larger than any table never partitions it; set only takes an INTEGER
+    std::string result;
+    double unpartitioned = RunQuery(bustub.get(), sql, INT32_MAX, repeat, &result);
+    double partitioned = RunQuery(bustub.get(), sql, cache_size, repeat, &result);
+    fmt::print("{:>14} {:>16.3f} {:>16.3f} {:>9.2f}x\n", name, unpartitioned, partitioned, unpartitioned / partitioned);
+  }
+  fmt::print(">>> END\n");
+
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/reader_biased_latch.h"
+#include "common/rwlatch.h"
+#include "fmt/format.h"
+
+/** Read ratios, in percent, measured when none is given. */
+static const std::vector<int> DEFAULT_READ_PERCENTS = {100, 99, 90, 50};
+/** Bytes of the latched "page" that a critical section touches. */
+static const size_t CRITICAL_SECTION_WORDS = 8;
+
+/** A latch and the data it protects, kept on their own cache lines like a page in the buffer pool. */
+template <typename Latch>
+struct alignas(64) LatchedPage {
+  Latch latch_;
+  alignas(64) uint64_t words_[CRITICAL_SECTION_WORDS]{};
+};
+
+/**
+ * Run `threads` threads that latch the same page for `duration_ms`, each operation being a read with probability
+ * `read_percent`.
+ * @return the number of operations per second
+ */
+template <typename Latch>
+auto RunBench(size_t threads, int read_percent, uint64_t duration_ms) -> double {
+  LatchedPage<Latch> page;
+  std::atomic<bool> start{false};
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> total_ops{0};
+
+  std::vector<std::thread> workers;
+  for (size_t thread_id = 0; thread_id < threads; thread_id++) {
+    workers.emplace_back([&, thread_id] {
+      std::default_random_engine gen(thread_id);
+      std::uniform_int_distribution<int> dis(0, 99);
+      uint64_t ops = 0;
+      uint64_t sum = 0;
+      while (!start.load()) {
+        std::this_thread::yield();
+      }
+      while (!stop.load(std::memory_order_relaxed)) {
+        if (dis(gen) < read_percent) {
+          page.latch_.RLock();
+          for (auto word : page.words_) {
+            sum += word;
+          }
+          page.latch_.RUnlock();
+        } else {
+          page.latch_.WLock();
+          for (auto &word : page.words_) {
+            word++;
+          }
+          page.latch_.WUnlock();
+        }
+        ops++;
+      }
+      // keep the reads from being optimized away
+      if (sum == UINT64_MAX) {
+        fmt::print(stderr, "{}\n", sum);
+      }
+      total_ops += ops;
+    });
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  start = true;
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+  stop = true;
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  return total_ops.load() / elapsed;
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-latch-bench");
+  program.add_argument("--duration").help("run each configuration for n milliseconds");
+  program.add_argument("--threads").help("number of threads latching the same page");
+  program.add_argument("--read-percent").help("only measure this percentage of reads");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  uint64_t duration_ms = 2000;
+  if (program.present("--duration")) {
+    duration_ms = std::stoi(program.get("--duration"));
+  }
+  size_t threads = std::thread::hardware_concurrency();
+  if (program.present("--threads")) {
+    threads = std::stoi(program.get("--threads"));
+  }
+  std::vector<int> read_percents = DEFAULT_READ_PERCENTS;
+  if (program.present("--read-percent")) {
+    read_percents = {std::stoi(program.get("--read-percent"))};
+  }
+
+  fmt::print(stderr, "[info] threads={}, duration_ms={}, stripes={}\n", threads, duration_ms,
+             bustub::READER_BIASED_LATCH_STRIPES);
+
+  fmt::print("<<< BEGIN\n");
+  fmt::print("{:>8} {:>16} {:>16} {:>8}\n", "read%", "shared_mutex", "reader_biased", "speedup");
+  for (auto read_percent : read_percents) {
+    auto shared_mutex_ops = RunBench<bustub::ReaderWriterLatch>(threads, read_percent, duration_ms);
+    auto reader_biased_ops = RunBench<bustub::ReaderBiasedLatch<>>(threads, read_percent, duration_ms);
+    fmt::print("{:>8} {:>16.0f} {:>16.0f} {:>8.2f}\n", read_percent, shared_mutex_ops, reader_biased_ops,
+               reader_biased_ops / shared_mutex_ops);
+  }
+  fmt::print(">>> END\n");
+
+  return 0;
+}
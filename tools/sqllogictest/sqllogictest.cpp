@@ -75,6 +75,16 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
           fmt::print("IndexScan not found\n");
           return false;
         }
+      } else if (opt == "ensure:bitmap_heap_scan") {
+        if (!bustub::StringUtil::Contains(result.str(), "BitmapHeapScan")) {
+          fmt::print("BitmapHeapScan not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:index_only_scan") {
+        if (!bustub::StringUtil::Contains(result.str(), "index_only=true")) {
+          fmt::print("Index-only IndexScan not found\n");
+          return false;
+        }
       } else if (opt == "ensure:hash_join") {
         if (bustub::StringUtil::Split(result.str(), "HashJoin").size() != 2 &&
             !bustub::StringUtil::Contains(result.str(), "Filter")) {